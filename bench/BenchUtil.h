@@ -0,0 +1,57 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "../src/WorkloadGenerator.h"
+
+using namespace std::chrono;
+
+struct Job {
+    int pid;
+    nanoseconds arrival;
+    nanoseconds burst;
+};
+
+// seeded Poisson arrivals with exponential bursts, by default at about half load on one
+// cpu so ready queues stay bounded
+inline std::vector<Job> make_jobs(size_t n, uint64_t seed = 1234, nanoseconds mean_interarrival = 100ns){
+    WorkloadConfig config;
+    config.seed = seed;
+    config.mean_interarrival = mean_interarrival;
+    config.mean_burst = 50ns;
+
+    std::vector<Job> jobs;
+    jobs.reserve(n);
+    WorkloadGenerator(config).generate(n, [&jobs](int pid, nanoseconds arrival, nanoseconds burst){
+        jobs.push_back({pid, arrival, burst});
+    });
+    return jobs;
+}
+
+// std::cout with no buffer drops everything without formatting it
+struct SilenceCout {
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    std::streambuf* saved_err = std::cerr.rdbuf(nullptr);
+    ~SilenceCout(){
+        std::cout.rdbuf(saved);
+        std::cout.clear();
+        std::cerr.rdbuf(saved_err);
+        std::cerr.clear();
+    }
+};
+
+// reports items/s as processes per second and adds the inverse, time per process
+inline void set_processes(benchmark::State& state, int64_t processes_per_iteration){
+    state.SetItemsProcessed(state.iterations() * processes_per_iteration);
+    state.counters["time_per_process"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * processes_per_iteration),
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchUtil.h"
+#include "../src/FCFSScheduler.h"
+#include "../src/SJFScheduler.h"
+
+#include <vector>
+
+// SimulationEngine against the hand-written FCFS and SJF loops it replaced, built from
+// the same pieces (ProcessTable, ArrivalIndex, ready queue). neither side logs, so the
+// comparison is the template dispatch against the loop written out by hand
+
+namespace {
+
+// the per-scheduler loop as it was written before SimulationEngine, with the ready queue
+// as the only difference between FCFS and SJF. its logging and locking are left out:
+// the engine compiles its logging out, so keeping them here would measure the terminal
+// and the mutex rather than the loop. the engine still takes its stats lock, which this
+// baseline doesn't, so the engine's number is the upper bound of the two
+template <typename ReadyQueue>
+nanoseconds hand_written_loop(const std::vector<Job>& jobs, ReadyQueue& ready, ProcessTable& table){
+    ArrivalIndex arrivals;
+    SchedulerStats stats;
+    for(const Job& job : jobs){
+        arrivals.add(table.add(job.pid, job.arrival, job.burst), job.arrival);
+    }
+
+    nanoseconds now = 0ns;
+    size_t completed = 0;
+    while(completed < jobs.size()){
+        while(arrivals.has_arrival_by(now) && ready.push(arrivals.peek())){
+            arrivals.pop();
+        }
+
+        ProcessHandle h = ready.pop();
+        if(h == invalid_process_handle){
+            now = std::max(now, arrivals.next_arrival());
+            continue;
+        }
+
+        nanoseconds slice = table.remaining(h);
+        table.execute_slice(h, now, slice);
+        now += slice;
+        stats.record_completion(table, h);
+        completed++;
+    }
+    return now;
+}
+
+} // namespace
+
+static void BM_HandWrittenFCFS(benchmark::State& state){
+    auto jobs = make_jobs(static_cast<size_t>(state.range(0)));
+    for(auto _ : state){
+        ProcessTable table;
+        FifoReadyQueue ready(table, 4096);
+        benchmark::DoNotOptimize(hand_written_loop(jobs, ready, table));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HandWrittenFCFS)->Arg(1000)->Arg(100000);
+
+static void BM_EngineFCFS(benchmark::State& state){
+    SilenceCout silence;
+    auto jobs = make_jobs(static_cast<size_t>(state.range(0)));
+    for(auto _ : state){
+        FCFSScheduler scheduler(4096);
+        for(const Job& job : jobs){
+            scheduler.add_process(job.pid, job.arrival, job.burst);
+        }
+        scheduler.run_simulation();
+        benchmark::DoNotOptimize(scheduler.get_current_time());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EngineFCFS)->Arg(1000)->Arg(100000);
+
+static void BM_HandWrittenSJF(benchmark::State& state){
+    auto jobs = make_jobs(static_cast<size_t>(state.range(0)));
+    for(auto _ : state){
+        ProcessTable table;
+        ShortestJobReadyQueue ready(table, 4096);
+        benchmark::DoNotOptimize(hand_written_loop(jobs, ready, table));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HandWrittenSJF)->Arg(1000)->Arg(100000);
+
+static void BM_EngineSJF(benchmark::State& state){
+    SilenceCout silence;
+    auto jobs = make_jobs(static_cast<size_t>(state.range(0)));
+    for(auto _ : state){
+        SJFScheduler scheduler(4096);
+        for(const Job& job : jobs){
+            scheduler.add_process(job.pid, job.arrival, job.burst);
+        }
+        scheduler.run_simulation();
+        benchmark::DoNotOptimize(scheduler.get_current_time());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EngineSJF)->Arg(1000)->Arg(100000);
@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchUtil.h"
+#include "../src/ProcessPool.h"
+
+#include <memory>
+#include <vector>
+
+// creating and destroying n Process objects: one heap allocation each against the
+// slab arena, which builds them in place and tears them all down at once
+
+static void BM_ProcessMakeUnique(benchmark::State& state){
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::vector<std::unique_ptr<Process>> processes;
+    processes.reserve(n);
+    for(auto _ : state){
+        for(size_t i = 0; i < n; ++i){
+            processes.push_back(std::make_unique<Process>(static_cast<int>(i), nanoseconds(i), 10ns));
+        }
+        benchmark::DoNotOptimize(processes.back().get());
+        processes.clear();
+    }
+    set_processes(state, static_cast<int64_t>(n));
+}
+BENCHMARK(BM_ProcessMakeUnique)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_ProcessPool(benchmark::State& state){
+    const size_t n = static_cast<size_t>(state.range(0));
+    for(auto _ : state){
+        ProcessPool pool;
+        for(size_t i = 0; i < n; ++i){
+            benchmark::DoNotOptimize(pool.create(static_cast<int>(i), nanoseconds(i), 10ns));
+        }
+    }
+    set_processes(state, static_cast<int64_t>(n));
+}
+BENCHMARK(BM_ProcessPool)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+// a pool reused across runs, the steady state of a sweep: no allocation at all
+static void BM_ProcessPoolReused(benchmark::State& state){
+    const size_t n = static_cast<size_t>(state.range(0));
+    ProcessPool pool;
+    pool.reserve(n);
+    for(auto _ : state){
+        for(size_t i = 0; i < n; ++i){
+            benchmark::DoNotOptimize(pool.create(static_cast<int>(i), nanoseconds(i), 10ns));
+        }
+        pool.clear();
+    }
+    set_processes(state, static_cast<int64_t>(n));
+}
+BENCHMARK(BM_ProcessPoolReused)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMillisecond);
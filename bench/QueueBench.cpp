@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+
+#include "../src/CircularBuffer.h"
+#include "../src/RingBuffer.h"
+
+#include <vector>
+
+// ready-queue contention: every thread enqueues and dequeues against one shared
+// queue, so throughput is reported as total operations across all threads
+
+static Process* bench_process(){
+    static Process p(0, 0ns, 0ns);
+    return &p;
+}
+
+static void BM_MutexCircularBuffer(benchmark::State& state){
+    static CircularBuffer queue(1024);
+    Process* p = bench_process();
+
+    for(auto _ : state){
+        queue.enqueue(p);
+        benchmark::DoNotOptimize(queue.dequeue());
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_MutexCircularBuffer)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_MPMCRingBuffer(benchmark::State& state){
+    static MPMCRingBuffer<Process*> queue(1024);
+    Process* p = bench_process();
+    Process* out = nullptr;
+
+    for(auto _ : state){
+        queue.enqueue(p);
+        queue.dequeue(out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_MPMCRingBuffer)->ThreadRange(1, 16)->UseRealTime();
+
+// bulk APIs move a batch per CAS
+static void BM_MPMCRingBufferBulk(benchmark::State& state){
+    static MPMCRingBuffer<Process*> queue(4096);
+    const size_t batch = static_cast<size_t>(state.range(0));
+    std::vector<Process*> in(batch, bench_process());
+    std::vector<Process*> out(batch);
+    size_t moved = 0;
+
+    for(auto _ : state){
+        moved += queue.enqueue_n(in.data(), batch);
+        moved += queue.dequeue_n(out.data(), batch);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(moved));
+}
+BENCHMARK(BM_MPMCRingBufferBulk)->Arg(32)->ThreadRange(1, 16)->UseRealTime();
+
+// producer and consumer are the same thread here, so this is the uncontended fast path
+static void BM_SPSCRingBuffer(benchmark::State& state){
+    SPSCRingBuffer<Process*> queue(1024);
+    Process* p = bench_process();
+    Process* out = nullptr;
+
+    for(auto _ : state){
+        queue.enqueue(p);
+        queue.dequeue(out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_SPSCRingBuffer);
+
+// single threaded fill then drain at a given depth, ns/op is per enqueue or dequeue
+static void BM_CircularBufferFillDrain(benchmark::State& state){
+    const int depth = static_cast<int>(state.range(0));
+    CircularBuffer queue(depth);
+    Process* p = bench_process();
+
+    for(auto _ : state){
+        for(int i = 0; i < depth; ++i){
+            queue.enqueue(p);
+        }
+        for(int i = 0; i < depth; ++i){
+            benchmark::DoNotOptimize(queue.dequeue());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * depth * 2);
+    state.counters["ns_per_op"] = benchmark::Counter(static_cast<double>(state.iterations() * depth * 2),
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_CircularBufferFillDrain)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_MPMCRingBufferFillDrain(benchmark::State& state){
+    const size_t depth = static_cast<size_t>(state.range(0));
+    MPMCRingBuffer<Process*> queue(depth);
+    Process* p = bench_process();
+    Process* out = nullptr;
+
+    for(auto _ : state){
+        for(size_t i = 0; i < depth; ++i){
+            queue.enqueue(p);
+        }
+        for(size_t i = 0; i < depth; ++i){
+            queue.dequeue(out);
+            benchmark::DoNotOptimize(out);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * depth * 2));
+    state.counters["ns_per_op"] = benchmark::Counter(static_cast<double>(state.iterations() * depth * 2),
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_MPMCRingBufferFillDrain)->RangeMultiplier(8)->Range(8, 4096);
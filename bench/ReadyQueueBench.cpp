@@ -0,0 +1,257 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchUtil.h"
+#include "../src/FCFSScheduler.h"
+#include "../src/SJFScheduler.h"
+#include "../src/IndexedHeap.h"
+#include "../src/MLFQScheduler.h"
+#include "../src/FairScheduler.h"
+#include "../src/ProportionalShareScheduler.h"
+#include "../src/TimingWheel.h"
+
+#include <queue>
+#include <vector>
+
+// dispatch cost of the ready queues: the queue is held at a steady depth and every
+// iteration is one pop of the next process plus one push of a new one
+
+namespace {
+
+// orders a std::priority_queue by remaining time, read straight from the table's column
+struct ProcessComparator {
+    const ProcessTable* table;
+
+    bool operator()(ProcessHandle a, ProcessHandle b) const {
+        return table->remaining(a) > table->remaining(b);
+    }
+};
+
+// table of depth + 1 processes with seeded bursts, so the heap sees realistic keys
+ProcessTable make_table(size_t n){
+    ProcessTable table;
+    table.reserve(n);
+    auto jobs = make_jobs(n);
+    for(const Job& job : jobs){
+        table.add(job.pid, job.arrival, job.burst);
+    }
+    return table;
+}
+
+template <typename Queue>
+void steady_state(benchmark::State& state, Queue& queue, size_t depth){
+    for(ProcessHandle h = 0; h < depth; ++h){
+        queue.push(h);
+    }
+    ProcessHandle spare = static_cast<ProcessHandle>(depth);
+
+    for(auto _ : state){
+        ProcessHandle next = queue.pop();
+        benchmark::DoNotOptimize(next);
+        queue.push(spare);
+        spare = next;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 10^3 to 10^7 queued processes, where the heaps stop fitting in cache
+void large_depths(benchmark::internal::Benchmark* b){
+    for(int64_t depth = 1000; depth <= 10000000; depth *= 10){
+        b->Arg(depth);
+    }
+}
+
+// the same steady state straight on an IndexedHeap, to compare arities
+template <size_t Arity>
+void indexed_heap_steady_state(benchmark::State& state){
+    const size_t depth = static_cast<size_t>(state.range(0));
+    ProcessTable table = make_table(depth + 1);
+    IndexedHeap<nanoseconds, Arity> heap;
+    heap.reserve(depth + 1, depth);
+    for(ProcessHandle h = 0; h < depth; ++h){
+        heap.push(h, table.remaining(h));
+    }
+    ProcessHandle spare = static_cast<ProcessHandle>(depth);
+
+    for(auto _ : state){
+        ProcessHandle next = heap.pop();
+        benchmark::DoNotOptimize(next);
+        heap.push(spare, table.remaining(spare));
+        spare = next;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+// the old SJF ready queue as a baseline: a std::priority_queue of handles that reads every
+// key from the table during sifts, where ShortestJobReadyQueue keeps them in an IndexedHeap
+static void BM_SJFPriorityQueue(benchmark::State& state){
+    const size_t depth = static_cast<size_t>(state.range(0));
+    ProcessTable table = make_table(depth + 1);
+    std::priority_queue<ProcessHandle, std::vector<ProcessHandle>, ProcessComparator> queue(ProcessComparator{&table});
+
+    for(ProcessHandle h = 0; h < depth; ++h){
+        queue.push(h);
+    }
+    ProcessHandle spare = static_cast<ProcessHandle>(depth);
+
+    for(auto _ : state){
+        ProcessHandle next = queue.top();
+        queue.pop();
+        benchmark::DoNotOptimize(next);
+        queue.push(spare);
+        spare = next;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SJFPriorityQueue)->RangeMultiplier(8)->Range(8, 1 << 18)->Apply(large_depths);
+
+static void BM_ShortestJobReadyQueue(benchmark::State& state){
+    const size_t depth = static_cast<size_t>(state.range(0));
+    ProcessTable table = make_table(depth + 1);
+    ShortestJobReadyQueue queue(table, depth + 1);
+    steady_state(state, queue, depth);
+}
+BENCHMARK(BM_ShortestJobReadyQueue)->RangeMultiplier(8)->Range(8, 1 << 18)->Apply(large_depths);
+
+static void BM_FifoReadyQueue(benchmark::State& state){
+    const size_t depth = static_cast<size_t>(state.range(0));
+    ProcessTable table = make_table(depth + 1);
+    FifoReadyQueue queue(table, depth + 1);
+    steady_state(state, queue, depth);
+}
+BENCHMARK(BM_FifoReadyQueue)->RangeMultiplier(8)->Range(8, 1 << 18);
+
+// bitmap lookup plus a list unlink, so this should stay flat with depth
+static void BM_MLFQReadyQueue(benchmark::State& state){
+    const size_t depth = static_cast<size_t>(state.range(0));
+    ProcessTable table = make_table(depth + 1);
+    MultiLevelFeedbackQueue queue(table, depth + 1);
+    steady_state(state, queue, depth);
+}
+BENCHMARK(BM_MLFQReadyQueue)->RangeMultiplier(8)->Range(8, 1 << 18)->Apply(large_depths);
+
+// treap insert plus the leftmost node, or the eligible earliest deadline
+static void BM_CFSReadyQueue(benchmark::State& state){
+    const size_t depth = static_cast<size_t>(state.range(0));
+    ProcessTable table = make_table(depth + 1);
+    FairReadyQueue<FairPick::MinVruntime> queue(table, depth + 1);
+    steady_state(state, queue, depth);
+}
+BENCHMARK(BM_CFSReadyQueue)->RangeMultiplier(8)->Range(8, 1 << 18)->Apply(large_depths);
+
+static void BM_EEVDFReadyQueue(benchmark::State& state){
+    const size_t depth = static_cast<size_t>(state.range(0));
+    ProcessTable table = make_table(depth + 1);
+    FairReadyQueue<FairPick::EarliestEligibleDeadline> queue(table, depth + 1);
+    steady_state(state, queue, depth);
+}
+BENCHMARK(BM_EEVDFReadyQueue)->RangeMultiplier(8)->Range(8, 1 << 18)->Apply(large_depths);
+
+// a draw walks the Fenwick tree once, a push and a pop update it once each
+static void BM_LotteryReadyQueue(benchmark::State& state){
+    const size_t depth = static_cast<size_t>(state.range(0));
+    ProcessTable table = make_table(depth + 1);
+    LotteryReadyQueue queue(table, depth + 1);
+    steady_state(state, queue, depth);
+}
+BENCHMARK(BM_LotteryReadyQueue)->RangeMultiplier(8)->Range(8, 1 << 18)->Apply(large_depths);
+
+static void BM_StrideReadyQueue(benchmark::State& state){
+    const size_t depth = static_cast<size_t>(state.range(0));
+    ProcessTable table = make_table(depth + 1);
+    StrideReadyQueue queue(table, depth + 1);
+    steady_state(state, queue, depth);
+}
+BENCHMARK(BM_StrideReadyQueue)->RangeMultiplier(8)->Range(8, 1 << 18)->Apply(large_depths);
+
+static void BM_IndexedHeapBinary(benchmark::State& state){
+    indexed_heap_steady_state<2>(state);
+}
+BENCHMARK(BM_IndexedHeapBinary)->Apply(large_depths);
+
+static void BM_IndexedHeapQuaternary(benchmark::State& state){
+    indexed_heap_steady_state<4>(state);
+}
+BENCHMARK(BM_IndexedHeapQuaternary)->Apply(large_depths);
+
+// re-keying a random queued process, which std::priority_queue can't do at all
+static void BM_IndexedHeapUpdate(benchmark::State& state){
+    const size_t depth = static_cast<size_t>(state.range(0));
+    ProcessTable table = make_table(depth);
+    IndexedHeap<nanoseconds> heap;
+    heap.reserve(depth, depth);
+    for(ProcessHandle h = 0; h < depth; ++h){
+        heap.push(h, table.remaining(h));
+    }
+
+    uint64_t x = 88172645463325252ULL;
+    for(auto _ : state){
+        // xorshift so the handle and the new key are cheap to pick
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        ProcessHandle h = static_cast<ProcessHandle>(x % depth);
+        heap.update(h, nanoseconds(static_cast<int64_t>((x >> 32) % 1000)));
+    }
+    benchmark::DoNotOptimize(heap.top());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IndexedHeapUpdate)->Apply(large_depths);
+
+// processes waiting on I/O, held at a steady count: every iteration moves the clock to
+// the next wakeup and sends whatever woke back to I/O for another 1ns-1ms. items are
+// wakeups. the IndexedHeap on the wakeup time is the O(log n) way to do the same
+static void BM_TimingWheel(benchmark::State& state){
+    const size_t depth = static_cast<size_t>(state.range(0));
+    uint64_t x = 88172645463325252ULL;
+    auto io_time = [&x]{
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        return nanoseconds(static_cast<int64_t>(1 + x % 1000000));
+    };
+
+    TimingWheel wheel;
+    wheel.reserve(depth);
+    for(ProcessHandle h = 0; h < depth; ++h){
+        wheel.schedule(h, io_time());
+    }
+    std::vector<ProcessHandle> woken;
+    int64_t wakeups = 0;
+    for(auto _ : state){
+        nanoseconds now = wheel.next_expiry();
+        wheel.advance(now, [&woken](ProcessHandle h, nanoseconds){ woken.push_back(h); });
+        for(ProcessHandle h : woken){
+            wheel.schedule(h, now + io_time());
+        }
+        wakeups += static_cast<int64_t>(woken.size());
+        woken.clear();
+    }
+    state.SetItemsProcessed(wakeups);
+}
+BENCHMARK(BM_TimingWheel)->Apply(large_depths);
+
+static void BM_TimerHeap(benchmark::State& state){
+    const size_t depth = static_cast<size_t>(state.range(0));
+    uint64_t x = 88172645463325252ULL;
+    auto io_time = [&x]{
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        return static_cast<int64_t>(1 + x % 1000000);
+    };
+
+    IndexedHeap<int64_t> heap;
+    heap.reserve(depth, depth);
+    for(ProcessHandle h = 0; h < depth; ++h){
+        heap.push(h, io_time());
+    }
+    for(auto _ : state){
+        int64_t now = heap.top().key;
+        ProcessHandle h = heap.pop();
+        heap.push(h, now + io_time());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimerHeap)->Apply(large_depths);
@@ -0,0 +1,302 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchUtil.h"
+#include "../src/FCFSScheduler.h"
+#include "../src/SJFScheduler.h"
+#include "../src/RoundRobinScheduler.h"
+#include "../src/SRTFScheduler.h"
+#include "../src/MLFQScheduler.h"
+#include "../src/FairScheduler.h"
+#include "../src/MultiCoreScheduler.h"
+#include "../src/EventTracer.h"
+#include "../src/Admission.h"
+#include "../src/Telemetry.h"
+
+#include <thread>
+
+// end to end run_simulation() for every policy from 10 to 10^6 processes. setup (adding
+// the processes) is timed too, since it is part of every run. output is silenced so the
+// numbers are the scheduler's, not the terminal's
+
+namespace {
+
+constexpr int queue_capacity = 4096;
+
+template <typename Scheduler, typename... Args>
+void run_end_to_end(benchmark::State& state, Args... args){
+    SilenceCout silence;
+    const size_t n = static_cast<size_t>(state.range(0));
+    auto jobs = make_jobs(n);
+
+    for(auto _ : state){
+        Scheduler scheduler(args...);
+        scheduler.reserve(n);
+        for(const Job& job : jobs){
+            scheduler.add_process(job.pid, job.arrival, job.burst);
+        }
+        scheduler.run_simulation();
+        benchmark::DoNotOptimize(scheduler.get_current_time());
+    }
+    set_processes(state, static_cast<int64_t>(n));
+}
+
+} // namespace
+
+static void BM_SimulateFCFS(benchmark::State& state){
+    run_end_to_end<FCFSScheduler>(state, queue_capacity);
+}
+BENCHMARK(BM_SimulateFCFS)->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond);
+
+static void BM_SimulateSJF(benchmark::State& state){
+    run_end_to_end<SJFScheduler>(state, queue_capacity);
+}
+BENCHMARK(BM_SimulateSJF)->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond);
+
+// total runtime of whole runs from 10^3 to 10^7 processes, fitted against N. admission and
+// clock skipping are O(log N) per event, so a fit far from O(N) means one of them went
+// quadratic again
+template <typename Scheduler>
+void scaling(benchmark::State& state){
+    run_end_to_end<Scheduler>(state, queue_capacity);
+    state.SetComplexityN(state.range(0));
+}
+
+static void BM_ScaleFCFS(benchmark::State& state){
+    scaling<FCFSScheduler>(state);
+}
+BENCHMARK(BM_ScaleFCFS)->RangeMultiplier(10)->Range(1000, 10000000)->Complexity(benchmark::oN)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_ScaleSJF(benchmark::State& state){
+    scaling<SJFScheduler>(state);
+}
+BENCHMARK(BM_ScaleSJF)->RangeMultiplier(10)->Range(1000, 10000000)->Complexity(benchmark::oN)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_SimulateRoundRobin(benchmark::State& state){
+    run_end_to_end<RoundRobinScheduler>(state, queue_capacity, LatencyMode::Histogram, FixedQuantum{10ns});
+}
+BENCHMARK(BM_SimulateRoundRobin)->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond);
+
+static void BM_SimulateSRTF(benchmark::State& state){
+    run_end_to_end<SRTFScheduler>(state, queue_capacity);
+}
+BENCHMARK(BM_SimulateSRTF)->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond);
+
+static void BM_SimulateMLFQ(benchmark::State& state){
+    run_end_to_end<MLFQScheduler>(state, queue_capacity);
+}
+BENCHMARK(BM_SimulateMLFQ)->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond);
+
+static void BM_SimulateCFS(benchmark::State& state){
+    run_end_to_end<CFSScheduler>(state, queue_capacity);
+}
+BENCHMARK(BM_SimulateCFS)->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond);
+
+static void BM_SimulateEEVDF(benchmark::State& state){
+    run_end_to_end<EEVDFScheduler>(state, queue_capacity);
+}
+BENCHMARK(BM_SimulateEEVDF)->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond);
+
+static void BM_SimulateMultiCoreSJF(benchmark::State& state){
+    run_end_to_end<MultiCoreSJFScheduler>(state, 8, queue_capacity);
+}
+BENCHMARK(BM_SimulateMultiCoreSJF)->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond);
+
+// 64 cores at about 80% load from 10^3 to 10^7 processes, fitted against N. finished
+// processes are retired as they go, like a long running simulation would
+static void BM_MultiCore(benchmark::State& state){
+    SilenceCout silence;
+    const size_t n = static_cast<size_t>(state.range(0));
+    auto jobs = make_jobs(n, 1234, 1ns);
+
+    for(auto _ : state){
+        MultiCoreFCFSScheduler scheduler(64, 1024);
+        scheduler.reserve(n);
+        for(const Job& job : jobs){
+            scheduler.add_process(job.pid, job.arrival, job.burst);
+        }
+        scheduler.set_retire_callback([](ProcessHandle){});
+        scheduler.run_simulation();
+        benchmark::DoNotOptimize(scheduler.get_current_time());
+    }
+    set_processes(state, static_cast<int64_t>(n));
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_MultiCore)->RangeMultiplier(10)->Range(1000, 10000000)->Complexity(benchmark::oN)
+    ->Unit(benchmark::kMillisecond);
+
+// twice as much work arriving as one cpu can do, into a 64 slot round robin queue. the
+// argument is the AdmissionPolicy, with a 1024 process backlog for the bounded ones.
+// done_per_us is completions per simulated microsecond, the throughput the policy holds
+// under overload, and p99_turn_ns what the admitted processes paid for it
+static void BM_SimulateOverload(benchmark::State& state){
+    SilenceCout silence;
+    const size_t n = 100000;
+    WorkloadConfig config;
+    config.seed = 1234;
+    config.mean_interarrival = 25ns;
+    config.mean_burst = 50ns;
+    std::vector<Job> jobs;
+    jobs.reserve(n);
+    WorkloadGenerator(config).generate(n, [&jobs](int pid, nanoseconds arrival, nanoseconds burst){
+        jobs.push_back({pid, arrival, burst});
+    });
+
+    AdmissionConfig admission;
+    admission.policy = static_cast<AdmissionPolicy>(state.range(0));
+    admission.backlog_capacity = admission.policy == AdmissionPolicy::Defer ? SIZE_MAX : 1024;
+    state.SetLabel(std::string(admission_policy_name(admission.policy)));
+
+    SchedulerStats stats;
+    for(auto _ : state){
+        RoundRobinScheduler scheduler(64, LatencyMode::Histogram, FixedQuantum{10ns});
+        scheduler.reserve(n);
+        for(const Job& job : jobs){
+            scheduler.add_process(job.pid, job.arrival, job.burst);
+        }
+        scheduler.set_admission(admission);
+        scheduler.run_simulation();
+        stats = scheduler.get_stats();
+    }
+    state.SetItemsProcessed(state.iterations() * stats.total_processes_completed);
+    state.counters["shed"] = static_cast<double>(stats.shed);
+    state.counters["done_per_us"] = stats.total_processes_completed * 1000.0 / stats.total_sim_time.count();
+    state.counters["p99_turn_ns"] = static_cast<double>(stats.calculate_percentile(stats.turnaround_times, 99.0).count());
+}
+BENCHMARK(BM_SimulateOverload)->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
+
+// an I/O heavy mix: four in five processes split their burst into five cpu bursts with
+// 10us of I/O on average in between, so most of the workload is parked in the timing
+// wheel at any moment
+static void BM_SimulateIOBound(benchmark::State& state){
+    SilenceCout silence;
+    const size_t n = static_cast<size_t>(state.range(0));
+    WorkloadConfig config;
+    config.seed = 1234;
+    config.io_fraction = 0.8;
+    config.io_bursts = 4;
+    config.mean_io = 10000ns;
+    WorkloadGenerator generator(config);
+    std::vector<TraceRecord> records;
+    std::vector<std::vector<nanoseconds>> bursts(n);
+    records.reserve(n);
+    for(size_t i = 0; i < n; ++i){
+        records.push_back(generator.next());
+        generator.next_io(nanoseconds(records.back().burst_ns), bursts[i]);
+    }
+
+    SchedulerStats stats;
+    for(auto _ : state){
+        RoundRobinScheduler scheduler(queue_capacity, LatencyMode::Histogram, FixedQuantum{10ns});
+        scheduler.reserve(n);
+        for(size_t i = 0; i < n; ++i){
+            if(bursts[i].empty()){
+                scheduler.add_process(records[i].pid, nanoseconds(records[i].arrival_ns), nanoseconds(records[i].burst_ns));
+            } else {
+                scheduler.add_process(records[i].pid, nanoseconds(records[i].arrival_ns), bursts[i]);
+            }
+        }
+        scheduler.run_simulation();
+        stats = scheduler.get_stats();
+    }
+    set_processes(state, static_cast<int64_t>(n));
+    state.counters["io_util"] = stats.io_utilization();
+    state.counters["overlap"] = stats.io_overlap();
+}
+BENCHMARK(BM_SimulateIOBound)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+// online mode: argument is the number of producer threads, each submitting its share of
+// 200000 processes while run_online() schedules them on its own thread. wall clock time,
+// since the producers and the loop share the machine. subs_per_s is the sustained intake
+// rate and p99_submit_ns the wall clock time from submit() to first dispatch
+static void BM_SimulateOnline(benchmark::State& state){
+    SilenceCout silence;
+    const int producers = static_cast<int>(state.range(0));
+    const int n = 200000;
+    const int per_producer = n / producers;
+
+    SchedulerStats stats;
+    for(auto _ : state){
+        FCFSScheduler scheduler(queue_capacity);
+        scheduler.open_intake();
+        std::thread loop([&]{ scheduler.run_online(); });
+        std::vector<std::thread> threads;
+        for(int t = 0; t < producers; ++t){
+            threads.emplace_back([&, t]{
+                for(int i = 0; i < per_producer; ++i){
+                    scheduler.submit(t * per_producer + i, nanoseconds(1 + i % 100));
+                }
+            });
+        }
+        for(std::thread& thread : threads){
+            thread.join();
+        }
+        scheduler.shutdown();
+        loop.join();
+        stats = scheduler.get_stats();
+    }
+    set_processes(state, stats.submitted);
+    state.counters["subs_per_s"] = stats.submission_rate();
+    state.counters["p50_submit_ns"] = static_cast<double>(stats.calculate_percentile(stats.submit_latencies, 50.0).count());
+    state.counters["p99_submit_ns"] = static_cast<double>(stats.calculate_percentile(stats.submit_latencies, 99.0).count());
+}
+BENCHMARK(BM_SimulateOnline)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// the same FCFS run with every event recorded, against BM_SimulateFCFS for the tracing overhead
+static void BM_SimulateFCFSTraced(benchmark::State& state){
+    SilenceCout silence;
+    const size_t n = static_cast<size_t>(state.range(0));
+    auto jobs = make_jobs(n);
+    EventTracer tracer(1, 4 * n);
+
+    for(auto _ : state){
+        tracer.clear();
+        FCFSScheduler scheduler(queue_capacity);
+        scheduler.reserve(n);
+        for(const Job& job : jobs){
+            scheduler.add_process(job.pid, job.arrival, job.burst);
+        }
+        scheduler.set_tracer(&tracer);
+        scheduler.run_simulation();
+        benchmark::DoNotOptimize(scheduler.get_current_time());
+    }
+    set_processes(state, static_cast<int64_t>(n));
+}
+BENCHMARK(BM_SimulateFCFSTraced)->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond);
+
+// the same FCFS run with windowed telemetry on, against BM_SimulateFCFS for its overhead.
+// 1us windows, so the windows roll over constantly and the ring wraps on large runs
+static void BM_SimulateFCFSTelemetry(benchmark::State& state){
+    SilenceCout silence;
+    const size_t n = static_cast<size_t>(state.range(0));
+    auto jobs = make_jobs(n);
+    WindowedTelemetry telemetry(1us, 1 << 16);
+
+    for(auto _ : state){
+        telemetry.clear();
+        FCFSScheduler scheduler(queue_capacity);
+        scheduler.reserve(n);
+        for(const Job& job : jobs){
+            scheduler.add_process(job.pid, job.arrival, job.burst);
+        }
+        scheduler.set_telemetry(&telemetry);
+        scheduler.run_simulation();
+        benchmark::DoNotOptimize(scheduler.get_current_time());
+    }
+    set_processes(state, static_cast<int64_t>(n));
+    state.counters["windows"] = static_cast<double>(telemetry.size() + telemetry.overwritten());
+}
+BENCHMARK(BM_SimulateFCFSTelemetry)->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond);
+
+static void BM_EventTracerRecord(benchmark::State& state){
+    EventTracer tracer(1, 1 << 16);
+    int pid = 0;
+    for(auto _ : state){
+        tracer.record(0, SchedEventType::Dispatch, nanoseconds(pid), pid);
+        pid++;
+    }
+    benchmark::DoNotOptimize(tracer.total_recorded());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventTracerRecord);
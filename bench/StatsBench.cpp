@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchUtil.h"
+#include "../src/SchedulerStats.h"
+
+// cost of the stats path: recording a completion and asking for a percentile,
+// in the default histogram mode and in exact mode
+
+namespace {
+
+SchedulerStats make_stats(LatencyMode mode, size_t samples){
+    SchedulerStats stats(mode);
+    auto jobs = make_jobs(samples);
+    for(const Job& job : jobs){
+        stats.turnaround_times.record(job.burst);
+    }
+    return stats;
+}
+
+} // namespace
+
+static void BM_PercentileHistogram(benchmark::State& state){
+    SchedulerStats stats = make_stats(LatencyMode::Histogram, static_cast<size_t>(state.range(0)));
+    for(auto _ : state){
+        benchmark::DoNotOptimize(stats.calculate_percentile(stats.turnaround_times, 99.0));
+    }
+}
+BENCHMARK(BM_PercentileHistogram)->RangeMultiplier(10)->Range(1000, 1000000);
+
+static void BM_PercentileExact(benchmark::State& state){
+    SchedulerStats stats = make_stats(LatencyMode::Exact, static_cast<size_t>(state.range(0)));
+    for(auto _ : state){
+        benchmark::DoNotOptimize(stats.calculate_percentile(stats.turnaround_times, 99.0));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_PercentileExact)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oN);
+
+static void BM_RecordCompletion(benchmark::State& state){
+    const size_t n = 4096;
+    ProcessTable table;
+    for(const Job& job : make_jobs(n)){
+        ProcessHandle h = table.add(job.pid, job.arrival, job.burst);
+        table.execute_slice(h, job.arrival, job.burst);
+    }
+    SchedulerStats stats;
+
+    ProcessHandle h = 0;
+    for(auto _ : state){
+        stats.record_completion(table, h);
+        h = h + 1 == n ? 0 : h + 1;
+    }
+    benchmark::DoNotOptimize(stats.total_processes_completed);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RecordCompletion);
@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchUtil.h"
+#include "../src/ParameterSweep.h"
+
+#include <thread>
+
+// a 64 run sweep (4 policies x 2 capacities x 8 seeds, 10^4 processes each) on 1 thread
+// up to every hardware thread. wall time is what counts here, so it is measured in real
+// time, and runs/s should grow with the thread count until the cores run out
+
+namespace {
+
+void thread_counts(benchmark::internal::Benchmark* b){
+    int64_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    for(int64_t threads = 1; threads < hardware; threads *= 2){
+        b->Arg(threads);
+    }
+    b->Arg(hardware);
+}
+
+} // namespace
+
+static void BM_ParameterSweep(benchmark::State& state){
+    SweepSpec spec;
+    spec.policies = {"fcfs", "sjf", "rr", "eevdf"};
+    spec.queue_capacities = {64, 1024};
+    spec.quanta = {10ns};
+    spec.seeds = {1, 2, 3, 4, 5, 6, 7, 8};
+    spec.processes = 10000;
+    ParameterSweep sweep(static_cast<size_t>(state.range(0)));
+
+    size_t runs = 0;
+    for(auto _ : state){
+        std::vector<SweepResult> results = sweep.run(spec);
+        runs = results.size();
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.counters["runs_per_second"] = benchmark::Counter(static_cast<double>(state.iterations() * runs),
+                                                           benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ParameterSweep)->Apply(thread_counts)->UseRealTime()->Unit(benchmark::kMillisecond);
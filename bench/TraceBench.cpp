@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchUtil.h"
+#include "../src/TraceFormat.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+// reading a binary trace back out of its mmap, 10^5 to 10^7 records (a 240MB file at
+// the top). records are copied out of the mapping one at a time, so this should stay at
+// a few ns each, far below what parsing the same workload from text costs
+
+namespace {
+
+std::string trace_path(const char* name){
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+} // namespace
+
+static void BM_ReadTrace(benchmark::State& state){
+    SilenceCout silence;
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::string path = trace_path("bench_read.trace");
+    {
+        TraceWriter writer;
+        if(!writer.open(path)){
+            state.SkipWithError("could not write the trace");
+            return;
+        }
+        for(size_t i = 0; i < n; ++i){
+            writer.write(static_cast<int>(i), nanoseconds(i * 10), 5ns);
+        }
+        writer.close();
+    }
+
+    MappedTrace trace;
+    if(!trace.open(path)){
+        state.SkipWithError("could not map the trace");
+        return;
+    }
+    for(auto _ : state){
+        int64_t checksum = 0;
+        trace.for_each([&checksum](const TraceRecord& record){
+            checksum += record.arrival_ns + record.burst_ns;
+        });
+        benchmark::DoNotOptimize(checksum);
+    }
+    set_processes(state, static_cast<int64_t>(n));
+    trace.close();
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_ReadTrace)->RangeMultiplier(10)->Range(100000, 10000000)->Unit(benchmark::kMillisecond);
+
+// writing a generated workload to a trace, bursty arrivals and Pareto bursts. 100M
+// processes a minute is 600ns each, generation should stay far below that
+static void BM_GenerateTrace(benchmark::State& state){
+    SilenceCout silence;
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::string path = trace_path("bench_generated.trace");
+    WorkloadConfig config;
+    config.arrivals = ArrivalPattern::Bursty;
+    config.bursts = BurstDistribution::Pareto;
+
+    for(auto _ : state){
+        if(!generate_trace(path, config, n)){
+            state.SkipWithError("could not write the trace");
+            break;
+        }
+    }
+    set_processes(state, static_cast<int64_t>(n));
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_GenerateTrace)->RangeMultiplier(10)->Range(100000, 10000000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,169 @@
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <utility>
+
+#include "IndexedHeap.h"
+#include "ProcessTable.h"
+
+using namespace std::chrono;
+
+// what happens to an arrival that finds the ready queue full
+enum class AdmissionPolicy : uint8_t {
+    // wait in the backlog, turned away only once the backlog itself is full
+    Defer,
+    // turned away straight away, nothing waits
+    Reject,
+    // wait in the backlog, a full backlog makes room by shedding its oldest process
+    ShedOldest,
+    // wait in the backlog, a full backlog sheds whichever process has the most work left
+    ShedLongest,
+};
+
+inline constexpr std::string_view admission_policy_names[] = {"defer", "reject", "shed-oldest", "shed-longest"};
+
+inline std::string_view admission_policy_name(AdmissionPolicy policy){
+    return admission_policy_names[static_cast<size_t>(policy)];
+}
+
+// false if text isn't one of admission_policy_names
+inline bool parse_admission_policy(std::string_view text, AdmissionPolicy& policy){
+    for(size_t i = 0; i < std::size(admission_policy_names); ++i){
+        if(text == admission_policy_names[i]){
+            policy = static_cast<AdmissionPolicy>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+struct AdmissionConfig {
+    AdmissionPolicy policy = AdmissionPolicy::Defer;
+    // processes the backlog holds before the policy starts shedding. the default never
+    // fills, so nothing is shed and Defer behaves like an unbounded queue in front of the
+    // ready queue. Reject ignores it
+    size_t backlog_capacity = std::numeric_limits<size_t>::max();
+};
+
+// arrivals that have arrived but found the ready queue full, oldest first. the engines
+// admit from the front before taking anything new, so a deferred process is never
+// overtaken by a later arrival.
+//
+// shed-longest also keeps every waiting process in a max-heap on its remaining time, and
+// a process shed from the middle is only taken out of the heap: its stale entry stays in
+// the fifo and is skipped when it reaches the front
+class AdmissionBacklog{
+public:
+    explicit AdmissionBacklog(AdmissionConfig config = AdmissionConfig{}) : config_(config) {}
+
+    const AdmissionConfig& config() const { return config_; }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+
+    // oldest waiting process, invalid_process_handle if none
+    ProcessHandle front(){
+        skip_shed();
+        return fifo_.empty() ? invalid_process_handle : fifo_.front().handle;
+    }
+
+    // take the oldest waiting process out, once it has been admitted
+    void pop(){
+        skip_shed();
+        if(fifo_.empty()){
+            return;
+        }
+        if(config_.policy == AdmissionPolicy::ShedLongest){
+            longest_.erase(fifo_.front().handle);
+        }
+        fifo_.pop_front();
+        size_--;
+    }
+
+    // h arrived to a full ready queue. returns the process the policy sheds to make room:
+    // h itself when it can't wait, another waiting process, or invalid_process_handle
+    // when there was room. remaining is the work h has left
+    ProcessHandle offer(ProcessHandle h, nanoseconds remaining){
+        if(config_.policy == AdmissionPolicy::Reject){
+            return h;
+        }
+
+        ProcessHandle victim = invalid_process_handle;
+        if(size_ >= config_.backlog_capacity){
+            switch(config_.policy){
+            case AdmissionPolicy::ShedOldest:
+                if(config_.backlog_capacity == 0){
+                    return h;
+                }
+                victim = front();
+                pop();
+                break;
+            case AdmissionPolicy::ShedLongest:
+                // ties shed the newcomer, the processes already waiting keep their place
+                if(longest_.empty() || -longest_.top().key.first <= remaining.count()){
+                    return h;
+                }
+                victim = longest_.pop();
+                size_--;
+                break;
+            default:
+                return h;
+            }
+        }
+
+        uint64_t sequence = next_sequence_++;
+        fifo_.push_back(Waiting{h, sequence});
+        if(config_.policy == AdmissionPolicy::ShedLongest){
+            longest_.push(h, LongestKey{-remaining.count(), -static_cast<int64_t>(sequence)});
+        }
+        size_++;
+        return victim;
+    }
+
+    void clear(){
+        fifo_.clear();
+        longest_.clear();
+        size_ = 0;
+    }
+
+private:
+    struct Waiting {
+        ProcessHandle handle;
+        uint64_t sequence;
+    };
+
+    // most remaining work first, the newest of equals first
+    using LongestKey = std::pair<int64_t, int64_t>;
+
+    AdmissionConfig config_;
+    std::deque<Waiting> fifo_;
+    IndexedHeap<LongestKey> longest_;
+    // waiting processes, without the stale fifo entries
+    size_t size_ = 0;
+    uint64_t next_sequence_ = 0;
+
+    // drop fifo entries whose process was shed out of the heap. the sequence tells a stale
+    // entry apart from a reused handle that is waiting again
+    void skip_shed(){
+        if(config_.policy != AdmissionPolicy::ShedLongest){
+            return;
+        }
+        while(!fifo_.empty()){
+            const Waiting& waiting = fifo_.front();
+            if(longest_.contains(waiting.handle) &&
+               longest_.key(waiting.handle).second == -static_cast<int64_t>(waiting.sequence)){
+                return;
+            }
+            fifo_.pop_front();
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef ARRIVAL_INDEX_H
+#define ARRIVAL_INDEX_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include "ProcessTable.h"
+
+using namespace std::chrono;
+
+// pending arrivals kept sorted by arrival time behind a cursor, so admitting
+// the processes that have arrived and finding the next arrival only ever look
+// at the front instead of scanning every process
+class ArrivalIndex{
+    struct Entry {
+        std::chrono::nanoseconds arrival;
+        ProcessHandle handle;
+    };
+
+    std::vector<Entry> entries_;
+
+    // everything before the cursor has already been admitted
+    size_t cursor_ = 0;
+
+    // cleared when a process is added out of arrival order
+    bool sorted_ = true;
+
+    static constexpr size_t compact_threshold = 4096;
+
+    void ensure_sorted(){
+        if(sorted_){
+            return;
+        }
+
+        // stable so processes with the same arrival keep their insertion order (FCFS tie-break)
+        std::stable_sort(entries_.begin() + cursor_, entries_.end(),
+            [](const Entry& a, const Entry& b){ return a.arrival < b.arrival; });
+        sorted_ = true;
+    }
+
+public:
+    void reserve(size_t n){
+        entries_.reserve(n);
+    }
+
+    // adding in arrival order is O(1), anything else is sorted once on the next lookup
+    void add(ProcessHandle h, std::chrono::nanoseconds arrival){
+        if(cursor_ < entries_.size() && arrival < entries_.back().arrival){
+            sorted_ = false;
+        }
+        entries_.push_back({arrival, h});
+    }
+
+    bool empty() const {
+        return cursor_ == entries_.size();
+    }
+
+    size_t pending() const {
+        return entries_.size() - cursor_;
+    }
+
+    // true if the earliest pending process has arrived by the given time
+    bool has_arrival_by(std::chrono::nanoseconds now){
+        ensure_sorted();
+        return cursor_ < entries_.size() && entries_[cursor_].arrival <= now;
+    }
+
+    // earliest pending process, invalid_process_handle if there is none
+    ProcessHandle peek(){
+        ensure_sorted();
+        return cursor_ < entries_.size() ? entries_[cursor_].handle : invalid_process_handle;
+    }
+
+    // mark the earliest pending process as admitted
+    void pop(){
+        if(cursor_ < entries_.size()){
+            cursor_++;
+        }
+
+        // drop the admitted prefix once it is most of the vector, so memory tracks
+        // the pending count on long runs while staying amortized O(1) per pop
+        if(cursor_ >= compact_threshold && cursor_ * 2 >= entries_.size()){
+            entries_.erase(entries_.begin(), entries_.begin() + cursor_);
+            cursor_ = 0;
+        }
+    }
+
+    // arrival time of the earliest pending process, nanoseconds::max() if there is none
+    std::chrono::nanoseconds next_arrival(){
+        ensure_sorted();
+        return cursor_ < entries_.size() ? entries_[cursor_].arrival : std::chrono::nanoseconds::max();
+    }
+};
+
+#endif
@@ -1,8 +1,11 @@
-#include <iostream>
+#ifndef CIRCULAR_BUFFER_H
+#define CIRCULAR_BUFFER_H
+
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
 #include <mutex>
+#include "Log.h"
 #include "Process.h"
 
 class CircularBuffer{
@@ -15,7 +18,7 @@ class CircularBuffer{
 
 public:
     explicit CircularBuffer(int capacity) : capacity_(capacity), queue_(capacity) {
-        std::cout << "Initialized Circular Buffer with capacity: " << capacity_ << std::endl;
+        SCHED_LOG_DEBUG("Initialized Circular Buffer with capacity: ", capacity_);
     }
 
     bool empty() {
@@ -37,7 +40,7 @@ public:
 
         if(current_size_ == capacity_){
             // we have too many tasks, need to get rid of the oldest one
-            std::cerr << "WARNING: Process Queue full, cannot enqueue new process: " << p->pid << std::endl;
+            SCHED_LOG_WARN("WARNING: Process Queue full, cannot enqueue new process: ", p->pid);
             return false;
         } 
 
@@ -70,4 +73,6 @@ public:
 
         return queue_[head_];
     }
-};
\ No newline at end of file
+};
+
+#endif
\ No newline at end of file
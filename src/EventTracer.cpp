@@ -0,0 +1,268 @@
+#include "EventTracer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <string_view>
+#include <unordered_map>
+
+#include "Log.h"
+
+EventTracer::EventTracer(size_t buffers, size_t capacity_per_buffer)
+    : rings_(buffers > 0 ? buffers : 1)
+{
+    size_t capacity = 1;
+    while(capacity < capacity_per_buffer){
+        capacity <<= 1;
+    }
+    for(Ring& ring : rings_){
+        ring.events = std::make_unique<SchedEvent[]>(capacity);
+        ring.mask = capacity - 1;
+    }
+}
+
+size_t EventTracer::size(size_t buffer) const {
+    const Ring& ring = rings_[buffer];
+    return static_cast<size_t>(std::min<uint64_t>(ring.head, ring.mask + 1));
+}
+
+uint64_t EventTracer::overwritten(size_t buffer) const {
+    return rings_[buffer].head - size(buffer);
+}
+
+uint64_t EventTracer::total_recorded() const {
+    uint64_t total = 0;
+    for(const Ring& ring : rings_){
+        total += ring.head;
+    }
+    return total;
+}
+
+void EventTracer::clear(){
+    for(Ring& ring : rings_){
+        ring.head = 0;
+    }
+}
+
+namespace {
+
+// buffered JSON output, formatted with to_chars since a trace can hold millions of events
+class JsonOut{
+public:
+    explicit JsonOut(std::FILE* file) : file_(file) { buffer_.reserve(flush_at + 512); }
+    ~JsonOut(){ flush(); }
+
+    JsonOut& operator<<(std::string_view text){
+        buffer_.append(text);
+        if(buffer_.size() >= flush_at){
+            flush();
+        }
+        return *this;
+    }
+
+    JsonOut& operator<<(int64_t value){
+        char digits[24];
+        auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+        return *this << std::string_view(digits, static_cast<size_t>(end - digits));
+    }
+
+    // trace timestamps are in microseconds, keep the nanoseconds as three decimals
+    JsonOut& micros(int64_t ns){
+        if(ns < 0){
+            *this << "-";
+            ns = -ns;
+        }
+        *this << ns / 1000;
+        char fraction[4] = {'.', '0', '0', '0'};
+        int64_t rest = ns % 1000;
+        for(int i = 3; i > 0; --i){
+            fraction[i] = static_cast<char>('0' + rest % 10);
+            rest /= 10;
+        }
+        return *this << std::string_view(fraction, sizeof(fraction));
+    }
+
+    bool flush(){
+        if(!buffer_.empty()){
+            ok_ = ok_ && std::fwrite(buffer_.data(), 1, buffer_.size(), file_) == buffer_.size();
+            buffer_.clear();
+        }
+        return ok_;
+    }
+
+private:
+    static constexpr size_t flush_at = 1 << 20;
+
+    std::FILE* file_;
+    std::string buffer_;
+    bool ok_ = true;
+};
+
+// chrome trace "processes" the tracks are grouped under
+constexpr int64_t cpu_group = 0;
+constexpr int64_t process_group = 1;
+
+// the metadata records go first, so every slice follows a comma
+void write_slice(JsonOut& out, std::string_view name, int64_t group, int64_t track,
+                 int64_t start, int64_t end, std::string_view arg_name, int64_t arg){
+    out << ",\n{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":" << group << ",\"tid\":" << track << ",\"ts\":";
+    out.micros(start) << ",\"dur\":";
+    out.micros(end - start) << ",\"args\":{\"" << arg_name << "\":" << arg << "}}";
+}
+
+// order of events that share a timestamp, so a process is queued before it is
+// dispatched and preempted before it is dispatched again
+int rank(SchedEventType type){
+    switch(type){
+    case SchedEventType::Arrive: return 0;
+    case SchedEventType::Wake: return 1;
+    case SchedEventType::Drop: return 2;
+    case SchedEventType::Shed: return 3;
+    case SchedEventType::Enqueue: return 4;
+    case SchedEventType::Preempt: return 5;
+    case SchedEventType::Block: return 5;
+    case SchedEventType::Dispatch: return 6;
+    case SchedEventType::Complete: return 7;
+    }
+    return 8;
+}
+
+} // namespace
+
+bool write_chrome_trace(const EventTracer& tracer, const std::string& path){
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if(!file){
+        SCHED_LOG_ERROR("ERROR: Could not open ", path, " for writing");
+        return false;
+    }
+
+    bool ok = true;
+    {
+        JsonOut out(file);
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+        out << "\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << cpu_group << ",\"args\":{\"name\":\"cpus\"}}";
+        out << ",\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << process_group
+            << ",\"args\":{\"name\":\"processes\"}}";
+        for(size_t b = 0; b < tracer.buffer_count(); ++b){
+            out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << cpu_group << ",\"tid\":"
+                << static_cast<int64_t>(b) << ",\"args\":{\"name\":\"cpu " << static_cast<int64_t>(b) << "\"}}";
+        }
+
+        // running slices: a buffer runs one process at a time, so each dispatch is closed
+        // by the next preempt or complete in the same buffer
+        std::vector<SchedEvent> process_events;
+        process_events.reserve(tracer.total_recorded());
+        for(size_t b = 0; b < tracer.buffer_count(); ++b){
+            bool running = false;
+            SchedEvent dispatched{};
+            tracer.for_each(b, [&](const SchedEvent& event){
+                if(event.type == SchedEventType::Dispatch){
+                    dispatched = event;
+                    running = true;
+                } else if(event.type == SchedEventType::Preempt || event.type == SchedEventType::Complete ||
+                          event.type == SchedEventType::Block){
+                    // the dispatch may have been overwritten when the ring wrapped
+                    if(running && dispatched.pid == event.pid){
+                        char name[24] = {'p', 'i', 'd', ' '};
+                        auto [end, ec] = std::to_chars(name + 4, name + sizeof(name), dispatched.pid);
+                        std::string_view label(name, static_cast<size_t>(end - name));
+                        write_slice(out, label, cpu_group, static_cast<int64_t>(b),
+                                    dispatched.time_ns, event.time_ns, "pid", dispatched.pid);
+                        write_slice(out, "running", process_group, dispatched.pid,
+                                    dispatched.time_ns, event.time_ns, "cpu", static_cast<int64_t>(b));
+                    }
+                    running = false;
+                }
+                if(event.type != SchedEventType::Complete){
+                    process_events.push_back(event);
+                }
+            });
+        }
+
+        // waiting slices follow a process across buffers, so they need every event in time order
+        std::sort(process_events.begin(), process_events.end(), [](const SchedEvent& a, const SchedEvent& b){
+            if(a.time_ns != b.time_ns){
+                return a.time_ns < b.time_ns;
+            }
+            return rank(a.type) < rank(b.type);
+        });
+
+        struct Waiting {
+            int64_t waiting_since = -1;
+            bool dropped = false;
+        };
+        std::unordered_map<int32_t, Waiting> waiting;
+        for(const SchedEvent& event : process_events){
+            switch(event.type){
+            case SchedEventType::Arrive:
+                waiting[event.pid].waiting_since = event.time_ns;
+                break;
+            case SchedEventType::Drop:
+                waiting[event.pid].dropped = true;
+                break;
+            case SchedEventType::Enqueue: {
+                // time spent turned away by a full queue gets a slice of its own
+                Waiting& w = waiting[event.pid];
+                if(w.dropped && w.waiting_since >= 0){
+                    write_slice(out, "queue full", process_group, event.pid, w.waiting_since,
+                                event.time_ns, "pid", event.pid);
+                    w.waiting_since = event.time_ns;
+                }
+                w.dropped = false;
+                break;
+            }
+            case SchedEventType::Shed: {
+                // from arrival to being turned away, then the process is gone
+                auto it = waiting.find(event.pid);
+                if(it != waiting.end() && it->second.waiting_since >= 0){
+                    write_slice(out, "shed", process_group, event.pid, it->second.waiting_since,
+                                event.time_ns, "pid", event.pid);
+                }
+                if(it != waiting.end()){
+                    waiting.erase(it);
+                }
+                break;
+            }
+            case SchedEventType::Preempt:
+                waiting[event.pid].waiting_since = event.time_ns;
+                break;
+            case SchedEventType::Block:
+                // the I/O slice is written when it wakes
+                waiting[event.pid].waiting_since = event.time_ns;
+                break;
+            case SchedEventType::Wake: {
+                Waiting& w = waiting[event.pid];
+                if(w.waiting_since >= 0 && event.time_ns > w.waiting_since){
+                    write_slice(out, "io", process_group, event.pid, w.waiting_since,
+                                event.time_ns, "pid", event.pid);
+                }
+                w.waiting_since = event.time_ns;
+                break;
+            }
+            case SchedEventType::Dispatch: {
+                auto it = waiting.find(event.pid);
+                if(it != waiting.end() && it->second.waiting_since >= 0){
+                    if(event.time_ns > it->second.waiting_since){
+                        write_slice(out, "waiting", process_group, event.pid, it->second.waiting_since,
+                                    event.time_ns, "pid", event.pid);
+                    }
+                    waiting.erase(it);
+                }
+                break;
+            }
+            case SchedEventType::Complete:
+                break;
+            }
+        }
+
+        out << "\n]}\n";
+        ok = out.flush();
+    }
+
+    ok = std::fclose(file) == 0 && ok;
+    if(!ok){
+        SCHED_LOG_ERROR("ERROR: Failed writing trace file ", path);
+    }
+    return ok;
+}
@@ -0,0 +1,98 @@
+#ifndef EVENT_TRACER_H
+#define EVENT_TRACER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+// what happened to a process
+enum class SchedEventType : uint8_t {
+    // it became runnable, timestamped with its arrival time
+    Arrive,
+    // it went into a ready queue
+    Enqueue,
+    // the ready queue was full and turned it away, the engines retry it later
+    Drop,
+    // the admission policy turned it away for good, it never runs
+    Shed,
+    // it started running on a cpu
+    Dispatch,
+    // its slice ended before it finished, it goes back into a ready queue
+    Preempt,
+    // it finished
+    Complete,
+    // its cpu burst ended and it waits on I/O
+    Block,
+    // its I/O finished, timestamped with when it did
+    Wake
+};
+
+struct SchedEvent {
+    int64_t time_ns;
+    int32_t pid;
+    SchedEventType type;
+};
+
+static_assert(sizeof(SchedEvent) == 16, "events are copied into the rings as plain 16 byte records");
+
+// binary recorder for scheduling events. every buffer is a preallocated ring written by
+// exactly one thread (a simulated core, a worker, a dispatcher) with no atomics or
+// allocation, so recording is a handful of stores. when a ring is full the oldest
+// events are overwritten, so it always holds the latest `capacity` events of its
+// buffer. rings are only read once the threads writing them have stopped.
+//
+// buffer i is shown as "cpu i" in exported timelines
+class EventTracer{
+public:
+    // capacity per buffer is rounded up to a power of two
+    EventTracer(size_t buffers, size_t capacity_per_buffer);
+
+    void record(size_t buffer, SchedEventType type, nanoseconds time, int pid){
+        Ring& ring = rings_[buffer];
+        ring.events[ring.head & ring.mask] = SchedEvent{time.count(), static_cast<int32_t>(pid), type};
+        ring.head++;
+    }
+
+    size_t buffer_count() const { return rings_.size(); }
+    size_t capacity() const { return rings_.empty() ? 0 : rings_[0].mask + 1; }
+
+    // events still held by a buffer, and how many were overwritten
+    size_t size(size_t buffer) const;
+    uint64_t overwritten(size_t buffer) const;
+    uint64_t total_recorded() const;
+
+    // visit the events of one buffer in the order they were recorded
+    template <typename Fn>
+    void for_each(size_t buffer, Fn&& fn) const {
+        const Ring& ring = rings_[buffer];
+        for(uint64_t i = ring.head - size(buffer); i < ring.head; ++i){
+            fn(ring.events[i & ring.mask]);
+        }
+    }
+
+    // forget everything recorded so far
+    void clear();
+
+private:
+    // a cache line each so neighbouring writers never share one
+    struct alignas(64) Ring {
+        std::unique_ptr<SchedEvent[]> events;
+        uint64_t mask = 0;
+        uint64_t head = 0;
+    };
+
+    std::vector<Ring> rings_;
+};
+
+// write every recorded event as Chrome trace event JSON, which chrome://tracing and
+// the Perfetto UI both open. one track per cpu shows what ran when, one track per
+// process shows when it was waiting (and how long a full queue turned it away) and
+// when it ran. false if the file couldn't be written
+bool write_chrome_trace(const EventTracer& tracer, const std::string& path);
+
+#endif
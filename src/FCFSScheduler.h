@@ -3,63 +3,48 @@
 
 
 #include <chrono>
-#include <iostream>
-#include <mutex>
-#include <queue>
+#include <cstddef>
 
 #include "Process.h"
-#include "CircularBuffer.h"
-#include "SchedulerStats.h"
+#include "ProcessTable.h"
+#include "RingBuffer.h"
+#include "SimulationEngine.h"
 
 using namespace std::chrono;
 
-class FCFSScheduler{
+// ready queue policy for first come first served: processes run in the order they were admitted.
+// backed by the lock-free ring buffer, whose capacity is rounded up to a power of two
+class FifoReadyQueue{
 public:
-    // Constructor
-    explicit FCFSScheduler(int queue_capacity_);
+    static constexpr const char* name = "FCFS";
 
-    // add a process to the "ready" queue
-    void add_process(Process* p);
+    FifoReadyQueue(const ProcessTable& /*table*/, size_t capacity) : queue_(capacity) {}
 
-    // get the next ready process
-    Process* get_next_process();
+    bool push(ProcessHandle h){
+        return queue_.enqueue(h);
+    }
 
-    // begin the simulation
-    void run_simulation();
+    ProcessHandle pop(){
+        ProcessHandle h = invalid_process_handle;
+        queue_.dequeue(h);
+        return h;
+    }
 
-    // record current performance metrics
-    SchedulerStats get_stats() const;
+    bool empty() const { return queue_.empty(); }
 
-    // helper
-    bool is_simulation_complete();
-private:
-    // ready queue for tasks
-    CircularBuffer ready_queue_;
-
-    // mutex to make the task queue thread-safe
-    mutable std::mutex scheduler_mutex_;
-
-    // track current time in the simulation
-    std::chrono::nanoseconds current_sim_time_ = 0ns;
-
-    // just to keep track of all stats after simulation
-    std::vector<Process*> all_processes_;
-
-    // object to store metrics in
-    SchedulerStats stats_;
+    size_t size() const { return queue_.size(); }
 
-    // is simulation still running or has it completed
-    std::atomic<bool> simulation_active_ = false;
+    size_t capacity() const { return queue_.capacity(); }
 
-    // let process run
-    void dispatch_process(Process* p);
-
-    // retrieve all the processes who would have arrived at current simulation time
-    void handle_new_arrivals();
+private:
+    // lock-free ready queue for tasks, safe for several producers and consumers
+    MPMCRingBuffer<ProcessHandle> queue_;
+};
 
-    bool all_processes_finished();
+// FCFS is the shared simulation loop with a FIFO ready queue, each process runs to completion
+using FCFSScheduler = SimulationEngine<FifoReadyQueue, RunToCompletion>;
 
-    void update_stats_for_completed_processes();
-};
+// instantiated once in FCFSScheduler.cpp
+extern template class SimulationEngine<FifoReadyQueue, RunToCompletion>;
 
 #endif
\ No newline at end of file
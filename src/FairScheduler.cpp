@@ -0,0 +1,7 @@
+#include "FairScheduler.h"
+
+// the loop itself lives in SimulationEngine.h, compile the CFS and EEVDF flavours once here
+template class FairReadyQueue<FairPick::MinVruntime>;
+template class FairReadyQueue<FairPick::EarliestEligibleDeadline>;
+template class SimulationEngine<FairReadyQueue<FairPick::MinVruntime>, RunToCompletion>;
+template class SimulationEngine<FairReadyQueue<FairPick::EarliestEligibleDeadline>, RunToCompletion>;
@@ -0,0 +1,360 @@
+#ifndef FAIR_SCHEDULER_H
+#define FAIR_SCHEDULER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ProcessTable.h"
+#include "SimulationEngine.h"
+
+using namespace std::chrono;
+
+// how FairReadyQueue picks among the runnable processes
+enum class FairPick {
+    // CFS: the smallest virtual runtime, with a slice proportional to the process's weight
+    MinVruntime,
+    // EEVDF: among the processes that are owed CPU (virtual runtime at or below the
+    // weighted average) the one with the earliest virtual deadline, with a fixed slice
+    EarliestEligibleDeadline,
+};
+
+struct FairConfig {
+    // EEVDF: the slice every dispatch asks for. CFS: the shortest slice it hands out
+    nanoseconds slice = 10ns;
+    // CFS: every runnable process should get a turn within this period, split by weight
+    nanoseconds target_latency = 40ns;
+};
+
+// ready queue policy for proportional share scheduling in the style of Linux CFS and
+// EEVDF. every process has a virtual runtime that advances by the CPU time it gets
+// divided by its weight (see nice_weight), so a process with twice the weight can run
+// twice as long for the same virtual time. new arrivals start at the current weighted
+// average, so a late arrival can't claim all the CPU time it missed.
+//
+// the runnable processes are kept in a treap ordered by virtual runtime whose nodes
+// also hold the earliest virtual deadline in their subtree. CFS takes the leftmost node,
+// EEVDF walks down once to find the earliest deadline among the eligible prefix, both
+// in O(log n) expected. nodes live in a per-handle array like the other
+// policies, so queueing a process never allocates once the array has grown
+template <FairPick Pick>
+class FairReadyQueue{
+public:
+    static constexpr const char* name = Pick == FairPick::MinVruntime ? "CFS" : "EEVDF";
+
+    FairReadyQueue(const ProcessTable& table, size_t capacity)
+        : table_(table), capacity_(capacity) {}
+
+    void configure(const FairConfig& config){ config_ = config; }
+
+    const FairConfig& config() const { return config_; }
+
+    bool push(ProcessHandle h){
+        if(size_ >= capacity_){
+            return false;
+        }
+        if(h >= nodes_.size()){
+            grow(static_cast<size_t>(h) + 1);
+        }
+
+        int64_t weight = table_.weight(h);
+        if(table_.state(h) == Process::State::READY){
+            // never ran: start level with everyone else
+            nodes_[h].vruntime = root_ == invalid_process_handle ? vclock_ : average();
+        } else if(table_.state(h) == Process::State::IO_WAIT){
+            // back from I/O, already charged by block(). sleeping doesn't bank credit, so it
+            // comes back no further behind than everyone else
+            nodes_[h].vruntime = std::max(nodes_[h].vruntime, root_ == invalid_process_handle ? vclock_ : average());
+        } else {
+            // back from a slice, charge it for the time it just ran
+            charge(h, weight);
+        }
+        nodes_[h].deadline = nodes_[h].vruntime + config_.slice.count() * virtual_scale / weight;
+
+        if(root_ == invalid_process_handle){
+            base_ = nodes_[h].vruntime;
+        }
+        weighted_sum_ += static_cast<__int128>(nodes_[h].vruntime - base_) * weight;
+        total_weight_ += weight;
+        root_ = insert(root_, h);
+        size_++;
+        return true;
+    }
+
+    ProcessHandle pop(){
+        if(root_ == invalid_process_handle){
+            return invalid_process_handle;
+        }
+        ProcessHandle h = Pick == FairPick::MinVruntime ? leftmost() : earliest_eligible_deadline();
+        vclock_ = std::max(vclock_, average());
+
+        root_ = erase(root_, h);
+        size_--;
+        int64_t weight = table_.weight(h);
+        if(root_ == invalid_process_handle){
+            weighted_sum_ = 0;
+            total_weight_ = 0;
+        } else {
+            weighted_sum_ -= static_cast<__int128>(nodes_[h].vruntime - base_) * weight;
+            total_weight_ -= weight;
+        }
+        return h;
+    }
+
+    // called by the engine when h's slice ends in I/O instead of a push
+    void block(ProcessHandle h){
+        charge(h, table_.weight(h));
+    }
+
+    // called by the engine as h is dispatched
+    nanoseconds time_slice(ProcessHandle h, nanoseconds now){
+        dispatched_at_ = now;
+        if constexpr(Pick == FairPick::MinVruntime){
+            // h's share of the latency period among everything runnable, h included
+            int64_t weight = table_.weight(h);
+            nanoseconds share = config_.target_latency * weight / (total_weight_ + weight);
+            return std::max(share, config_.slice);
+        } else {
+            return config_.slice;
+        }
+    }
+
+    // virtual runtime and deadline of a process, in nanoseconds of nice 0 CPU time
+    nanoseconds vruntime(ProcessHandle h) const { return nanoseconds(nodes_[h].vruntime / 1024); }
+    nanoseconds deadline(ProcessHandle h) const { return nanoseconds(nodes_[h].deadline / 1024); }
+
+    // weighted average virtual runtime of the queued processes, what new arrivals start at
+    nanoseconds average_vruntime() const {
+        return nanoseconds((root_ == invalid_process_handle ? vclock_ : average()) / 1024);
+    }
+
+    bool empty() const { return size_ == 0; }
+
+    size_t size() const { return size_; }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    // virtual time is kept in 1/1024 ns of nice 0 CPU time, so even the heaviest
+    // weight still moves forward on a 1ns slice
+    static constexpr int64_t virtual_scale = int64_t(nice_0_weight) * 1024;
+
+    const ProcessTable& table_;
+    const size_t capacity_;
+    FairConfig config_;
+    size_t size_ = 0;
+
+    // sum of weight * (vruntime - base_) and of the weights over the queued processes.
+    // base_ is only reset when the queue empties, 128 bits keeps the sum exact
+    int64_t base_ = 0;
+    __int128 weighted_sum_ = 0;
+    int64_t total_weight_ = 0;
+    // the average the last time the queue wasn't empty, for arrivals into an empty queue
+    int64_t vclock_ = 0;
+    nanoseconds dispatched_at_ = 0ns;
+
+    // one treap node per handle, everything a walk down the tree reads is in the
+    // same 40 bytes so each level costs one cache miss
+    struct Node {
+        int64_t vruntime;
+        int64_t deadline;
+        // earliest deadline in the subtree, only kept up to date for EEVDF
+        int64_t min_deadline;
+        ProcessHandle left;
+        ProcessHandle right;
+        uint32_t priority;
+    };
+
+    // treap ordered by (vruntime, handle) with a max-heap on priority
+    ProcessHandle root_ = invalid_process_handle;
+    std::vector<Node> nodes_;
+
+    void grow(size_t n){
+        size_t old = nodes_.size();
+        nodes_.resize(n, Node{0, 0, 0, invalid_process_handle, invalid_process_handle, 0});
+        for(size_t h = old; h < n; ++h){
+            // splitmix64 of the handle, fixed per slot so runs are reproducible
+            uint64_t x = h + 0x9e3779b97f4a7c15ull;
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+            nodes_[h].priority = static_cast<uint32_t>(x ^ (x >> 31));
+        }
+    }
+
+    // add the slice h just ran to its vruntime
+    void charge(ProcessHandle h, int64_t weight){
+        nanoseconds ran = table_.last_run(h) - dispatched_at_;
+        nodes_[h].vruntime += ran.count() * virtual_scale / weight;
+        if(root_ == invalid_process_handle){
+            vclock_ = std::max(vclock_, nodes_[h].vruntime);
+        }
+    }
+
+    // floor of the weighted average, the queue must not be empty
+    int64_t average() const {
+        // the sum nearly always fits 64 bits, where division is far cheaper
+        if(weighted_sum_ >= INT64_MIN && weighted_sum_ <= INT64_MAX){
+            int64_t sum = static_cast<int64_t>(weighted_sum_);
+            int64_t q = sum / total_weight_;
+            return base_ + (sum < 0 && q * total_weight_ != sum ? q - 1 : q);
+        }
+        __int128 q = weighted_sum_ / total_weight_;
+        if(weighted_sum_ < 0 && q * total_weight_ != weighted_sum_){
+            q--;
+        }
+        return base_ + static_cast<int64_t>(q);
+    }
+
+    // a process is owed CPU while its vruntime is at or below the weighted average
+    bool eligible(ProcessHandle h) const {
+        return static_cast<__int128>(nodes_[h].vruntime - base_) * total_weight_ <= weighted_sum_;
+    }
+
+    bool before(ProcessHandle a, ProcessHandle b) const {
+        return nodes_[a].vruntime < nodes_[b].vruntime || (nodes_[a].vruntime == nodes_[b].vruntime && a < b);
+    }
+
+    void pull(ProcessHandle t){
+        if constexpr(Pick == FairPick::EarliestEligibleDeadline){
+            int64_t earliest = nodes_[t].deadline;
+            if(nodes_[t].left != invalid_process_handle){
+                earliest = std::min(earliest, nodes_[nodes_[t].left].min_deadline);
+            }
+            if(nodes_[t].right != invalid_process_handle){
+                earliest = std::min(earliest, nodes_[nodes_[t].right].min_deadline);
+            }
+            nodes_[t].min_deadline = earliest;
+        }
+    }
+
+    // split t into the nodes before h and the rest
+    void split(ProcessHandle t, ProcessHandle h, ProcessHandle& lower, ProcessHandle& upper){
+        if(t == invalid_process_handle){
+            lower = upper = invalid_process_handle;
+            return;
+        }
+        if(before(t, h)){
+            split(nodes_[t].right, h, nodes_[t].right, upper);
+            lower = t;
+        } else {
+            split(nodes_[t].left, h, lower, nodes_[t].left);
+            upper = t;
+        }
+        pull(t);
+    }
+
+    // every node of lower comes before every node of upper
+    ProcessHandle merge(ProcessHandle lower, ProcessHandle upper){
+        if(lower == invalid_process_handle) return upper;
+        if(upper == invalid_process_handle) return lower;
+        if(nodes_[lower].priority > nodes_[upper].priority){
+            nodes_[lower].right = merge(nodes_[lower].right, upper);
+            pull(lower);
+            return lower;
+        }
+        nodes_[upper].left = merge(lower, nodes_[upper].left);
+        pull(upper);
+        return upper;
+    }
+
+    ProcessHandle insert(ProcessHandle t, ProcessHandle h){
+        if(t == invalid_process_handle || nodes_[h].priority > nodes_[t].priority){
+            split(t, h, nodes_[h].left, nodes_[h].right);
+            pull(h);
+            return h;
+        }
+        if(before(h, t)){
+            nodes_[t].left = insert(nodes_[t].left, h);
+        } else {
+            nodes_[t].right = insert(nodes_[t].right, h);
+        }
+        pull(t);
+        return t;
+    }
+
+    ProcessHandle erase(ProcessHandle t, ProcessHandle h){
+        if(t == h){
+            ProcessHandle joined = merge(nodes_[h].left, nodes_[h].right);
+            nodes_[h].left = nodes_[h].right = invalid_process_handle;
+            return joined;
+        }
+        if(before(h, t)){
+            nodes_[t].left = erase(nodes_[t].left, h);
+        } else {
+            nodes_[t].right = erase(nodes_[t].right, h);
+        }
+        pull(t);
+        return t;
+    }
+
+    ProcessHandle leftmost() const {
+        ProcessHandle t = root_;
+        while(nodes_[t].left != invalid_process_handle){
+            t = nodes_[t].left;
+        }
+        return t;
+    }
+
+    // the eligible processes are a prefix of the tree. walking down the search path of
+    // the average, every eligible node's left subtree is eligible as a whole, so its
+    // cached earliest deadline can stand in for all of it
+    ProcessHandle earliest_eligible_deadline() const {
+        ProcessHandle best = invalid_process_handle;
+        ProcessHandle best_subtree = invalid_process_handle;
+        int64_t best_deadline = INT64_MAX;
+
+        ProcessHandle t = root_;
+        while(t != invalid_process_handle){
+            if(!eligible(t)){
+                t = nodes_[t].left;
+                continue;
+            }
+            // ties go to the leftmost, the one that has had the least CPU. everything still
+            // ahead on the walk lies to the right of what was seen, so it has to be strictly
+            // earlier to win
+            ProcessHandle left = nodes_[t].left;
+            if(left != invalid_process_handle && nodes_[left].min_deadline < best_deadline){
+                best_deadline = nodes_[left].min_deadline;
+                best_subtree = left;
+                best = invalid_process_handle;
+            }
+            if(nodes_[t].deadline < best_deadline){
+                best_deadline = nodes_[t].deadline;
+                best = t;
+                best_subtree = invalid_process_handle;
+            }
+            t = nodes_[t].right;
+        }
+
+        if(best != invalid_process_handle){
+            return best;
+        }
+        // find the leftmost node in best_subtree that the cached deadline came from
+        t = best_subtree;
+        while(true){
+            ProcessHandle left = nodes_[t].left;
+            if(left != invalid_process_handle && nodes_[left].min_deadline == best_deadline){
+                t = left;
+            } else if(nodes_[t].deadline == best_deadline){
+                return t;
+            } else {
+                t = nodes_[t].right;
+            }
+        }
+    }
+};
+
+// CFS and EEVDF are the shared simulation loop with a fair ready queue, which slices
+// every dispatch (see FairConfig)
+using CFSScheduler = SimulationEngine<FairReadyQueue<FairPick::MinVruntime>, RunToCompletion>;
+using EEVDFScheduler = SimulationEngine<FairReadyQueue<FairPick::EarliestEligibleDeadline>, RunToCompletion>;
+
+// instantiated once in FairScheduler.cpp
+extern template class FairReadyQueue<FairPick::MinVruntime>;
+extern template class FairReadyQueue<FairPick::EarliestEligibleDeadline>;
+extern template class SimulationEngine<FairReadyQueue<FairPick::MinVruntime>, RunToCompletion>;
+extern template class SimulationEngine<FairReadyQueue<FairPick::EarliestEligibleDeadline>, RunToCompletion>;
+
+#endif
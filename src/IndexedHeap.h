@@ -0,0 +1,187 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "ProcessTable.h"
+
+// min-heap of (key, handle) pairs with Arity children per node, plus a handle -> slot
+// index so any queued process can be found, re-keyed or removed in O(log n). keys are
+// stored inline next to their handle, so a sift compares entries in one contiguous
+// array instead of chasing handles into the process table, and a 4-ary node's
+// children share a cache line. like std::priority_queue, equal keys come out in no
+// particular (but deterministic) order.
+//
+// a handle can be queued at most once. handles index the position array directly,
+// so they should be dense, which ProcessTable handles are
+template <typename Key, size_t Arity = 4>
+class IndexedHeap{
+    static_assert(Arity >= 2, "a heap needs at least two children per node");
+
+public:
+    struct Entry {
+        Key key;
+        ProcessHandle handle;
+    };
+
+    void reserve(size_t entries, size_t max_handle = 0){
+        heap_.reserve(entries);
+        if(max_handle >= positions_.size()){
+            positions_.resize(max_handle + 1, not_queued);
+        }
+    }
+
+    bool empty() const { return heap_.empty(); }
+    size_t size() const { return heap_.size(); }
+
+    bool contains(ProcessHandle h) const {
+        return h < positions_.size() && positions_[h] != not_queued;
+    }
+
+    // smallest entry, the heap must not be empty
+    const Entry& top() const { return heap_.front(); }
+
+    const Key& key(ProcessHandle h) const { return heap_[positions_[h]].key; }
+
+    // false if h is already queued
+    bool push(ProcessHandle h, Key key){
+        if(h >= positions_.size()){
+            positions_.resize(static_cast<size_t>(h) + 1, not_queued);
+        } else if(positions_[h] != not_queued){
+            return false;
+        }
+        heap_.push_back(Entry{std::move(key), h});
+        sift_up(heap_.size() - 1);
+        return true;
+    }
+
+    // remove the smallest entry, invalid_process_handle if empty
+    ProcessHandle pop(){
+        if(heap_.empty()){
+            return invalid_process_handle;
+        }
+        ProcessHandle h = heap_.front().handle;
+        remove_at(0);
+        return h;
+    }
+
+    // lower the key of a queued process, false if it isn't queued or the key isn't lower
+    bool decrease_key(ProcessHandle h, Key key){
+        if(!contains(h) || !(key < heap_[positions_[h]].key)){
+            return false;
+        }
+        size_t slot = positions_[h];
+        heap_[slot].key = std::move(key);
+        sift_up(slot);
+        return true;
+    }
+
+    // set the key of a queued process to anything, false if it isn't queued
+    bool update(ProcessHandle h, Key key){
+        if(!contains(h)){
+            return false;
+        }
+        size_t slot = positions_[h];
+        bool lower = key < heap_[slot].key;
+        heap_[slot].key = std::move(key);
+        if(lower){
+            sift_up(slot);
+        } else {
+            sift_down(slot);
+        }
+        return true;
+    }
+
+    // take a queued process out wherever it is, false if it isn't queued
+    bool erase(ProcessHandle h){
+        if(!contains(h)){
+            return false;
+        }
+        remove_at(positions_[h]);
+        return true;
+    }
+
+    void clear(){
+        for(const Entry& entry : heap_){
+            positions_[entry.handle] = not_queued;
+        }
+        heap_.clear();
+    }
+
+private:
+    static constexpr uint32_t not_queued = UINT32_MAX;
+
+    std::vector<Entry> heap_;
+    // slot of each handle in heap_, not_queued if it isn't in the heap
+    std::vector<uint32_t> positions_;
+
+    static bool before(const Entry& a, const Entry& b){
+        return a.key < b.key;
+    }
+
+    void place(size_t slot, Entry&& entry){
+        positions_[entry.handle] = static_cast<uint32_t>(slot);
+        heap_[slot] = std::move(entry);
+    }
+
+    void remove_at(size_t slot){
+        positions_[heap_[slot].handle] = not_queued;
+        Entry last = std::move(heap_.back());
+        heap_.pop_back();
+        if(slot == heap_.size()){
+            return;
+        }
+        // the last entry fills the hole and moves whichever way it has to
+        bool up = slot > 0 && before(last, heap_[(slot - 1) / Arity]);
+        heap_[slot] = std::move(last);
+        positions_[heap_[slot].handle] = static_cast<uint32_t>(slot);
+        if(up){
+            sift_up(slot);
+        } else {
+            sift_down(slot);
+        }
+    }
+
+    // hole-based sifts: the moving entry is written once, at its final slot
+    void sift_up(size_t slot){
+        Entry moving = std::move(heap_[slot]);
+        while(slot > 0){
+            size_t parent = (slot - 1) / Arity;
+            if(!before(moving, heap_[parent])){
+                break;
+            }
+            place(slot, std::move(heap_[parent]));
+            slot = parent;
+        }
+        place(slot, std::move(moving));
+    }
+
+    void sift_down(size_t slot){
+        Entry moving = std::move(heap_[slot]);
+        const size_t n = heap_.size();
+        while(true){
+            size_t first = slot * Arity + 1;
+            if(first >= n){
+                break;
+            }
+            size_t last = first + Arity < n ? first + Arity : n;
+            size_t best = first;
+            for(size_t child = first + 1; child < last; ++child){
+                if(before(heap_[child], heap_[best])){
+                    best = child;
+                }
+            }
+            if(!before(heap_[best], moving)){
+                break;
+            }
+            place(slot, std::move(heap_[best]));
+            slot = best;
+        }
+        place(slot, std::move(moving));
+    }
+};
+
+#endif
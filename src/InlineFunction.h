@@ -0,0 +1,143 @@
+#ifndef INLINE_FUNCTION_H
+#define INLINE_FUNCTION_H
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename Signature, size_t Capacity = 4 * sizeof(void*)>
+class InlineFunction;
+
+// std::function without the heap: the callable is always stored in a fixed buffer inside
+// the object, and one that doesn't fit is a compile error instead of an allocation.
+// typical tasks (a lambda capturing a few pointers or references) fit the default 32
+// bytes. calling an empty InlineFunction is undefined, check it with operator bool
+template <typename R, typename... Args, size_t Capacity>
+class InlineFunction<R(Args...), Capacity>{
+public:
+    InlineFunction() = default;
+    InlineFunction(std::nullptr_t) {}
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InlineFunction>
+                                                       && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>>>
+    InlineFunction(F&& f){
+        emplace(std::forward<F>(f));
+    }
+
+    InlineFunction(const InlineFunction& other){ copy_from(other); }
+    InlineFunction(InlineFunction&& other) noexcept { move_from(other); }
+
+    InlineFunction& operator=(const InlineFunction& other){
+        if(this != &other){
+            reset();
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    InlineFunction& operator=(InlineFunction&& other) noexcept {
+        if(this != &other){
+            reset();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InlineFunction>
+                                                       && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>>>
+    InlineFunction& operator=(F&& f){
+        reset();
+        emplace(std::forward<F>(f));
+        return *this;
+    }
+
+    InlineFunction& operator=(std::nullptr_t){
+        reset();
+        return *this;
+    }
+
+    ~InlineFunction(){ reset(); }
+
+    R operator()(Args... args) const {
+        return invoke_(storage_, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const { return invoke_ != nullptr; }
+
+    static constexpr size_t capacity(){ return Capacity; }
+
+private:
+    enum class Op { Copy, Move, Destroy };
+
+    using Invoke = R (*)(void*, Args&&...);
+    using Manage = void (*)(Op, void* self, void* other);
+
+    alignas(std::max_align_t) mutable unsigned char storage_[Capacity];
+    Invoke invoke_ = nullptr;
+    // null for trivially copyable callables, which are copied bytewise and never destroyed
+    Manage manage_ = nullptr;
+
+    template <typename F>
+    void emplace(F&& f){
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= Capacity, "callable too large for InlineFunction, raise its Capacity");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "callable is over-aligned for InlineFunction");
+        static_assert(std::is_copy_constructible_v<Fn>, "callable must be copyable, like for std::function");
+        static_assert(std::is_nothrow_move_constructible_v<Fn>, "callable must be nothrow movable");
+
+        ::new(static_cast<void*>(storage_)) Fn(std::forward<F>(f));
+        invoke_ = [](void* self, Args&&... args) -> R {
+            return (*static_cast<Fn*>(self))(std::forward<Args>(args)...);
+        };
+        if constexpr(!std::is_trivially_copyable_v<Fn>){
+            manage_ = [](Op op, void* self, void* other){
+                switch(op){
+                case Op::Copy:
+                    ::new(self) Fn(*static_cast<const Fn*>(other));
+                    break;
+                case Op::Move:
+                    ::new(self) Fn(std::move(*static_cast<Fn*>(other)));
+                    static_cast<Fn*>(other)->~Fn();
+                    break;
+                case Op::Destroy:
+                    static_cast<Fn*>(self)->~Fn();
+                    break;
+                }
+            };
+        }
+    }
+
+    void copy_from(const InlineFunction& other){
+        if(other.manage_){
+            other.manage_(Op::Copy, storage_, other.storage_);
+        } else if(other.invoke_){
+            std::memcpy(storage_, other.storage_, Capacity);
+        }
+        invoke_ = other.invoke_;
+        manage_ = other.manage_;
+    }
+
+    void move_from(InlineFunction& other){
+        if(other.manage_){
+            other.manage_(Op::Move, storage_, other.storage_);
+        } else if(other.invoke_){
+            std::memcpy(storage_, other.storage_, Capacity);
+        }
+        invoke_ = other.invoke_;
+        manage_ = other.manage_;
+        other.invoke_ = nullptr;
+        other.manage_ = nullptr;
+    }
+
+    void reset(){
+        if(manage_){
+            manage_(Op::Destroy, storage_, nullptr);
+        }
+        invoke_ = nullptr;
+        manage_ = nullptr;
+    }
+};
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace std::chrono;
+
+// log-linear (HDR style) histogram of nanosecond values. values below 2^sub_bucket_bits
+// get their own bucket, above that every power of two is split into half that many
+// linear buckets, so the relative error stays under 2^-(sub_bucket_bits-1) (~1.6%)
+// no matter how large the value is. recording is O(1) and memory only grows with
+// the largest value seen (a few thousand buckets at most), never with the sample count
+class LatencyHistogram{
+    static constexpr int sub_bucket_bits = 7;
+    static constexpr uint64_t sub_bucket_count = uint64_t{1} << sub_bucket_bits;
+    static constexpr uint64_t sub_bucket_half = sub_bucket_count / 2;
+
+    std::vector<uint64_t> counts_;
+    uint64_t total_count_ = 0;
+    // exact running values so mean, min and max don't carry bucket error
+    long double sum_ = 0;
+    uint64_t min_ = UINT64_MAX;
+    uint64_t max_ = 0;
+
+    static size_t bucket_index(uint64_t value){
+        if(value < sub_bucket_count){
+            return static_cast<size_t>(value);
+        }
+        int shift = std::bit_width(value) - sub_bucket_bits;
+        uint64_t top = value >> shift;
+        return static_cast<size_t>(sub_bucket_count + (shift - 1) * sub_bucket_half + (top - sub_bucket_half));
+    }
+
+    // smallest value that lands in the bucket and the bucket width
+    static uint64_t bucket_lower(size_t index){
+        if(index < sub_bucket_count){
+            return index;
+        }
+        uint64_t shift = (index - sub_bucket_count) / sub_bucket_half + 1;
+        uint64_t top = (index - sub_bucket_count) % sub_bucket_half + sub_bucket_half;
+        return top << shift;
+    }
+
+    static uint64_t bucket_width(size_t index){
+        if(index < sub_bucket_count){
+            return 1;
+        }
+        return uint64_t{1} << ((index - sub_bucket_count) / sub_bucket_half + 1);
+    }
+
+public:
+    void record(nanoseconds value){
+        // negative durations can't happen in a correct run, clamp rather than wrap
+        uint64_t v = value.count() > 0 ? static_cast<uint64_t>(value.count()) : 0;
+        size_t index = bucket_index(v);
+        if(index >= counts_.size()){
+            counts_.resize(index + 1, 0);
+        }
+        counts_[index]++;
+        total_count_++;
+        sum_ += v;
+        min_ = std::min(min_, v);
+        max_ = std::max(max_, v);
+    }
+
+    // combine another histogram into this one, e.g. from parallel runs
+    void merge(const LatencyHistogram& other){
+        if(other.counts_.size() > counts_.size()){
+            counts_.resize(other.counts_.size(), 0);
+        }
+        for(size_t i = 0; i < other.counts_.size(); ++i){
+            counts_[i] += other.counts_[i];
+        }
+        total_count_ += other.total_count_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    uint64_t count() const { return total_count_; }
+
+    nanoseconds min() const { return total_count_ == 0 ? 0ns : nanoseconds(min_); }
+
+    nanoseconds max() const { return nanoseconds(max_); }
+
+    nanoseconds mean() const {
+        if(total_count_ == 0) return 0ns;
+        return nanoseconds(static_cast<int64_t>(sum_ / total_count_));
+    }
+
+    // nearest-rank percentile, walks the buckets instead of sorting samples
+    nanoseconds percentile(double percentile) const {
+        if(total_count_ == 0) return 0ns;
+
+        uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * total_count_));
+        rank = std::clamp<uint64_t>(rank, 1, total_count_);
+
+        uint64_t seen = 0;
+        for(size_t i = 0; i < counts_.size(); ++i){
+            seen += counts_[i];
+            if(seen >= rank){
+                // middle of the bucket, clamped to what was actually recorded
+                uint64_t value = bucket_lower(i) + bucket_width(i) / 2;
+                return nanoseconds(std::clamp(value, min_, max_));
+            }
+        }
+        return nanoseconds(max_);
+    }
+
+    // number of buckets currently allocated, bounded by the largest value recorded
+    size_t bucket_count() const { return counts_.size(); }
+};
+
+// how a latency series is kept: a bounded histogram by default, or every sample
+// for tests that need exact values
+enum class LatencyMode { Histogram, Exact };
+
+// one latency series in SchedulerStats (turnaround, waiting, ...)
+class LatencyDistribution{
+    LatencyMode mode_;
+    LatencyHistogram histogram_;
+    std::vector<nanoseconds> samples_;
+
+public:
+    explicit LatencyDistribution(LatencyMode mode = LatencyMode::Histogram) : mode_(mode) {}
+
+    LatencyMode mode() const { return mode_; }
+
+    void record(nanoseconds value){
+        if(mode_ == LatencyMode::Exact){
+            samples_.push_back(value);
+        } else {
+            histogram_.record(value);
+        }
+    }
+
+    // merging anything inexact into an exact series turns it into a histogram
+    void merge(const LatencyDistribution& other){
+        if(mode_ == LatencyMode::Exact && other.mode_ == LatencyMode::Exact){
+            samples_.insert(samples_.end(), other.samples_.begin(), other.samples_.end());
+            return;
+        }
+
+        if(mode_ == LatencyMode::Exact){
+            for(nanoseconds value : samples_){
+                histogram_.record(value);
+            }
+            samples_.clear();
+            samples_.shrink_to_fit();
+            mode_ = LatencyMode::Histogram;
+        }
+
+        if(other.mode_ == LatencyMode::Exact){
+            for(nanoseconds value : other.samples_){
+                histogram_.record(value);
+            }
+        } else {
+            histogram_.merge(other.histogram_);
+        }
+    }
+
+    size_t size() const {
+        return mode_ == LatencyMode::Exact ? samples_.size() : static_cast<size_t>(histogram_.count());
+    }
+
+    bool empty() const { return size() == 0; }
+
+    // exact mode only, samples in the order they were recorded
+    const std::vector<nanoseconds>& samples() const { return samples_; }
+
+    // exact mode only, throws std::out_of_range in histogram mode
+    nanoseconds operator[](size_t index) const { return samples_.at(index); }
+
+    nanoseconds mean() const {
+        if(mode_ == LatencyMode::Histogram) return histogram_.mean();
+        if(samples_.empty()) return 0ns;
+
+        long double sum = 0;
+        for(nanoseconds value : samples_){
+            sum += value.count();
+        }
+        return nanoseconds(static_cast<int64_t>(sum / samples_.size()));
+    }
+
+    nanoseconds percentile(double percentile) const {
+        if(mode_ == LatencyMode::Histogram) return histogram_.percentile(percentile);
+        if(samples_.empty()) return 0ns;
+
+        // exact mode is for tests, a selection on a copy is plenty
+        std::vector<nanoseconds> data = samples_;
+        size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * data.size()));
+        size_t index = std::clamp<size_t>(rank, 1, data.size()) - 1;
+        std::nth_element(data.begin(), data.begin() + index, data.end());
+        return data[index];
+    }
+};
+
+#endif
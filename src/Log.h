@@ -0,0 +1,189 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+#include "RingBuffer.h"
+
+enum class LogLevel : int { Trace = 0, Debug = 1, Info = 2, Warn = 3, Error = 4, Off = 5 };
+
+// anything below this level is compiled out: the SCHED_LOG_* call, its arguments and
+// the formatting all disappear. set from CMake with -DSCHEDULER_LOG_LEVEL=TRACE..OFF
+#ifndef SCHEDULER_LOG_LEVEL
+#define SCHEDULER_LOG_LEVEL 2
+#endif
+
+// the if constexpr drops disabled levels entirely, the runtime check filters the rest
+#define SCHED_LOG(level, ...)                                                       \
+    do {                                                                            \
+        if constexpr(static_cast<int>(level) >= SCHEDULER_LOG_LEVEL){               \
+            if(Logger::enabled(level)){                                             \
+                Logger::log(level, __VA_ARGS__);                                    \
+            }                                                                       \
+        }                                                                           \
+    } while(0)
+
+#define SCHED_LOG_TRACE(...) SCHED_LOG(LogLevel::Trace, __VA_ARGS__)
+#define SCHED_LOG_DEBUG(...) SCHED_LOG(LogLevel::Debug, __VA_ARGS__)
+#define SCHED_LOG_INFO(...) SCHED_LOG(LogLevel::Info, __VA_ARGS__)
+#define SCHED_LOG_WARN(...) SCHED_LOG(LogLevel::Warn, __VA_ARGS__)
+#define SCHED_LOG_ERROR(...) SCHED_LOG(LogLevel::Error, __VA_ARGS__)
+
+// one formatted line. fixed size so it can go through a ring buffer without allocating,
+// anything past the end is cut off
+struct LogRecord {
+    LogLevel level = LogLevel::Info;
+    uint32_t length = 0;
+    char text[248];
+
+    std::string_view view() const { return std::string_view(text, length); }
+
+    void append(std::string_view s){
+        size_t n = std::min(s.size(), sizeof(text) - length);
+        std::memcpy(text + length, s.data(), n);
+        length += static_cast<uint32_t>(n);
+    }
+
+    void append(const char* s){ append(std::string_view(s)); }
+    void append(const std::string& s){ append(std::string_view(s)); }
+    void append(char c){ append(std::string_view(&c, 1)); }
+
+    template <typename Number>
+    std::enable_if_t<std::is_arithmetic_v<Number> && !std::is_same_v<Number, char> && !std::is_same_v<Number, bool>>
+    append(Number value){
+        auto [end, ec] = std::to_chars(text + length, text + sizeof(text), value);
+        if(ec == std::errc{}){
+            length = static_cast<uint32_t>(end - text);
+        }
+    }
+
+    void append(bool value){ append(value ? "true" : "false"); }
+
+    template <typename Rep, typename Period>
+    void append(std::chrono::duration<Rep, Period> value){ append(value.count()); }
+};
+
+// process wide logger. by default lines are written straight to stdout (stderr for
+// warnings and errors) with no flush per line; start_async() moves the writing onto a
+// background thread behind a lock-free ring buffer so logging threads only format and
+// enqueue, and drop lines rather than block when the buffer is full
+class Logger{
+public:
+    using Sink = void (*)(LogLevel, std::string_view);
+
+    static constexpr LogLevel compiled_level(){ return static_cast<LogLevel>(SCHEDULER_LOG_LEVEL); }
+
+    static LogLevel level(){ return static_cast<LogLevel>(level_.load(std::memory_order_relaxed)); }
+    static void set_level(LogLevel level){ level_.store(static_cast<int>(level), std::memory_order_relaxed); }
+
+    static bool enabled(LogLevel level){
+        return static_cast<int>(level) >= level_.load(std::memory_order_relaxed);
+    }
+
+    // where finished lines go, nullptr restores stdout/stderr
+    static void set_sink(Sink sink){ sink_.store(sink ? sink : &default_sink); }
+
+    template <typename... Args>
+    static void log(LogLevel level, const Args&... args){
+        LogRecord record;
+        record.level = level;
+        (record.append(args), ...);
+        write(record);
+    }
+
+    // start the background writer, false if it is already running. the buffer is sized
+    // by the first call
+    static bool start_async(size_t capacity = 1 << 14){
+        std::lock_guard<std::mutex> lock(control_mutex_);
+        if(async_queue_.load()){
+            return false;
+        }
+        // allocated once and never freed while the process runs, see stop_async()
+        if(!storage_){
+            storage_ = std::make_unique<MPMCRingBuffer<LogRecord>>(capacity);
+        }
+        draining_ = true;
+        async_queue_.store(storage_.get(), std::memory_order_release);
+        drainer_ = std::thread(drain_loop);
+        return true;
+    }
+
+    // write everything still queued and stop the background writer. lines logged
+    // concurrently with stop_async() may be dropped
+    static void stop_async(){
+        std::lock_guard<std::mutex> lock(control_mutex_);
+        if(!async_queue_.load()){
+            return;
+        }
+        async_queue_.store(nullptr, std::memory_order_release);
+        draining_ = false;
+        drainer_.join();
+        // storage_ stays alive, a thread that loaded the old pointer may still enqueue into it
+    }
+
+    static bool async(){ return async_queue_.load() != nullptr; }
+
+    // lines dropped because the async buffer was full
+    static uint64_t dropped(){ return dropped_.load(); }
+
+private:
+    static void default_sink(LogLevel level, std::string_view line){
+        std::FILE* out = level >= LogLevel::Warn ? stderr : stdout;
+        std::fwrite(line.data(), 1, line.size(), out);
+        std::fputc('\n', out);
+    }
+
+    inline static std::atomic<int> level_{static_cast<int>(LogLevel::Warn)};
+    inline static std::atomic<Sink> sink_{&default_sink};
+
+    inline static std::atomic<MPMCRingBuffer<LogRecord>*> async_queue_{nullptr};
+    inline static std::unique_ptr<MPMCRingBuffer<LogRecord>> storage_;
+    inline static std::atomic<bool> draining_{false};
+    inline static std::thread drainer_;
+    inline static std::mutex control_mutex_;
+    inline static std::atomic<uint64_t> dropped_{0};
+
+    static void write(const LogRecord& record){
+        if(MPMCRingBuffer<LogRecord>* queue = async_queue_.load(std::memory_order_acquire)){
+            if(!queue->enqueue(record)){
+                dropped_++;
+            }
+            return;
+        }
+        sink_.load()(record.level, record.view());
+    }
+
+    static void drain_loop(){
+        constexpr size_t batch = 64;
+        auto records = std::make_unique<LogRecord[]>(batch);
+        while(true){
+            size_t taken = storage_->dequeue_n(records.get(), batch);
+            Sink sink = sink_.load();
+            for(size_t i = 0; i < taken; ++i){
+                sink(records[i].level, records[i].view());
+            }
+            if(taken == 0){
+                if(!draining_.load()){
+                    break;
+                }
+                std::fflush(stdout);
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+        std::fflush(stdout);
+    }
+};
+
+#endif
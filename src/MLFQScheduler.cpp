@@ -0,0 +1,4 @@
+#include "MLFQScheduler.h"
+
+// the loop itself lives in SimulationEngine.h, compile the MLFQ flavour once here
+template class SimulationEngine<MultiLevelFeedbackQueue, RunToCompletion>;
@@ -0,0 +1,219 @@
+#ifndef MLFQ_SCHEDULER_H
+#define MLFQ_SCHEDULER_H
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ProcessTable.h"
+#include "SchedulerStats.h"
+#include "SimulationEngine.h"
+
+using namespace std::chrono;
+
+struct MLFQConfig {
+    // the time slice at level l is base_quantum * (l + 1)
+    nanoseconds base_quantum = 10ns;
+    // every process goes back to the top level this often, 0 turns boosts off
+    nanoseconds boost_interval = 1000ns;
+    // a dispatch after a longer wait counts as starved, 0 means boost_interval (and never
+    // when boosts are off too)
+    nanoseconds starvation_threshold = 0ns;
+};
+
+// ready queue policy for a multi-level feedback queue in the style of the Linux O(1)
+// scheduler: 64 FIFO levels and a bitmap of the non-empty ones, so picking the next
+// process is one count-trailing-zeros whatever the queue length.
+//
+// new arrivals start at level 0. a process that comes back after using its whole time
+// slice has shown it is CPU bound and drops a level, so short (interactive) processes
+// stay on top. every boost_interval all queued processes are moved back to level 0 so
+// long runners can't starve.
+//
+// each level is an intrusive singly linked list threaded through a per-handle array
+// rather than a ring buffer, so a boost splices whole levels onto level 0 in O(levels)
+// and no level needs a capacity of its own. all operations are O(1) apart from the
+// boost, which is O(levels)
+class MultiLevelFeedbackQueue{
+public:
+    static constexpr const char* name = "MLFQ";
+    static constexpr size_t levels = 64;
+
+    MultiLevelFeedbackQueue(const ProcessTable& table, size_t capacity)
+        : table_(table), capacity_(capacity)
+    {
+        std::fill(std::begin(head_), std::end(head_), invalid_process_handle);
+        std::fill(std::begin(tail_), std::end(tail_), invalid_process_handle);
+        level_dispatches_.assign(levels, 0);
+        configure(MLFQConfig{});
+    }
+
+    void configure(const MLFQConfig& config){
+        config_ = config;
+        starvation_threshold_ = config.starvation_threshold > 0ns ? config.starvation_threshold
+                              : config.boost_interval > 0ns       ? config.boost_interval
+                                                                  : nanoseconds::max();
+        next_boost_ = config.boost_interval;
+    }
+
+    const MLFQConfig& config() const { return config_; }
+
+    bool push(ProcessHandle h){
+        if(size_ >= capacity_){
+            return false;
+        }
+        if(h >= next_.size()){
+            next_.resize(static_cast<size_t>(h) + 1, invalid_process_handle);
+            level_.resize(static_cast<size_t>(h) + 1, 0);
+        }
+
+        uint8_t level = 0;
+        if(table_.state(h) == Process::State::BLOCKED){
+            // back from a slice it used up entirely, only CPU bound processes do that
+            level = level_[h];
+            if(level + 1u < levels){
+                level++;
+                demotions_++;
+            }
+        } else if(table_.state(h) == Process::State::IO_WAIT){
+            // gave the CPU up for I/O before its slice ran out, it keeps its level
+            level = level_[h];
+        }
+        level_[h] = level;
+        append(level, h);
+        size_++;
+        return true;
+    }
+
+    ProcessHandle pop(){
+        if(bitmap_ == 0){
+            return invalid_process_handle;
+        }
+        uint8_t level = static_cast<uint8_t>(std::countr_zero(bitmap_));
+        ProcessHandle h = head_[level];
+        head_[level] = next_[h];
+        if(head_[level] == invalid_process_handle){
+            tail_[level] = invalid_process_handle;
+            bitmap_ &= ~(uint64_t(1) << level);
+        }
+        // a boost may have moved it since it was pushed
+        level_[h] = level;
+        size_--;
+        return h;
+    }
+
+    // called by the engine as h is dispatched: applies a due boost, records the wait
+    // that just ended and returns the time slice of h's level
+    nanoseconds time_slice(ProcessHandle h, nanoseconds now){
+        if(config_.boost_interval > 0ns && now >= next_boost_){
+            boost();
+            level_[h] = 0;
+            next_boost_ = (now / config_.boost_interval + 1) * config_.boost_interval;
+        }
+
+        nanoseconds waited_since = table_.state(h) == Process::State::READY ? table_.arrival(h) : table_.last_run(h);
+        nanoseconds waited = now - waited_since;
+        max_ready_wait_ = std::max(max_ready_wait_, waited);
+        if(waited > starvation_threshold_){
+            starved_dispatches_++;
+        }
+
+        uint8_t level = level_[h];
+        level_dispatches_[level]++;
+        nanoseconds quantum = config_.base_quantum * (level + 1);
+        // with run to completion slicing, this slice is its last (and no I/O comes after it)
+        if(level == 0 && table_.remaining(h) <= quantum && table_.burst_left(h) == table_.remaining(h)){
+            interactive_completions_++;
+        }
+        return quantum;
+    }
+
+    void report(SchedulerStats& stats) const {
+        if(stats.level_dispatches.size() < levels){
+            stats.level_dispatches.resize(levels, 0);
+        }
+        for(size_t level = 0; level < levels; ++level){
+            stats.level_dispatches[level] += level_dispatches_[level];
+        }
+        stats.demotions += demotions_;
+        stats.priority_boosts += boosts_;
+        stats.max_ready_wait = std::max(stats.max_ready_wait, max_ready_wait_);
+        stats.starved_dispatches += starved_dispatches_;
+        stats.interactive_completions += interactive_completions_;
+    }
+
+    bool empty() const { return size_ == 0; }
+
+    size_t size() const { return size_; }
+
+    size_t capacity() const { return capacity_; }
+
+    // bit l is set while level l has processes queued
+    uint64_t level_bitmap() const { return bitmap_; }
+
+private:
+    const ProcessTable& table_;
+    const size_t capacity_;
+    MLFQConfig config_;
+    nanoseconds starvation_threshold_ = 0ns;
+    nanoseconds next_boost_ = 0ns;
+
+    ProcessHandle head_[levels];
+    ProcessHandle tail_[levels];
+    uint64_t bitmap_ = 0;
+    size_t size_ = 0;
+
+    // per handle: the next process in the same level, and the level it was last at
+    std::vector<ProcessHandle> next_;
+    std::vector<uint8_t> level_;
+
+    std::vector<int64_t> level_dispatches_;
+    int64_t demotions_ = 0;
+    int64_t boosts_ = 0;
+    nanoseconds max_ready_wait_ = 0ns;
+    int64_t starved_dispatches_ = 0;
+    int64_t interactive_completions_ = 0;
+
+    void append(uint8_t level, ProcessHandle h){
+        next_[h] = invalid_process_handle;
+        if(tail_[level] == invalid_process_handle){
+            head_[level] = h;
+            bitmap_ |= uint64_t(1) << level;
+        } else {
+            next_[tail_[level]] = h;
+        }
+        tail_[level] = h;
+    }
+
+    // move every lower level, in order, to the back of level 0
+    void boost(){
+        boosts_++;
+        uint64_t lower = bitmap_ & ~uint64_t(1);
+        while(lower != 0){
+            int level = std::countr_zero(lower);
+            lower &= lower - 1;
+            if(tail_[0] == invalid_process_handle){
+                head_[0] = head_[level];
+            } else {
+                next_[tail_[0]] = head_[level];
+            }
+            tail_[0] = tail_[level];
+            head_[level] = tail_[level] = invalid_process_handle;
+        }
+        if(bitmap_ != 0){
+            bitmap_ = 1;
+        }
+    }
+};
+
+// MLFQ is the shared simulation loop with the multi-level queue, which caps every slice
+// at the quantum of the process's level
+using MLFQScheduler = SimulationEngine<MultiLevelFeedbackQueue, RunToCompletion>;
+
+// instantiated once in MLFQScheduler.cpp
+extern template class SimulationEngine<MultiLevelFeedbackQueue, RunToCompletion>;
+
+#endif
@@ -0,0 +1,390 @@
+#ifndef MULTI_CORE_ENGINE_H
+#define MULTI_CORE_ENGINE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "EventTracer.h"
+#include "Log.h"
+#include "Process.h"
+#include "ProcessTable.h"
+#include "ArrivalIndex.h"
+#include "SchedulerStats.h"
+#include "SimulationEngine.h"
+
+using namespace std::chrono;
+
+// N simulated cores, each with its own ready queue and its own clock. the simulation
+// itself is single threaded and event driven: the next event is either a core finishing
+// its slice (kept in a min-heap ordered by time, then core index) or a process arriving,
+// so a run is fully deterministic and the cost per slice is O(log cores).
+//
+// arrivals go to an idle core if there is one, otherwise round robin over the cores.
+// a core that runs dry steals from the core with the longest ready queue, which counts
+// as a migration. finding that queue is a scan over every core, so a slice that ends
+// with the core's own queue empty costs O(cores) while anything is queued elsewhere.
+// a preempted process goes back on the queue of the core it ran on.
+//
+// takes the same ReadyQueuePolicy and ClockPolicy as SimulationEngine, with one ready
+// queue per core. not thread safe, processes must not be added while it runs
+template <typename ReadyQueuePolicy, typename ClockPolicy = RunToCompletion>
+class MultiCoreEngine{
+public:
+    static constexpr const char* name = scheduler_name<ReadyQueuePolicy, ClockPolicy>();
+
+    // queue_capacity is per core
+    MultiCoreEngine(int cores, int queue_capacity, LatencyMode latency_mode = LatencyMode::Histogram,
+                    ClockPolicy clock = ClockPolicy{})
+        : clock_(clock),
+          stats_(latency_mode)
+    {
+        size_t core_count = cores > 0 ? static_cast<size_t>(cores) : 1;
+        cores_.resize(core_count);
+        for(Core& core : cores_){
+            core.ready = std::make_unique<ReadyQueuePolicy>(processes_, static_cast<size_t>(queue_capacity));
+        }
+        idle_cores_.reserve(core_count);
+        for(size_t c = core_count; c-- > 0;){
+            idle_cores_.push_back(static_cast<uint32_t>(c));
+        }
+        stats_.core_busy_times.assign(core_count, 0ns);
+        stats_.core_migrations.assign(core_count, 0);
+
+        SCHED_LOG_INFO(name, "Scheduler initialized with ", core_count,
+                       " cores, ready queue capacity per core: ", cores_[0].ready->capacity());
+    }
+
+    // p must outlive the simulation
+    ProcessHandle add_process(Process* p){
+        if(!p){
+            SCHED_LOG_ERROR("ERROR: Attempted to add null process to arrival index");
+            return invalid_process_handle;
+        }
+        ProcessHandle h = processes_.add(p->pid, p->arrival_time, p->burst_time, p);
+        processes_.set_nice(h, p->nice);
+        arrivals_.add(h, p->arrival_time);
+        processes_added_++;
+        return h;
+    }
+
+    ProcessHandle add_process(int pid, nanoseconds arrival, nanoseconds burst, int nice = 0){
+        ProcessHandle h = processes_.add(pid, arrival, burst);
+        processes_.set_nice(h, nice);
+        arrivals_.add(h, arrival);
+        processes_added_++;
+        return h;
+    }
+
+    // reserve room for n processes up front, for large generated workloads
+    void reserve(size_t n){
+        processes_.reserve(n);
+        arrivals_.reserve(n);
+    }
+
+    void run_simulation(){
+        SCHED_LOG_INFO("Starting ", name, " Scheduler Simulation on ", cores_.size(), " cores");
+
+        while(!all_processes_finished()){
+            // slices that end now free their cores first, preempted processes are held
+            // until the arrivals at the same instant have been queued ahead of them
+            finished_cores_.clear();
+            while(!core_events_.empty() && core_events_.top().first <= current_sim_time_){
+                uint32_t c = core_events_.top().second;
+                core_events_.pop();
+                finish_slice(c);
+            }
+
+            handle_new_arrivals();
+
+            for(uint32_t c : finished_cores_){
+                requeue_preempted(c);
+            }
+
+            dispatch_idle_cores();
+
+            // advance to whichever comes first, a slice ending or a new arrival
+            nanoseconds next_event = core_events_.empty() ? nanoseconds::max() : core_events_.top().first;
+            nanoseconds next_arrival = arrivals_.next_arrival();
+            if(next_arrival > current_sim_time_ && next_arrival < next_event){
+                next_event = next_arrival;
+            }
+
+            if(next_event == nanoseconds::max()){
+                if(!all_processes_finished()){
+                    SCHED_LOG_WARN("WARNING: No running cores and no future arrivals, stopping simulation.");
+                }
+                break;
+            }
+            current_sim_time_ = next_event;
+        }
+
+        if(deferred_admissions_ > 0){
+            SCHED_LOG_WARN("WARNING: ", name, " ready queues were full, admission was deferred ",
+                           deferred_admissions_, " times.");
+        }
+
+        stats_.total_sim_time = current_sim_time_;
+        for(size_t c = 0; c < cores_.size(); ++c){
+            stats_.core_busy_times[c] = cores_[c].busy_time;
+        }
+        SCHED_LOG_INFO(name, "Scheduler Simulation Finished");
+    }
+
+    SchedulerStats get_stats() const { return stats_; }
+
+    bool is_simulation_complete() const { return queued_ == 0 && all_processes_finished(); }
+
+    // same contract as SimulationEngine::set_retire_callback
+    void set_retire_callback(std::function<void(ProcessHandle)> callback){
+        retire_callback_ = std::move(callback);
+    }
+
+    // record scheduling events, core i into buffer i of tracer, so the tracer needs a
+    // buffer per core. nullptr turns tracing off. the tracer must outlive the simulation
+    bool set_tracer(EventTracer* tracer){
+        if(tracer && tracer->buffer_count() < cores_.size()){
+            SCHED_LOG_ERROR("ERROR: Event tracer has ", tracer->buffer_count(), " buffers for ",
+                            cores_.size(), " cores");
+            return false;
+        }
+        tracer_ = tracer;
+        return true;
+    }
+
+    const ProcessTable& get_process_table() const { return processes_; }
+
+    nanoseconds get_current_time() const { return current_sim_time_; }
+
+    size_t core_count() const { return cores_.size(); }
+
+private:
+    struct Core {
+        std::unique_ptr<ReadyQueuePolicy> ready;
+        // process on the core right now, invalid when the core is idle
+        ProcessHandle running = invalid_process_handle;
+        // process that ran the previous slice, re-picking it isn't a context switch
+        ProcessHandle last_dispatched = invalid_process_handle;
+        nanoseconds busy_time = 0ns;
+    };
+
+    // (time the slice ends, core), smallest time first and lowest core on ties
+    using CoreEvent = std::pair<nanoseconds, uint32_t>;
+
+    // run to completion never hands a process back to its queue, so it needs no slot
+    // held back for one
+    static constexpr bool can_preempt = !std::is_same_v<ClockPolicy, RunToCompletion>;
+
+    ProcessTable processes_;
+    ClockPolicy clock_;
+    std::vector<Core> cores_;
+
+    std::priority_queue<CoreEvent, std::vector<CoreEvent>, std::greater<CoreEvent>> core_events_;
+
+    // cores with nothing running, and the ones whose slice ended this step
+    std::vector<uint32_t> idle_cores_;
+    std::vector<uint32_t> finished_cores_;
+
+    // round robin cursor for placing arrivals when no core is idle
+    size_t next_core_ = 0;
+
+    // processes sitting in any ready queue
+    size_t queued_ = 0;
+
+    nanoseconds current_sim_time_ = 0ns;
+    ArrivalIndex arrivals_;
+    SchedulerStats stats_;
+
+    size_t processes_added_ = 0;
+    size_t processes_completed_ = 0;
+    size_t deferred_admissions_ = 0;
+
+    std::function<void(ProcessHandle)> retire_callback_;
+
+    EventTracer* tracer_ = nullptr;
+
+    void trace(uint32_t c, SchedEventType type, nanoseconds time, ProcessHandle h){
+        if(tracer_){
+            tracer_->record(c, type, time, processes_.pid(h));
+        }
+    }
+
+    bool all_processes_finished() const {
+        return processes_completed_ == processes_added_;
+    }
+
+    bool has_room(uint32_t c) const {
+        const Core& core = cores_[c];
+        // a preempted process keeps its slot until it is requeued
+        size_t held = can_preempt && core.running != invalid_process_handle ? 1 : 0;
+        return core.ready->size() + held < core.ready->capacity();
+    }
+
+    bool enqueue(uint32_t c, ProcessHandle h){
+        if(!cores_[c].ready->push(h)){
+            return false;
+        }
+        queued_++;
+        return true;
+    }
+
+    bool admit(uint32_t c, ProcessHandle h){
+        if(!has_room(c) || !enqueue(c, h)){
+            return false;
+        }
+        trace(c, SchedEventType::Arrive, processes_.arrival(h), h);
+        trace(c, SchedEventType::Enqueue, current_sim_time_, h);
+        return true;
+    }
+
+    // admit every process that has arrived, idle cores first, then round robin
+    void handle_new_arrivals(){
+        size_t idle_claimed = 0;
+        while(arrivals_.has_arrival_by(current_sim_time_)){
+            ProcessHandle h = arrivals_.peek();
+
+            bool placed = false;
+            while(idle_claimed < idle_cores_.size() && !placed){
+                uint32_t c = idle_cores_[idle_cores_.size() - 1 - idle_claimed++];
+                placed = admit(c, h);
+            }
+            for(size_t tried = 0; !placed && tried < cores_.size(); ++tried){
+                uint32_t c = static_cast<uint32_t>(next_core_);
+                next_core_ = next_core_ + 1 == cores_.size() ? 0 : next_core_ + 1;
+                placed = admit(c, h);
+            }
+
+            if(!placed){
+                // every queue is full, leave it pending until a core frees up
+                deferred_admissions_++;
+                trace(static_cast<uint32_t>(next_core_), SchedEventType::Drop, current_sim_time_, h);
+                break;
+            }
+            arrivals_.pop();
+        }
+    }
+
+    void finish_slice(uint32_t c){
+        Core& core = cores_[c];
+        ProcessHandle h = core.running;
+        if(processes_.state(h) == Process::State::COMPLETED){
+            trace(c, SchedEventType::Complete, current_sim_time_, h);
+            core.running = invalid_process_handle;
+            idle_cores_.push_back(c);
+            record_completion(h);
+            return;
+        }
+        trace(c, SchedEventType::Preempt, current_sim_time_, h);
+        finished_cores_.push_back(c);
+    }
+
+    void requeue_preempted(uint32_t c){
+        Core& core = cores_[c];
+        ProcessHandle h = core.running;
+        if(h == invalid_process_handle){
+            return;
+        }
+        core.running = invalid_process_handle;
+        idle_cores_.push_back(c);
+        // has_room held a slot back for it, so this can't fail
+        enqueue(c, h);
+    }
+
+    // every idle core takes from its own queue, then the ones still idle steal while there
+    // is work anywhere. own queues go first so an arrival placed on one idle core isn't
+    // stolen by another
+    void dispatch_idle_cores(){
+        size_t i = 0;
+        while(i < idle_cores_.size() && queued_ > 0){
+            uint32_t c = idle_cores_[i];
+            ProcessHandle h = cores_[c].ready->pop();
+            if(h == invalid_process_handle){
+                ++i;
+                continue;
+            }
+            take_idle_core(i);
+            dispatch_process(c, h);
+        }
+
+        i = 0;
+        while(i < idle_cores_.size() && queued_ > 0){
+            uint32_t c = idle_cores_[i];
+            ProcessHandle h = steal(c);
+            if(h == invalid_process_handle){
+                ++i;
+                continue;
+            }
+            take_idle_core(i);
+            dispatch_process(c, h);
+        }
+    }
+
+    void take_idle_core(size_t i){
+        queued_--;
+        idle_cores_[i] = idle_cores_.back();
+        idle_cores_.pop_back();
+    }
+
+    // take the next process from the longest ready queue
+    ProcessHandle steal(uint32_t thief){
+        size_t victim = cores_.size();
+        size_t longest = 0;
+        for(size_t c = 0; c < cores_.size(); ++c){
+            size_t queued = cores_[c].ready->size();
+            if(queued > longest){
+                longest = queued;
+                victim = c;
+            }
+        }
+        if(victim == cores_.size()){
+            return invalid_process_handle;
+        }
+
+        ProcessHandle h = cores_[victim].ready->pop();
+        if(h != invalid_process_handle){
+            stats_.core_migrations[thief]++;
+            stats_.total_migrations++;
+        }
+        return h;
+    }
+
+    void dispatch_process(uint32_t c, ProcessHandle h){
+        Core& core = cores_[c];
+        if(processes_.state(h) == Process::State::BLOCKED){
+            if(h == core.last_dispatched){
+                // it never left this core, so this isn't a switch
+                processes_.state(h) = Process::State::RUNNING;
+            } else {
+                stats_.context_switch_latencies.record(current_sim_time_ - processes_.last_run(h));
+            }
+        }
+        core.last_dispatched = h;
+        core.running = h;
+        trace(c, SchedEventType::Dispatch, current_sim_time_, h);
+
+        nanoseconds slice = clock_.slice(processes_, h, current_sim_time_, arrivals_.next_arrival());
+        nanoseconds ran = std::min(slice, processes_.remaining(h));
+        processes_.execute_slice(h, current_sim_time_, ran);
+        core.busy_time += ran;
+        core_events_.push({current_sim_time_ + ran, c});
+    }
+
+    void record_completion(ProcessHandle h){
+        processes_.sync_owner(h);
+        stats_.record_completion(processes_, h);
+        processes_completed_++;
+
+        if(retire_callback_){
+            retire_callback_(h);
+            processes_.release(h);
+        }
+    }
+};
+
+#endif
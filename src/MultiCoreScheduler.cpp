@@ -0,0 +1,6 @@
+#include "MultiCoreScheduler.h"
+
+// the event loop lives in MultiCoreEngine.h, compile the common flavours once here
+template class MultiCoreEngine<FifoReadyQueue, RunToCompletion>;
+template class MultiCoreEngine<ShortestJobReadyQueue, RunToCompletion>;
+template class MultiCoreEngine<FifoReadyQueue, FixedQuantum>;
@@ -0,0 +1,19 @@
+#ifndef MULTI_CORE_SCHEDULER_H
+#define MULTI_CORE_SCHEDULER_H
+
+#include "MultiCoreEngine.h"
+#include "FCFSScheduler.h"
+#include "SJFScheduler.h"
+#include "RoundRobinScheduler.h"
+
+// the single core policies spread over N cores, one ready queue per core
+using MultiCoreFCFSScheduler = MultiCoreEngine<FifoReadyQueue, RunToCompletion>;
+using MultiCoreSJFScheduler = MultiCoreEngine<ShortestJobReadyQueue, RunToCompletion>;
+using MultiCoreRoundRobinScheduler = MultiCoreEngine<FifoReadyQueue, FixedQuantum>;
+
+// instantiated once in MultiCoreScheduler.cpp
+extern template class MultiCoreEngine<FifoReadyQueue, RunToCompletion>;
+extern template class MultiCoreEngine<ShortestJobReadyQueue, RunToCompletion>;
+extern template class MultiCoreEngine<FifoReadyQueue, FixedQuantum>;
+
+#endif
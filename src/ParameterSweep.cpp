@@ -0,0 +1,288 @@
+#include "ParameterSweep.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "FCFSScheduler.h"
+#include "SJFScheduler.h"
+#include "RoundRobinScheduler.h"
+#include "SRTFScheduler.h"
+#include "MLFQScheduler.h"
+#include "FairScheduler.h"
+#include "ProportionalShareScheduler.h"
+#include "Log.h"
+#include "WorkStealingPool.h"
+
+namespace {
+
+constexpr std::string_view sweep_policies[] = {"fcfs", "sjf", "rr", "srtf", "mlfq", "cfs", "eevdf", "lottery", "stride"};
+
+template <typename Scheduler>
+SchedulerStats simulate(Scheduler& scheduler, const SweepWorkload& workload){
+    scheduler.reserve(workload.size());
+    for(const TraceRecord& record : workload){
+        scheduler.add_process(record.pid, nanoseconds(record.arrival_ns), nanoseconds(record.burst_ns),
+                              record.priority);
+    }
+    scheduler.run_simulation();
+    return scheduler.get_stats();
+}
+
+} // namespace
+
+SweepWorkload generate_workload(const WorkloadConfig& config, size_t n){
+    SweepWorkload workload;
+    workload.reserve(n);
+    WorkloadGenerator generator(config);
+    for(size_t i = 0; i < n; ++i){
+        workload.push_back(generator.next());
+    }
+    return workload;
+}
+
+SweepWorkload read_workload(const MappedTrace& trace){
+    SweepWorkload workload;
+    workload.reserve(trace.size());
+    trace.for_each([&workload](const TraceRecord& record){
+        workload.push_back(record);
+    });
+    return workload;
+}
+
+bool is_sweep_policy(std::string_view policy){
+    return std::find(std::begin(sweep_policies), std::end(sweep_policies), policy) != std::end(sweep_policies);
+}
+
+bool sweep_policy_uses_quantum(std::string_view policy){
+    return policy == "rr" || policy == "mlfq" || policy == "cfs" || policy == "eevdf" || policy == "lottery"
+        || policy == "stride";
+}
+
+std::vector<SweepPoint> SweepSpec::points() const {
+    std::vector<SweepPoint> out;
+    for(const std::string& policy : policies){
+        bool uses_quantum = sweep_policy_uses_quantum(policy);
+        for(int capacity : queue_capacities){
+            for(size_t q = 0; q < quanta.size(); ++q){
+                if(!uses_quantum && q > 0){
+                    break;
+                }
+                for(uint64_t seed : seeds){
+                    out.push_back(SweepPoint{policy, capacity, uses_quantum ? quanta[q] : 0ns, seed});
+                }
+            }
+        }
+    }
+    return out;
+}
+
+SchedulerStats run_sweep_point(const SweepPoint& point, const SweepWorkload& workload){
+    const std::string& policy = point.policy;
+    int capacity = point.queue_capacity;
+
+    if(policy == "fcfs"){
+        FCFSScheduler scheduler(capacity);
+        return simulate(scheduler, workload);
+    } else if(policy == "sjf"){
+        SJFScheduler scheduler(capacity);
+        return simulate(scheduler, workload);
+    } else if(policy == "rr"){
+        RoundRobinScheduler scheduler(capacity, LatencyMode::Histogram, FixedQuantum{point.quantum});
+        return simulate(scheduler, workload);
+    } else if(policy == "srtf"){
+        SRTFScheduler scheduler(capacity);
+        return simulate(scheduler, workload);
+    } else if(policy == "mlfq"){
+        MLFQScheduler scheduler(capacity);
+        MLFQConfig config;
+        config.base_quantum = point.quantum;
+        scheduler.ready_queue().configure(config);
+        return simulate(scheduler, workload);
+    } else if(policy == "cfs" || policy == "eevdf"){
+        // same settings as the command line: the CFS period is four slices
+        FairConfig config;
+        config.slice = point.quantum;
+        config.target_latency = point.quantum * 4;
+        if(policy == "cfs"){
+            CFSScheduler scheduler(capacity);
+            scheduler.ready_queue().configure(config);
+            return simulate(scheduler, workload);
+        }
+        EEVDFScheduler scheduler(capacity);
+        scheduler.ready_queue().configure(config);
+        return simulate(scheduler, workload);
+    } else if(policy == "lottery" || policy == "stride"){
+        ProportionalShareConfig config;
+        config.quantum = point.quantum;
+        // each seed's workload gets its own draws
+        config.seed = point.seed;
+        if(policy == "lottery"){
+            LotteryScheduler scheduler(capacity);
+            scheduler.ready_queue().configure(config);
+            return simulate(scheduler, workload);
+        }
+        StrideScheduler scheduler(capacity);
+        scheduler.ready_queue().configure(config);
+        return simulate(scheduler, workload);
+    }
+
+    SCHED_LOG_ERROR("ERROR: unknown sweep policy ", policy);
+    return SchedulerStats{};
+}
+
+ParameterSweep::ParameterSweep(size_t threads)
+    : threads_(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())) {}
+
+template <typename Fn>
+void ParameterSweep::parallel_for(size_t count, Fn&& fn) const {
+    if(count == 0){
+        return;
+    }
+    // no point in more workers than items
+    WorkStealingPool<size_t> pool(std::min(threads_, count), count, [&fn](size_t index, size_t){
+        fn(index);
+    });
+    for(size_t i = 0; i < count; ++i){
+        while(!pool.submit(i)){
+            std::this_thread::yield();
+        }
+    }
+    pool.shutdown();
+}
+
+std::vector<SweepResult> ParameterSweep::run_points(const std::vector<SweepPoint>& points,
+                                                    const std::vector<const SweepWorkload*>& workloads) const {
+    // every run writes only its own slot, so results need no locking
+    std::vector<SweepResult> results(points.size());
+    auto started = steady_clock::now();
+    parallel_for(points.size(), [&](size_t i){
+        auto run_started = steady_clock::now();
+        results[i].point = points[i];
+        results[i].stats = run_sweep_point(points[i], *workloads[i]);
+        results[i].wall_time = duration_cast<nanoseconds>(steady_clock::now() - run_started);
+    });
+    SCHED_LOG_INFO("Sweep of ", points.size(), " runs on ", std::min(threads_, points.size()), " threads took ",
+                   duration_cast<milliseconds>(steady_clock::now() - started).count(), "ms");
+    return results;
+}
+
+std::vector<SweepResult> ParameterSweep::run(const SweepSpec& spec) const {
+    for(const std::string& policy : spec.policies){
+        if(!is_sweep_policy(policy)){
+            SCHED_LOG_ERROR("ERROR: unknown sweep policy ", policy);
+            return {};
+        }
+    }
+
+    // one workload per seed, generated in parallel and shared by every run of that seed
+    std::vector<SweepWorkload> workloads(spec.seeds.size());
+    parallel_for(spec.seeds.size(), [&](size_t s){
+        WorkloadConfig config = spec.workload;
+        config.seed = spec.seeds[s];
+        workloads[s] = generate_workload(config, spec.processes);
+    });
+
+    std::vector<SweepPoint> points = spec.points();
+    std::vector<const SweepWorkload*> point_workloads;
+    point_workloads.reserve(points.size());
+    for(const SweepPoint& point : points){
+        size_t s = std::find(spec.seeds.begin(), spec.seeds.end(), point.seed) - spec.seeds.begin();
+        point_workloads.push_back(&workloads[s]);
+    }
+    return run_points(points, point_workloads);
+}
+
+std::vector<SweepResult> ParameterSweep::run(const SweepSpec& spec, const SweepWorkload& workload) const {
+    for(const std::string& policy : spec.policies){
+        if(!is_sweep_policy(policy)){
+            SCHED_LOG_ERROR("ERROR: unknown sweep policy ", policy);
+            return {};
+        }
+    }
+
+    SweepSpec fixed = spec;
+    fixed.seeds = {0};
+    std::vector<SweepPoint> points = fixed.points();
+    return run_points(points, std::vector<const SweepWorkload*>(points.size(), &workload));
+}
+
+std::vector<SweepRow> summarize_sweep(const std::vector<SweepResult>& results){
+    std::vector<SweepRow> rows;
+    for(const SweepResult& result : results){
+        const SweepPoint& point = result.point;
+        auto row = std::find_if(rows.begin(), rows.end(), [&point](const SweepRow& r){
+            return r.policy == point.policy && r.queue_capacity == point.queue_capacity && r.quantum == point.quantum;
+        });
+        if(row == rows.end()){
+            rows.push_back(SweepRow{point.policy, point.queue_capacity, point.quantum, 0, SchedulerStats{}, 0ns});
+            row = rows.end() - 1;
+        }
+        row->runs++;
+        row->stats.merge(result.stats);
+        row->wall_time += result.wall_time;
+    }
+    return rows;
+}
+
+namespace {
+
+double utilization(const SchedulerStats& stats){
+    if(stats.total_sim_time.count() == 0) return 0.0;
+    return static_cast<double>(stats.total_cpu_burst_time.count()) / stats.total_sim_time.count();
+}
+
+} // namespace
+
+void print_sweep_table(const std::vector<SweepRow>& rows){
+    std::cout << std::left << std::setw(8) << "policy" << std::right
+              << std::setw(10) << "capacity" << std::setw(10) << "quantum" << std::setw(6) << "runs"
+              << std::setw(12) << "processes" << std::setw(14) << "avg_turn" << std::setw(14) << "p99_turn"
+              << std::setw(14) << "p99_resp" << std::setw(10) << "util%" << std::setw(8) << "jain"
+              << std::setw(12) << "wall_ms" << "\n";
+    for(const SweepRow& row : rows){
+        const SchedulerStats& stats = row.stats;
+        std::cout << std::left << std::setw(8) << row.policy << std::right
+                  << std::setw(10) << row.queue_capacity << std::setw(10) << row.quantum.count()
+                  << std::setw(6) << row.runs << std::setw(12) << stats.total_processes_completed
+                  << std::setw(14) << stats.turnaround_times.mean().count()
+                  << std::setw(14) << stats.calculate_percentile(stats.turnaround_times, 99.0).count()
+                  << std::setw(14) << stats.calculate_percentile(stats.response_times, 99.0).count()
+                  << std::setw(10) << std::fixed << std::setprecision(1) << utilization(stats) * 100.0
+                  << std::setw(8) << std::setprecision(3) << stats.jains_index()
+                  << std::setw(12) << std::setprecision(1) << row.wall_time.count() / 1e6 << "\n"
+                  << std::defaultfloat << std::setprecision(6);
+    }
+}
+
+bool write_sweep_csv(const std::vector<SweepRow>& rows, const std::string& path){
+    std::ofstream out(path);
+    if(!out){
+        SCHED_LOG_ERROR("ERROR: could not open ", path, " for writing");
+        return false;
+    }
+    out << "policy,queue_capacity,quantum_ns,runs,processes,avg_turnaround_ns,p99_turnaround_ns,"
+        << "avg_waiting_ns,p99_waiting_ns,avg_response_ns,p99_response_ns,context_switches,"
+        << "utilization,jains_index,wall_ns\n";
+    for(const SweepRow& row : rows){
+        const SchedulerStats& stats = row.stats;
+        out << row.policy << ',' << row.queue_capacity << ',' << row.quantum.count() << ',' << row.runs << ','
+            << stats.total_processes_completed << ','
+            << stats.turnaround_times.mean().count() << ','
+            << stats.calculate_percentile(stats.turnaround_times, 99.0).count() << ','
+            << stats.waiting_times.mean().count() << ','
+            << stats.calculate_percentile(stats.waiting_times, 99.0).count() << ','
+            << stats.response_times.mean().count() << ','
+            << stats.calculate_percentile(stats.response_times, 99.0).count() << ','
+            << stats.total_context_switches << ','
+            << utilization(stats) << ',' << stats.jains_index() << ',' << row.wall_time.count() << '\n';
+    }
+    out.close();
+    if(!out){
+        SCHED_LOG_ERROR("ERROR: failed writing ", path);
+        return false;
+    }
+    return true;
+}
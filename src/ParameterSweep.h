@@ -0,0 +1,117 @@
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SchedulerStats.h"
+#include "TraceFormat.h"
+#include "WorkloadGenerator.h"
+
+using namespace std::chrono;
+
+// a workload as plain records, generated or read once and then shared read-only by
+// every run that uses it
+using SweepWorkload = std::vector<TraceRecord>;
+
+SweepWorkload generate_workload(const WorkloadConfig& config, size_t n);
+SweepWorkload read_workload(const MappedTrace& trace);
+
+// policies a sweep can run: fcfs, sjf, rr, srtf, mlfq, cfs, eevdf, lottery and stride
+bool is_sweep_policy(std::string_view policy);
+
+// rr, mlfq, cfs, eevdf, lottery and stride, the others ignore the quantum
+bool sweep_policy_uses_quantum(std::string_view policy);
+
+// one simulation of a sweep
+struct SweepPoint {
+    std::string policy;
+    int queue_capacity = 1024;
+    // round robin quantum, MLFQ base quantum, CFS/EEVDF slice, lottery/stride quantum. 0 for
+    // policies without one
+    nanoseconds quantum = 0ns;
+    // seed of the generated workload, 0 when the sweep runs on a fixed workload
+    uint64_t seed = 0;
+};
+
+// the grid of a sweep: every policy with every capacity, quantum and seed
+struct SweepSpec {
+    std::vector<std::string> policies = {"fcfs"};
+    std::vector<int> queue_capacities = {1024};
+    std::vector<nanoseconds> quanta = {10ns};
+    std::vector<uint64_t> seeds = {1};
+
+    // the generated workloads, seed is replaced by each of seeds in turn
+    WorkloadConfig workload;
+    size_t processes = 10000;
+
+    // policy, capacity, quantum, seed order. policies without a quantum get one point
+    // per capacity and seed rather than one per quantum
+    std::vector<SweepPoint> points() const;
+};
+
+struct SweepResult {
+    SweepPoint point;
+    SchedulerStats stats;
+    // real time the simulation took, setup included
+    nanoseconds wall_time = 0ns;
+};
+
+// one row of the results table: the runs of a (policy, capacity, quantum) over every
+// seed, with their stats merged
+struct SweepRow {
+    std::string policy;
+    int queue_capacity = 0;
+    nanoseconds quantum = 0ns;
+    size_t runs = 0;
+    SchedulerStats stats;
+    nanoseconds wall_time = 0ns;
+};
+
+// run a single point on the calling thread
+SchedulerStats run_sweep_point(const SweepPoint& point, const SweepWorkload& workload);
+
+// fans the points of a sweep out over a pool of worker threads. every run has its own
+// scheduler and process table and only reads the workload it shares with the other
+// runs of its seed, so the runs never contend and scale with the number of cores
+class ParameterSweep{
+public:
+    // threads = 0 uses every hardware thread
+    explicit ParameterSweep(size_t threads = 0);
+
+    size_t thread_count() const { return threads_; }
+
+    // generate one workload per seed (in parallel as well) and run every point on its
+    // seed's workload. results are in spec.points() order
+    std::vector<SweepResult> run(const SweepSpec& spec) const;
+
+    // run every point on the same workload, e.g. a recorded trace. the spec's seeds and
+    // workload settings are ignored
+    std::vector<SweepResult> run(const SweepSpec& spec, const SweepWorkload& workload) const;
+
+private:
+    size_t threads_;
+
+    // call fn(i) for every i in [0, count) on the worker threads and wait for all of them
+    template <typename Fn>
+    void parallel_for(size_t count, Fn&& fn) const;
+
+    std::vector<SweepResult> run_points(const std::vector<SweepPoint>& points,
+                                        const std::vector<const SweepWorkload*>& workloads) const;
+};
+
+// merge the results of every seed into one row per (policy, capacity, quantum), in the
+// order the rows first appear
+std::vector<SweepRow> summarize_sweep(const std::vector<SweepResult>& results);
+
+// aligned table on std::cout
+void print_sweep_table(const std::vector<SweepRow>& rows);
+
+// one line per row with a header, false if the file couldn't be written
+bool write_sweep_csv(const std::vector<SweepRow>& rows, const std::string& path);
+
+#endif
@@ -0,0 +1,97 @@
+#include "PhaseProfiler.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "Log.h"
+
+#ifdef __linux__
+
+namespace {
+
+int open_counter(uint64_t config, int group){
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = group < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    // this thread, on any cpu
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+}
+
+} // namespace
+
+bool PerfCounterGroup::open(){
+    close();
+    constexpr uint64_t configs[hardware_counter_count] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES,
+    };
+
+    fds_[0] = open_counter(configs[0], -1);
+    if(fds_[0] < 0){
+        SCHED_LOG_WARN("WARNING: perf_event_open failed (", std::strerror(errno),
+                       "), hardware counters are off");
+        return false;
+    }
+    for(size_t c = 1; c < hardware_counter_count; ++c){
+        fds_[c] = open_counter(configs[c], fds_[0]);
+        if(fds_[c] < 0){
+            SCHED_LOG_INFO("Hardware counter ", c, " is not available, it reads as 0");
+        }
+    }
+    ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+
+void PerfCounterGroup::close(){
+    for(int& fd : fds_){
+        if(fd >= 0){
+            ::close(fd);
+            fd = -1;
+        }
+    }
+}
+
+void PerfCounterGroup::read(std::array<uint64_t, hardware_counter_count>& values) const {
+    // PERF_FORMAT_GROUP: the number of events, then one value per opened event in the
+    // order they joined the group
+    uint64_t buffer[1 + hardware_counter_count] = {};
+    values.fill(0);
+    if(::read(fds_[0], buffer, sizeof(buffer)) <= 0){
+        return;
+    }
+    size_t next = 1;
+    for(size_t c = 0; c < hardware_counter_count && next <= buffer[0]; ++c){
+        if(fds_[c] >= 0){
+            values[c] = buffer[next++];
+        }
+    }
+}
+
+#else
+
+bool PerfCounterGroup::open(){
+    SCHED_LOG_WARN("WARNING: hardware counters need perf_event_open, which is Linux only");
+    return false;
+}
+
+void PerfCounterGroup::close(){}
+
+void PerfCounterGroup::read(std::array<uint64_t, hardware_counter_count>& values) const {
+    values.fill(0);
+}
+
+#endif
@@ -0,0 +1,280 @@
+#ifndef PHASE_PROFILER_H
+#define PHASE_PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using namespace std::chrono;
+
+// the simulation loop's phase timers are compiled in only when this is 1, otherwise
+// every SCHED_PROFILE_PHASE and the profiler member disappear. set from CMake with
+// -DSCHEDULER_PROFILE=ON
+#ifndef SCHEDULER_PROFILE
+#define SCHEDULER_PROFILE 0
+#endif
+
+// where run_simulation() spends its time. Other is the loop itself and anything not
+// inside one of the named phases, so the phases always add up to the whole run
+enum class SimPhase : uint8_t {
+    Arrivals,   // admitting arrived processes into the ready queue
+    Pick,       // ready queue pops, and pushes of preempted processes
+    Dispatch,   // running a slice and advancing the clock
+    Stats,      // recording completions and context switch latencies
+    ClockSkip,  // finding the next arrival when nothing is ready
+    Other,
+};
+
+inline constexpr size_t sim_phase_count = 6;
+
+inline const char* sim_phase_name(SimPhase phase){
+    constexpr const char* names[sim_phase_count] = {"arrivals", "pick", "dispatch", "stats", "clock skip", "other"};
+    return names[static_cast<size_t>(phase)];
+}
+
+// time stamp counter where there is one, the steady clock in nanoseconds elsewhere
+inline uint64_t read_tsc(){
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// hardware counters per phase, see PerfCounterGroup
+enum class HardwareCounter : uint8_t { Cycles, Instructions, CacheMisses, BranchMisses };
+
+inline constexpr size_t hardware_counter_count = 4;
+
+struct PhaseCounters {
+    // times the phase was entered, and ticks spent in it
+    uint64_t entries = 0;
+    uint64_t ticks = 0;
+    // user space events, all zero unless hardware counters were enabled
+    std::array<uint64_t, hardware_counter_count> events{};
+
+    uint64_t event(HardwareCounter counter) const { return events[static_cast<size_t>(counter)]; }
+};
+
+// per phase results of a profiled run, kept next to SchedulerStats and merged the same way
+struct PhaseProfile {
+    std::array<PhaseCounters, sim_phase_count> phases{};
+    // ticks per nanosecond, measured against the steady clock over the run. 0 means
+    // nothing was profiled
+    double ticks_per_ns = 0.0;
+    // which of the hardware counters could be opened
+    std::array<bool, hardware_counter_count> hardware{};
+
+    bool empty() const { return ticks_per_ns == 0.0; }
+
+    const PhaseCounters& operator[](SimPhase phase) const { return phases[static_cast<size_t>(phase)]; }
+
+    bool has_counter(HardwareCounter counter) const { return hardware[static_cast<size_t>(counter)]; }
+
+    uint64_t total_ticks() const {
+        uint64_t total = 0;
+        for(const PhaseCounters& phase : phases){
+            total += phase.ticks;
+        }
+        return total;
+    }
+
+    nanoseconds time(SimPhase phase) const {
+        if(empty()) return 0ns;
+        return nanoseconds(static_cast<int64_t>((*this)[phase].ticks / ticks_per_ns));
+    }
+
+    // fraction of the profiled time spent in phase
+    double share(SimPhase phase) const {
+        uint64_t total = total_ticks();
+        return total == 0 ? 0.0 : static_cast<double>((*this)[phase].ticks) / total;
+    }
+
+    // fold in the profile of another run. the tick rate is the same machine's, so the
+    // first non-empty one is kept
+    void merge(const PhaseProfile& other){
+        for(size_t p = 0; p < sim_phase_count; ++p){
+            phases[p].entries += other.phases[p].entries;
+            phases[p].ticks += other.phases[p].ticks;
+            for(size_t c = 0; c < hardware_counter_count; ++c){
+                phases[p].events[c] += other.phases[p].events[c];
+            }
+        }
+        if(empty()){
+            ticks_per_ns = other.ticks_per_ns;
+        }
+        for(size_t c = 0; c < hardware_counter_count; ++c){
+            hardware[c] = hardware[c] || other.hardware[c];
+        }
+    }
+
+    void print() const {
+        if(empty()){
+            std::cout << "No phase profile, rebuild with -DSCHEDULER_PROFILE=ON\n";
+            return;
+        }
+        constexpr const char* counter_names[hardware_counter_count] = {"cycles", "instructions", "cache_miss", "branch_miss"};
+        std::cout << std::left << std::setw(12) << "phase" << std::right << std::setw(12) << "entries"
+                  << std::setw(14) << "time_ns" << std::setw(8) << "share%";
+        for(size_t c = 0; c < hardware_counter_count; ++c){
+            if(hardware[c]){
+                std::cout << std::setw(14) << counter_names[c];
+            }
+        }
+        std::cout << "\n";
+        for(size_t p = 0; p < sim_phase_count; ++p){
+            SimPhase phase = static_cast<SimPhase>(p);
+            std::cout << std::left << std::setw(12) << sim_phase_name(phase) << std::right
+                      << std::setw(12) << phases[p].entries << std::setw(14) << time(phase).count()
+                      << std::setw(8) << std::fixed << std::setprecision(1) << share(phase) * 100.0
+                      << std::defaultfloat << std::setprecision(6);
+            for(size_t c = 0; c < hardware_counter_count; ++c){
+                if(hardware[c]){
+                    std::cout << std::setw(14) << phases[p].events[c];
+                }
+            }
+            std::cout << "\n";
+        }
+    }
+};
+
+// cycles, instructions, cache misses and branch misses of the calling thread in user
+// space, through one perf_event_open group so all four are read with a single read().
+// kernel time is excluded, which also keeps the cost of the read itself out of the counts
+class PerfCounterGroup{
+public:
+    PerfCounterGroup() = default;
+    PerfCounterGroup(const PerfCounterGroup&) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+    ~PerfCounterGroup(){ close(); }
+
+    // false if not even cycles can be counted (no PMU, perf_event_paranoid, not Linux).
+    // counters the machine doesn't have are left out and read as 0
+    bool open();
+    void close();
+
+    bool is_open() const { return fds_[0] >= 0; }
+    bool has(HardwareCounter counter) const { return fds_[static_cast<size_t>(counter)] >= 0; }
+
+    // current totals, in HardwareCounter order
+    void read(std::array<uint64_t, hardware_counter_count>& values) const;
+
+private:
+    int fds_[hardware_counter_count] = {-1, -1, -1, -1};
+};
+
+// exclusive phase timer: exactly one phase is open at a time and every switch charges the
+// ticks (and hardware events) since the previous switch to the phase being left. a
+// switch is one rdtsc, plus one read() syscall when hardware counters are on, so
+// profiled runs are slower but the split between phases stays meaningful
+class PhaseProfiler{
+public:
+    // count hardware events as well, from the next start() on. false if perf isn't available
+    bool enable_hardware_counters(){
+        if(!perf_.is_open() && !perf_.open()){
+            return false;
+        }
+        for(size_t c = 0; c < hardware_counter_count; ++c){
+            profile_.hardware[c] = perf_.has(static_cast<HardwareCounter>(c));
+        }
+        return true;
+    }
+
+    // clear the previous results and open the Other phase
+    void start(){
+        std::array<bool, hardware_counter_count> hardware = profile_.hardware;
+        profile_ = PhaseProfile{};
+        profile_.hardware = hardware;
+        current_ = SimPhase::Other;
+        profile_.phases[static_cast<size_t>(current_)].entries++;
+        started_at_ = steady_clock::now();
+        if(perf_.is_open()){
+            perf_.read(last_events_);
+        }
+        started_ticks_ = last_ticks_ = read_tsc();
+    }
+
+    // close the open phase and work out the tick rate
+    void stop(){
+        switch_to(SimPhase::Other);
+        double elapsed = static_cast<double>(duration_cast<nanoseconds>(steady_clock::now() - started_at_).count());
+        uint64_t ticks = last_ticks_ - started_ticks_;
+        profile_.ticks_per_ns = elapsed > 0 && ticks > 0 ? ticks / elapsed : 1.0;
+    }
+
+    // enter phase, returns the phase that was open so it can be restored
+    SimPhase enter(SimPhase phase){
+        SimPhase previous = switch_to(phase);
+        profile_.phases[static_cast<size_t>(phase)].entries++;
+        return previous;
+    }
+
+    // go back to a phase left by enter(), not counted as a new entry
+    void resume(SimPhase phase){ switch_to(phase); }
+
+    const PhaseProfile& profile() const { return profile_; }
+
+private:
+    PhaseProfile profile_;
+    PerfCounterGroup perf_;
+    SimPhase current_ = SimPhase::Other;
+    uint64_t started_ticks_ = 0;
+    uint64_t last_ticks_ = 0;
+    steady_clock::time_point started_at_;
+    std::array<uint64_t, hardware_counter_count> last_events_{};
+
+    SimPhase switch_to(SimPhase phase){
+        uint64_t now = read_tsc();
+        PhaseCounters& counters = profile_.phases[static_cast<size_t>(current_)];
+        counters.ticks += now - last_ticks_;
+        last_ticks_ = now;
+        if(perf_.is_open()){
+            std::array<uint64_t, hardware_counter_count> events;
+            perf_.read(events);
+            for(size_t c = 0; c < hardware_counter_count; ++c){
+                counters.events[c] += events[c] - last_events_[c];
+            }
+            last_events_ = events;
+        }
+        SimPhase previous = current_;
+        current_ = phase;
+        return previous;
+    }
+};
+
+// the phase for the rest of the enclosing scope, the previous one is restored on exit
+class PhaseScope{
+public:
+    PhaseScope(PhaseProfiler& profiler, SimPhase phase)
+        : profiler_(profiler), previous_(profiler.enter(phase)) {}
+    PhaseScope(const PhaseScope&) = delete;
+    PhaseScope& operator=(const PhaseScope&) = delete;
+    ~PhaseScope(){ profiler_.resume(previous_); }
+
+private:
+    PhaseProfiler& profiler_;
+    SimPhase previous_;
+};
+
+#define SCHED_PROFILE_CONCAT_(a, b) a##b
+#define SCHED_PROFILE_CONCAT(a, b) SCHED_PROFILE_CONCAT_(a, b)
+
+#if SCHEDULER_PROFILE
+#define SCHED_PROFILE_PHASE(profiler, phase) \
+    PhaseScope SCHED_PROFILE_CONCAT(sched_profile_scope_, __LINE__)(profiler, phase)
+#else
+#define SCHED_PROFILE_PHASE(profiler, phase) ((void)0)
+#endif
+
+#endif
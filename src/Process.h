@@ -4,16 +4,54 @@
 #include <chrono>
 #include <atomic>
 #include <string>
-#include <functional>
-#include <iostream>
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+
+#include "InlineFunction.h"
+#include "Log.h"
 
 using namespace std::chrono;
+
+// nice levels as on Linux, from -20 (largest share) to 19. nice 0 weighs 1024 and every
+// step is worth about 10% CPU against a process one level away
+inline constexpr int min_nice = -20;
+inline constexpr int max_nice = 19;
+inline constexpr uint32_t nice_0_weight = 1024;
+
+inline constexpr int clamp_nice(int nice){
+    return nice < min_nice ? min_nice : (nice > max_nice ? max_nice : nice);
+}
+
+inline constexpr uint32_t nice_weight(int nice){
+    constexpr uint32_t weights[max_nice - min_nice + 1] = {
+        88761, 71755, 56483, 46273, 36291,
+        29154, 23254, 18705, 14949, 11916,
+        9548, 7620, 6100, 4904, 3906,
+        3121, 2501, 1991, 1586, 1277,
+        1024, 820, 655, 526, 423,
+        335, 272, 215, 172, 137,
+        110, 87, 70, 56, 45,
+        36, 29, 23, 18, 15,
+    };
+    return weights[clamp_nice(nice) - min_nice];
+}
+
 struct Process {
-    enum class State { READY, RUNNING, BLOCKED, COMPLETED };
+    // one byte so ProcessTable can keep a dense state column. BLOCKED is switched out after
+    // a slice, IO_WAIT is waiting on an I/O burst and stays set until it is dispatched again
+    enum class State : uint8_t { READY, RUNNING, BLOCKED, COMPLETED, IO_WAIT };
     
     int pid;
     std::chrono::nanoseconds arrival_time;
     std::chrono::nanoseconds burst_time;
+    // only weighted policies (CFS, EEVDF) look at it, see nice_weight
+    int nice = 0;
+    // share under lottery and stride scheduling, 0 means the weight of its nice level
+    uint32_t tickets = 0;
+    // alternating cpu and I/O bursts, cpu first and last, for a process that does I/O.
+    // empty means a single cpu burst of burst_time. only the simulation engine uses it
+    std::vector<std::chrono::nanoseconds> bursts;
     std::atomic<std::chrono::nanoseconds> remaining_time;
     std::atomic<std::chrono::nanoseconds> start_time;
     std::atomic<std::chrono::nanoseconds> completion_time;
@@ -25,21 +63,25 @@ struct Process {
 
     std::atomic_flag paused = ATOMIC_FLAG_INIT;
 
-    std::function<void()> task;
+    // stored inline, so building a Process never allocates
+    InlineFunction<void()> task;
 
     Process(int pid, std::chrono::nanoseconds arrival,std::chrono::nanoseconds burst)
       : pid(pid), arrival_time(arrival), burst_time(burst), remaining_time(burst),
         start_time(std::chrono::nanoseconds(0)), completion_time(std::chrono::nanoseconds(0)), last_run_timestamp(std::chrono::nanoseconds(0)),
         current_state(State::READY){
         task=[this]() {
-            std::cout << "Executing task" << std::endl;
+            SCHED_LOG_TRACE("Executing task");
             // simulating simple work done by CPU
             volatile int x = 0; // volatile to make sure CPU doesn't optimize
             for(int i = 0; i < 10; ++i){ i++; }
         };
     } 
 
-    void execute_slice(std::chrono::nanoseconds curr_sim_time) {
+    // run for up to slice (the whole remaining burst by default) starting at curr_sim_time.
+    // a process that still has time left afterwards is BLOCKED until it is dispatched again
+    void execute_slice(std::chrono::nanoseconds curr_sim_time,
+                       std::chrono::nanoseconds slice = std::chrono::nanoseconds::max()) {
         // using load to make sure operation is atomic
         if (current_state.load() == State::READY) {
             start_time.store(curr_sim_time);
@@ -54,18 +96,18 @@ struct Process {
         }
 
         task();
-        // remaining_time.store(remaining_time.load() - 1ns);
-        remaining_time.store(0ns);
-        last_run_timestamp.store(curr_sim_time + 1ns);
+        // advance by the whole slice at once instead of 1ns steps
+        std::chrono::nanoseconds ran = std::min(slice, remaining_time.load());
+        remaining_time.store(remaining_time.load() - ran);
+        last_run_timestamp.store(curr_sim_time + ran);
 
         if(remaining_time.load() <= std::chrono::nanoseconds(0)){
-            // completion_time.store(curr_sim_time + 1ns);
-            completion_time.store(curr_sim_time + burst_time);
+            completion_time.store(curr_sim_time + ran);
             current_state.store(State::COMPLETED);
         } else {
             current_state.store(State::BLOCKED);
         }
-        std::cout << "Remaining time seen: " << remaining_time.load().count() << std::endl;
+        SCHED_LOG_TRACE("Remaining time seen: ", remaining_time.load());
     }
 
     // metrics relating to the process
@@ -0,0 +1,122 @@
+#ifndef PROCESS_POOL_H
+#define PROCESS_POOL_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <sys/mman.h>
+
+#include "Process.h"
+
+using namespace std::chrono;
+
+// arena for Process objects: they are constructed in place in large slabs instead of one
+// heap allocation each, and all of them are destroyed at once by clear() or when the pool
+// goes away, typically once the simulation that uses them has finished. pointers stay
+// valid until then, so they can be handed straight to add_process().
+//
+// not thread safe, create processes from one thread
+class ProcessPool{
+public:
+    // processes per slab, the default makes a slab one 2MB huge page
+    explicit ProcessPool(size_t slab_size = huge_page / sizeof(Process))
+        : slab_size_(slab_size > 0 ? slab_size : 1) {}
+
+    ProcessPool(const ProcessPool&) = delete;
+    ProcessPool& operator=(const ProcessPool&) = delete;
+
+    ~ProcessPool(){ clear(); }
+
+    Process* create(int pid, nanoseconds arrival, nanoseconds burst){
+        if(next_ == end_){
+            next_slab();
+        }
+        Process* p = ::new(static_cast<void*>(next_)) Process(pid, arrival, burst);
+        ++next_;
+        used_++;
+        return p;
+    }
+
+    // make room for n processes in total, so the next creates don't allocate at all
+    void reserve(size_t n){
+        while(slabs_.size() * slab_size_ < n){
+            add_slab();
+        }
+    }
+
+    // destroy every process, the slabs are kept for reuse
+    void clear(){
+        size_t left = used_;
+        for(size_t s = 0; left > 0; ++s){
+            Slot* slab = slabs_[s].get();
+            size_t count = left < slab_size_ ? left : slab_size_;
+            for(size_t i = 0; i < count; ++i){
+                std::launder(reinterpret_cast<Process*>(&slab[i]))->~Process();
+            }
+            left -= count;
+        }
+        used_ = 0;
+        current_ = 0;
+        next_ = end_ = nullptr;
+    }
+
+    // give the slabs back as well
+    void release(){
+        clear();
+        slabs_.clear();
+        slabs_.shrink_to_fit();
+    }
+
+    size_t size() const { return used_; }
+    size_t capacity() const { return slabs_.size() * slab_size_; }
+
+private:
+    static constexpr size_t huge_page = size_t(2) << 20;
+
+    // uninitialised storage for one Process
+    struct Slot {
+        alignas(Process) unsigned char bytes[sizeof(Process)];
+    };
+
+    struct FreeSlab {
+        void operator()(Slot* slab) const { std::free(slab); }
+    };
+
+    const size_t slab_size_;
+    std::vector<std::unique_ptr<Slot[], FreeSlab>> slabs_;
+    size_t used_ = 0;
+
+    // slab being filled, and the free part of it
+    size_t current_ = 0;
+    Slot* next_ = nullptr;
+    Slot* end_ = nullptr;
+
+    void next_slab(){
+        size_t index = next_ ? current_ + 1 : 0;
+        if(index == slabs_.size()){
+            add_slab();
+        }
+        current_ = index;
+        next_ = slabs_[index].get();
+        end_ = next_ + slab_size_;
+    }
+
+    void add_slab(){
+        // huge page aligned and backed where the kernel allows it, so touching a fresh
+        // slab costs one page fault instead of hundreds. the bytes are left untouched
+        // until a Process is built there
+        size_t bytes = (slab_size_ * sizeof(Slot) + huge_page - 1) / huge_page * huge_page;
+        void* memory = std::aligned_alloc(huge_page, bytes);
+        if(!memory){
+            throw std::bad_alloc();
+        }
+        ::madvise(memory, bytes, MADV_HUGEPAGE);
+        slabs_.emplace_back(static_cast<Slot*>(memory));
+    }
+};
+
+#endif
@@ -0,0 +1,317 @@
+#ifndef PROCESS_TABLE_H
+#define PROCESS_TABLE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Process.h"
+
+using namespace std::chrono;
+
+// 32-bit index of a process in a ProcessTable
+using ProcessHandle = uint32_t;
+inline constexpr ProcessHandle invalid_process_handle = UINT32_MAX;
+
+// scheduler-side process state stored as one contiguous column per field (structure
+// of arrays), so scans touch only the fields they need and a process costs ~60 bytes
+// instead of a Process object with atomics and a task callable. a Process passed in
+// by the caller is kept as the "owner" so its task can run and its fields can be
+// filled in when it completes
+class ProcessTable{
+public:
+    using State = Process::State;
+
+    void reserve(size_t n){
+        pid_.reserve(n);
+        arrival_.reserve(n);
+        burst_.reserve(n);
+        remaining_.reserve(n);
+        start_.reserve(n);
+        completion_.reserve(n);
+        last_run_.reserve(n);
+        context_switches_.reserve(n);
+        state_.reserve(n);
+        nice_.reserve(n);
+    }
+
+    // new READY process, reusing a released slot if there is one
+    ProcessHandle add(int pid, nanoseconds arrival, nanoseconds burst, Process* owner = nullptr){
+        ProcessHandle h;
+        if(!free_handles_.empty()){
+            h = free_handles_.back();
+            free_handles_.pop_back();
+            pid_[h] = pid;
+            arrival_[h] = arrival;
+            burst_[h] = burst;
+            remaining_[h] = burst;
+            start_[h] = 0ns;
+            completion_[h] = 0ns;
+            last_run_[h] = 0ns;
+            context_switches_[h] = 0;
+            state_[h] = State::READY;
+            nice_[h] = 0;
+            if(h < tickets_.size()){
+                tickets_[h] = 0;
+            }
+            clear_bursts(h);
+        } else {
+            h = static_cast<ProcessHandle>(pid_.size());
+            pid_.push_back(pid);
+            arrival_.push_back(arrival);
+            burst_.push_back(burst);
+            remaining_.push_back(burst);
+            start_.push_back(0ns);
+            completion_.push_back(0ns);
+            last_run_.push_back(0ns);
+            context_switches_.push_back(0);
+            state_.push_back(State::READY);
+            nice_.push_back(0);
+        }
+
+        // the owner column is only allocated once somebody actually passes a Process
+        if(owner || h < owners_.size()){
+            if(owners_.size() <= h){
+                owners_.resize(h + 1, nullptr);
+            }
+            owners_[h] = owner;
+        }
+
+        live_++;
+        return h;
+    }
+
+    // hand a finished process's slot back for reuse, its handle is invalid afterwards
+    void release(ProcessHandle h){
+        if(h < owners_.size()){
+            owners_[h] = nullptr;
+        }
+        clear_bursts(h);
+        free_handles_.push_back(h);
+        live_--;
+    }
+
+    // number of slots, including released ones
+    size_t size() const { return pid_.size(); }
+
+    // number of processes that have not been released
+    size_t live() const { return live_; }
+
+    int pid(ProcessHandle h) const { return pid_[h]; }
+    nanoseconds arrival(ProcessHandle h) const { return arrival_[h]; }
+    nanoseconds burst(ProcessHandle h) const { return burst_[h]; }
+
+    nanoseconds& remaining(ProcessHandle h) { return remaining_[h]; }
+    nanoseconds remaining(ProcessHandle h) const { return remaining_[h]; }
+
+    nanoseconds& start(ProcessHandle h) { return start_[h]; }
+    nanoseconds start(ProcessHandle h) const { return start_[h]; }
+
+    nanoseconds& completion(ProcessHandle h) { return completion_[h]; }
+    nanoseconds completion(ProcessHandle h) const { return completion_[h]; }
+
+    nanoseconds& last_run(ProcessHandle h) { return last_run_[h]; }
+    nanoseconds last_run(ProcessHandle h) const { return last_run_[h]; }
+
+    uint32_t& context_switches(ProcessHandle h) { return context_switches_[h]; }
+    uint32_t context_switches(ProcessHandle h) const { return context_switches_[h]; }
+
+    State& state(ProcessHandle h) { return state_[h]; }
+    State state(ProcessHandle h) const { return state_[h]; }
+
+    // nice level, 0 unless set after add(). clamped to [min_nice, max_nice]
+    void set_nice(ProcessHandle h, int nice){ nice_[h] = static_cast<int8_t>(clamp_nice(nice)); }
+    int nice(ProcessHandle h) const { return nice_[h]; }
+    uint32_t weight(ProcessHandle h) const { return nice_weight(nice_[h]); }
+
+    // lottery and stride tickets, the nice level's weight unless set after add(). 0 goes
+    // back to the weight
+    void set_tickets(ProcessHandle h, uint32_t tickets){
+        if(tickets_.size() <= h){
+            if(tickets == 0){
+                return;
+            }
+            tickets_.resize(static_cast<size_t>(h) + 1, 0);
+        }
+        tickets_[h] = tickets;
+    }
+    uint32_t tickets(ProcessHandle h) const {
+        return h < tickets_.size() && tickets_[h] != 0 ? tickets_[h] : weight(h);
+    }
+
+    Process* owner(ProcessHandle h) const { return h < owners_.size() ? owners_[h] : nullptr; }
+
+    // give h alternating cpu and I/O bursts, cpu first and last, before it first runs.
+    // its burst becomes the total cpu time. false (and nothing changes) unless there is an
+    // odd number of bursts, every cpu burst is positive and no I/O burst is negative
+    bool set_bursts(ProcessHandle h, std::span<const nanoseconds> bursts){
+        if(bursts.size() % 2 == 0){
+            return false;
+        }
+        nanoseconds cpu = 0ns;
+        nanoseconds io = 0ns;
+        for(size_t i = 0; i < bursts.size(); ++i){
+            if(i % 2 == 0 ? bursts[i] <= 0ns : bursts[i] < 0ns){
+                return false;
+            }
+            (i % 2 == 0 ? cpu : io) += bursts[i];
+        }
+
+        clear_bursts(h);
+        burst_[h] = cpu;
+        remaining_[h] = cpu;
+        if(bursts.size() == 1){
+            return true;
+        }
+
+        // the I/O columns are only allocated once somebody actually has I/O
+        if(phase_.size() <= h){
+            phase_.resize(h + 1, 0);
+            phase_end_.resize(h + 1, 0);
+            burst_left_.resize(h + 1, 0ns);
+            io_total_.resize(h + 1, 0ns);
+        }
+        if(with_io_ == 0){
+            phases_.clear();
+        }
+        phase_[h] = static_cast<uint32_t>(phases_.size());
+        phases_.insert(phases_.end(), bursts.begin(), bursts.end());
+        phase_end_[h] = static_cast<uint32_t>(phases_.size());
+        burst_left_[h] = bursts[0];
+        io_total_[h] = io;
+        with_io_++;
+        return true;
+    }
+
+    // true if h has I/O bursts still to come or behind it
+    bool has_io(ProcessHandle h) const { return h < phase_end_.size() && phase_end_[h] != 0; }
+
+    // cpu time left before h's next I/O burst, its remaining time if it has none
+    nanoseconds burst_left(ProcessHandle h) const { return has_io(h) ? burst_left_[h] : remaining_[h]; }
+
+    // total of h's I/O bursts
+    nanoseconds io_time(ProcessHandle h) const { return has_io(h) ? io_total_[h] : 0ns; }
+
+    // h has just used up a cpu burst that isn't its last: it moves on to the next one and
+    // waits on I/O in the meantime. returns how long the I/O takes
+    nanoseconds start_io(ProcessHandle h){
+        uint32_t io = phase_[h] + 1;
+        phase_[h] = io + 1;
+        burst_left_[h] = phases_[io + 1];
+        state_[h] = State::IO_WAIT;
+        return phases_[io];
+    }
+
+    // metrics relating to the process, same definitions as on Process. time spent on I/O
+    // isn't waiting
+    nanoseconds turnaround(ProcessHandle h) const { return completion_[h] - arrival_[h]; }
+    nanoseconds waiting(ProcessHandle h) const { return turnaround(h) - burst_[h] - io_time(h); }
+    nanoseconds response(ProcessHandle h) const { return start_[h] - arrival_[h]; }
+
+    // run h for slice starting at now, the table version of Process::execute_slice.
+    // returns true once the process has no remaining time left
+    bool execute_slice(ProcessHandle h, nanoseconds now, nanoseconds slice){
+        if(state_[h] == State::READY){
+            start_[h] = now;
+            state_[h] = State::RUNNING;
+        } else if(state_[h] == State::BLOCKED || state_[h] == State::IO_WAIT){
+            // resuming a process that was switched out or back from I/O
+            context_switches_[h]++;
+            state_[h] = State::RUNNING;
+        }
+
+        if(Process* p = owner(h)){
+            p->task();
+        }
+
+        nanoseconds left = burst_left(h);
+        slice = slice < left ? slice : left;
+        remaining_[h] -= slice;
+        if(has_io(h)){
+            burst_left_[h] -= slice;
+        }
+        last_run_[h] = now + slice;
+
+        if(remaining_[h] <= 0ns){
+            completion_[h] = now + slice;
+            state_[h] = State::COMPLETED;
+            return true;
+        }
+
+        state_[h] = State::BLOCKED;
+        return false;
+    }
+
+    // copy the scheduler's view back into the caller's Process, if there is one
+    void sync_owner(ProcessHandle h) const {
+        Process* p = owner(h);
+        if(!p){
+            return;
+        }
+        p->remaining_time.store(remaining_[h]);
+        p->start_time.store(start_[h]);
+        p->completion_time.store(completion_[h]);
+        p->last_run_timestamp.store(last_run_[h]);
+        p->context_switches.store(static_cast<int>(context_switches_[h]));
+        p->last_latency.store(start_[h] - arrival_[h]);
+        p->current_state.store(state_[h]);
+    }
+
+    // bytes held by the columns, for checking the footprint of large runs
+    size_t memory_bytes() const {
+        return pid_.capacity() * sizeof(int)
+             + (arrival_.capacity() + burst_.capacity() + remaining_.capacity() + start_.capacity()
+                + completion_.capacity() + last_run_.capacity()) * sizeof(nanoseconds)
+             + context_switches_.capacity() * sizeof(uint32_t)
+             + state_.capacity() * sizeof(State)
+             + nice_.capacity() * sizeof(int8_t)
+             + owners_.capacity() * sizeof(Process*)
+             + tickets_.capacity() * sizeof(uint32_t)
+             + (phase_.capacity() + phase_end_.capacity()) * sizeof(uint32_t)
+             + (burst_left_.capacity() + io_total_.capacity() + phases_.capacity()) * sizeof(nanoseconds)
+             + free_handles_.capacity() * sizeof(ProcessHandle);
+    }
+
+private:
+    std::vector<int> pid_;
+    std::vector<nanoseconds> arrival_;
+    std::vector<nanoseconds> burst_;
+    std::vector<nanoseconds> remaining_;
+    std::vector<nanoseconds> start_;
+    std::vector<nanoseconds> completion_;
+    std::vector<nanoseconds> last_run_;
+    std::vector<uint32_t> context_switches_;
+    std::vector<State> state_;
+    std::vector<int8_t> nice_;
+
+    // sparse, empty unless processes were added with an owning Process
+    std::vector<Process*> owners_;
+    // sparse like owners_, empty unless some process was given tickets of its own
+    std::vector<uint32_t> tickets_;
+
+    // sparse like owners_, empty unless some process has I/O bursts. phases_ holds every
+    // such process's bursts back to back, phase_ is the index of its current cpu burst and
+    // phase_end_ one past its last. phases_ only grows while processes with I/O are live
+    std::vector<uint32_t> phase_;
+    std::vector<uint32_t> phase_end_;
+    std::vector<nanoseconds> burst_left_;
+    std::vector<nanoseconds> io_total_;
+    std::vector<nanoseconds> phases_;
+    size_t with_io_ = 0;
+
+    // released slots waiting to be reused
+    std::vector<ProcessHandle> free_handles_;
+    size_t live_ = 0;
+
+    void clear_bursts(ProcessHandle h){
+        if(has_io(h)){
+            phase_[h] = 0;
+            phase_end_[h] = 0;
+            with_io_--;
+        }
+    }
+};
+
+#endif
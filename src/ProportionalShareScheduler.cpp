@@ -0,0 +1,5 @@
+#include "ProportionalShareScheduler.h"
+
+// the loop itself lives in SimulationEngine.h, compile the lottery and stride flavours once here
+template class SimulationEngine<LotteryReadyQueue, RunToCompletion>;
+template class SimulationEngine<StrideReadyQueue, RunToCompletion>;
@@ -0,0 +1,368 @@
+#ifndef PROPORTIONAL_SHARE_SCHEDULER_H
+#define PROPORTIONAL_SHARE_SCHEDULER_H
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "IndexedHeap.h"
+#include "ProcessTable.h"
+#include "SchedulerStats.h"
+#include "SimulationEngine.h"
+
+using namespace std::chrono;
+
+struct ProportionalShareConfig {
+    // every dispatch runs for at most one quantum before the next draw
+    nanoseconds quantum = 10ns;
+    // lottery only, the same seed draws the same winners
+    uint64_t seed = 1;
+};
+
+// how closely a proportional share policy hands out the CPU by tickets. while a process
+// is runnable (queued or running) it is owed tickets / (tickets of everything runnable)
+// of the CPU, which is tracked with a clock that advances by ran / runnable tickets on
+// every slice: a process is owed its tickets times how far the clock moved while it was
+// runnable. at completion the gap between the CPU it got and the CPU it was owed goes
+// into SchedulerStats::share_error.
+//
+// the ready queues drive it, everything runs on the engine's single thread
+class ShareLedger{
+public:
+    // h became runnable, as a new arrival (owed nothing yet) or back from I/O
+    void join(ProcessHandle h, uint32_t tickets, bool arrival){
+        if(h >= joined_.size()){
+            joined_.resize(static_cast<size_t>(h) + 1, 0.0);
+            owed_.resize(static_cast<size_t>(h) + 1, 0.0);
+        }
+        if(arrival){
+            owed_[h] = 0.0;
+        }
+        joined_[h] = clock_;
+        runnable_ += tickets;
+    }
+
+    // h stopped being runnable, for I/O or because it finished
+    void leave(ProcessHandle h, uint32_t tickets){
+        owed_[h] += tickets * (clock_ - joined_[h]);
+        runnable_ -= tickets;
+    }
+
+    // h finished after getting cpu of CPU in total
+    void complete(ProcessHandle h, uint32_t tickets, nanoseconds cpu){
+        leave(h, tickets);
+        double got = static_cast<double>(cpu.count());
+        error_ += std::abs(got - owed_[h]);
+        cpu_ += got;
+    }
+
+    // the CPU ran for ran with the current runnable set
+    void ran(nanoseconds ran){
+        if(runnable_ > 0){
+            clock_ += static_cast<double>(ran.count()) / static_cast<double>(runnable_);
+        }
+    }
+
+    void report(SchedulerStats& stats) const {
+        stats.share_error += error_;
+        stats.share_cpu += cpu_;
+    }
+
+private:
+    // nanoseconds of CPU owed per ticket so far
+    double clock_ = 0.0;
+    uint64_t runnable_ = 0;
+    double error_ = 0.0;
+    double cpu_ = 0.0;
+    // per handle: the clock when it last became runnable, and the CPU it was owed before that
+    std::vector<double> joined_;
+    std::vector<double> owed_;
+};
+
+// ready queue policy for lottery scheduling: every dispatch draws one of the queued
+// tickets at random and runs the process holding it for a quantum, so over time each
+// process gets the CPU in proportion to its tickets (see ProcessTable::tickets).
+//
+// queued tickets are counted in a Fenwick tree indexed by handle, so queueing, removing
+// and finding the holder of the r-th ticket are all O(log n) however many processes are
+// queued, and the tree is one flat array. the draws come from the queue's own splitmix64
+// stream, so a seed replays the same schedule
+class LotteryReadyQueue{
+public:
+    static constexpr const char* name = "Lottery";
+
+    LotteryReadyQueue(const ProcessTable& table, size_t capacity)
+        : table_(table), capacity_(capacity), rng_(config_.seed) {}
+
+    // also restarts the draws from config.seed
+    void configure(const ProportionalShareConfig& config){
+        config_ = config;
+        rng_ = config.seed;
+    }
+
+    const ProportionalShareConfig& config() const { return config_; }
+
+    bool push(ProcessHandle h){
+        if(size_ >= capacity_){
+            return false;
+        }
+        settle();
+        if(h >= held_.size()){
+            grow(static_cast<size_t>(h) + 1);
+        }
+        uint32_t tickets = table_.tickets(h);
+        if(table_.state(h) != Process::State::BLOCKED){
+            ledger_.join(h, tickets, table_.state(h) == Process::State::READY);
+        }
+        held_[h] = tickets;
+        add(h, tickets);
+        total_ += tickets;
+        size_++;
+        return true;
+    }
+
+    ProcessHandle pop(){
+        if(size_ == 0){
+            return invalid_process_handle;
+        }
+        settle();
+        ProcessHandle h = find(draw(total_));
+        add(h, -static_cast<int64_t>(held_[h]));
+        total_ -= held_[h];
+        held_[h] = 0;
+        size_--;
+        return h;
+    }
+
+    nanoseconds time_slice(ProcessHandle h, nanoseconds now){
+        running_ = h;
+        dispatched_at_ = now;
+        return config_.quantum;
+    }
+
+    // called by the engine when h's slice ends in I/O instead of a push
+    void block(ProcessHandle h){
+        settle();
+        ledger_.leave(h, table_.tickets(h));
+    }
+
+    // called by the engine when h's slice finished it
+    void complete(ProcessHandle h){
+        settle();
+        ledger_.complete(h, table_.tickets(h), table_.burst(h));
+    }
+
+    void report(SchedulerStats& stats) const { ledger_.report(stats); }
+
+    // tickets of the queued processes
+    uint64_t total_tickets() const { return total_; }
+
+    bool empty() const { return size_ == 0; }
+
+    size_t size() const { return size_; }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    const ProcessTable& table_;
+    const size_t capacity_;
+    ProportionalShareConfig config_;
+    size_t size_ = 0;
+    uint64_t total_ = 0;
+    uint64_t rng_;
+
+    // 1-based Fenwick tree over the queued tickets of each handle, its size is a power
+    // of two so a search is one walk down from the top bit
+    std::vector<uint64_t> tree_;
+    // tickets each handle has in the tree, 0 when it isn't queued
+    std::vector<uint32_t> held_;
+
+    ShareLedger ledger_;
+    // dispatched and not yet back, see settle()
+    ProcessHandle running_ = invalid_process_handle;
+    nanoseconds dispatched_at_ = 0ns;
+
+    // the engine writes the end of a slice to last_run before anything else reaches the
+    // queue, so the slice can be accounted the next time the queue is touched
+    void settle(){
+        if(running_ != invalid_process_handle){
+            ledger_.ran(table_.last_run(running_) - dispatched_at_);
+            running_ = invalid_process_handle;
+        }
+    }
+
+    void grow(size_t n){
+        size_t size = std::bit_ceil(std::max<size_t>(n, 2 * held_.size()));
+        held_.resize(size, 0);
+        // rebuild in O(n): every node passes its sum on to its parent
+        tree_.assign(size + 1, 0);
+        for(size_t i = 1; i <= size; ++i){
+            tree_[i] += held_[i - 1];
+            size_t parent = i + (i & (~i + 1));
+            if(parent <= size){
+                tree_[parent] += tree_[i];
+            }
+        }
+    }
+
+    void add(ProcessHandle h, int64_t delta){
+        for(size_t i = static_cast<size_t>(h) + 1; i < tree_.size(); i += i & (~i + 1)){
+            tree_[i] += static_cast<uint64_t>(delta);
+        }
+    }
+
+    // handle holding ticket r, counting the queued tickets in handle order
+    ProcessHandle find(uint64_t r) const {
+        size_t pos = 0;
+        for(size_t step = held_.size(); step > 0; step >>= 1){
+            if(tree_[pos + step] <= r){
+                pos += step;
+                r -= tree_[pos];
+            }
+        }
+        return static_cast<ProcessHandle>(pos);
+    }
+
+    // uniform in [0, bound), by multiplying instead of a biased modulo
+    uint64_t draw(uint64_t bound){
+        rng_ += 0x9e3779b97f4a7c15ull;
+        uint64_t z = rng_;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        z ^= z >> 31;
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(z) * bound) >> 64);
+    }
+};
+
+// ready queue policy for stride scheduling, the deterministic counterpart of the
+// lottery: every process has a pass that advances by the CPU time it gets divided by
+// its tickets, and the lowest pass runs next, so the shares come out exact to within a
+// quantum instead of on average. new arrivals start at the pass of the last process
+// picked, so a late arrival can't claim CPU it missed, and a process back from I/O
+// doesn't bank credit for the time it slept.
+//
+// the passes are kept in an IndexedHeap, O(log n) per push and pop
+class StrideReadyQueue{
+public:
+    static constexpr const char* name = "Stride";
+
+    StrideReadyQueue(const ProcessTable& table, size_t capacity)
+        : table_(table), capacity_(capacity) {}
+
+    void configure(const ProportionalShareConfig& config){ config_ = config; }
+
+    const ProportionalShareConfig& config() const { return config_; }
+
+    bool push(ProcessHandle h){
+        if(size() >= capacity_){
+            return false;
+        }
+        settle();
+        if(h >= pass_.size()){
+            pass_.resize(static_cast<size_t>(h) + 1, 0);
+        }
+        uint32_t tickets = table_.tickets(h);
+        Process::State state = table_.state(h);
+        if(state == Process::State::READY){
+            pass_[h] = global_pass_;
+        } else if(state == Process::State::IO_WAIT){
+            // already charged by block()
+            pass_[h] = std::max(pass_[h], global_pass_);
+        } else {
+            charge(h, tickets);
+        }
+        if(state != Process::State::BLOCKED){
+            ledger_.join(h, tickets, state == Process::State::READY);
+        }
+        heap_.push(h, pass_[h]);
+        return true;
+    }
+
+    ProcessHandle pop(){
+        if(heap_.empty()){
+            return invalid_process_handle;
+        }
+        settle();
+        ProcessHandle h = heap_.pop();
+        global_pass_ = std::max(global_pass_, pass_[h]);
+        return h;
+    }
+
+    nanoseconds time_slice(ProcessHandle h, nanoseconds now){
+        running_ = h;
+        dispatched_at_ = now;
+        return config_.quantum;
+    }
+
+    // called by the engine when h's slice ends in I/O instead of a push
+    void block(ProcessHandle h){
+        settle();
+        uint32_t tickets = table_.tickets(h);
+        charge(h, tickets);
+        ledger_.leave(h, tickets);
+    }
+
+    // called by the engine when h's slice finished it
+    void complete(ProcessHandle h){
+        settle();
+        ledger_.complete(h, table_.tickets(h), table_.burst(h));
+    }
+
+    void report(SchedulerStats& stats) const { ledger_.report(stats); }
+
+    // pass of a process, in nanoseconds of CPU per ticket scaled by stride_scale
+    int64_t pass(ProcessHandle h) const { return pass_[h]; }
+
+    bool empty() const { return heap_.empty(); }
+
+    size_t size() const { return heap_.size(); }
+
+    size_t capacity() const { return capacity_; }
+
+    // a nanosecond of CPU moves a one ticket process's pass by this much, large enough
+    // that every ticket count still moves forward on a 1ns slice
+    static constexpr int64_t stride_scale = int64_t(1) << 20;
+
+private:
+    const ProcessTable& table_;
+    const size_t capacity_;
+    ProportionalShareConfig config_;
+
+    IndexedHeap<int64_t> heap_;
+    std::vector<int64_t> pass_;
+    // pass of the last process picked, what new arrivals start at
+    int64_t global_pass_ = 0;
+
+    ShareLedger ledger_;
+    ProcessHandle running_ = invalid_process_handle;
+    nanoseconds dispatched_at_ = 0ns;
+
+    // see LotteryReadyQueue::settle
+    void settle(){
+        if(running_ != invalid_process_handle){
+            ledger_.ran(table_.last_run(running_) - dispatched_at_);
+            running_ = invalid_process_handle;
+        }
+    }
+
+    // add the slice h just ran to its pass
+    void charge(ProcessHandle h, uint32_t tickets){
+        nanoseconds ran = table_.last_run(h) - dispatched_at_;
+        pass_[h] += ran.count() * stride_scale / tickets;
+    }
+};
+
+// lottery and stride are the shared simulation loop with a proportional share ready
+// queue, which slices every dispatch by ProportionalShareConfig::quantum
+using LotteryScheduler = SimulationEngine<LotteryReadyQueue, RunToCompletion>;
+using StrideScheduler = SimulationEngine<StrideReadyQueue, RunToCompletion>;
+
+// instantiated once in ProportionalShareScheduler.cpp
+extern template class SimulationEngine<LotteryReadyQueue, RunToCompletion>;
+extern template class SimulationEngine<StrideReadyQueue, RunToCompletion>;
+
+#endif
@@ -0,0 +1,237 @@
+#ifndef REAL_EXECUTION_ENGINE_H
+#define REAL_EXECUTION_ENGINE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "EventTracer.h"
+#include "Log.h"
+#include "Process.h"
+#include "ProcessTable.h"
+#include "ArrivalIndex.h"
+#include "SchedulerStats.h"
+#include "WorkStealingPool.h"
+
+using namespace std::chrono;
+
+// the second execution backend: instead of advancing a simulated clock, processes are
+// released at their arrival offset from the start of run() and their tasks really run on
+// a WorkStealingPool. the ready queue policy (FIFO, SJF, ...) still decides the order they
+// are handed to the pool, and at most max_in_flight are handed over at a time so that
+// order actually matters.
+//
+// every latency is wall clock, measured from the moment the process was due to arrive
+// (not from when the dispatcher noticed it) so a slow dispatcher shows up in the tail.
+// a process added without a Process of its own busy-waits for its burst as its task
+template <typename ReadyQueuePolicy>
+class RealExecutionEngine{
+public:
+    // max_in_flight of 0 means two per worker
+    RealExecutionEngine(int workers, int queue_capacity, LatencyMode latency_mode = LatencyMode::Histogram,
+                        size_t max_in_flight = 0)
+        : ready_queue_(processes_, static_cast<size_t>(queue_capacity)),
+          worker_count_(workers > 0 ? static_cast<size_t>(workers) : 1),
+          max_in_flight_(max_in_flight > 0 ? max_in_flight : 2 * worker_count_),
+          latency_mode_(latency_mode),
+          stats_(latency_mode)
+    {
+        SCHED_LOG_INFO(ReadyQueuePolicy::name, " real execution with ", worker_count_,
+                       " workers, ready queue capacity: ", ready_queue_.capacity());
+    }
+
+    // p must outlive run()
+    ProcessHandle add_process(Process* p){
+        if(!p){
+            SCHED_LOG_ERROR("ERROR: Attempted to add null process to arrival index");
+            return invalid_process_handle;
+        }
+        ProcessHandle h = processes_.add(p->pid, p->arrival_time, p->burst_time, p);
+        processes_.set_nice(h, p->nice);
+        arrivals_.add(h, p->arrival_time);
+        return h;
+    }
+
+    ProcessHandle add_process(int pid, nanoseconds arrival, nanoseconds burst, int nice = 0){
+        ProcessHandle h = processes_.add(pid, arrival, burst);
+        processes_.set_nice(h, nice);
+        arrivals_.add(h, arrival);
+        return h;
+    }
+
+    // release every process at its arrival offset and block until all of them have run
+    void run(){
+        size_t total = processes_.size();
+        completed_ = 0;
+        in_flight_ = 0;
+        worker_stats_.assign(worker_count_, SchedulerStats(latency_mode_));
+
+        SCHED_LOG_INFO("Starting ", ReadyQueuePolicy::name, " real execution of ", total, " processes");
+
+        uint64_t steals = 0;
+        {
+            WorkStealingPool<ProcessHandle> pool(worker_count_, max_in_flight_,
+                [this](ProcessHandle h, size_t worker){ execute(h, worker); });
+            // the clock starts once the workers exist, thread start up isn't part of any latency
+            start_ = steady_clock::now();
+
+            while(completed_.load() < total){
+                nanoseconds now = elapsed();
+                admit_arrivals(now);
+
+                // hand over in policy order while there is room in flight
+                while(in_flight_.load() < max_in_flight_ && !ready_queue_.empty()){
+                    ProcessHandle h = ready_queue_.pop();
+                    in_flight_++;
+                    pool.submit(h);
+                }
+
+                wait_for_progress();
+            }
+
+            steals = pool.steals();
+        }
+
+        nanoseconds wall_time = elapsed();
+        for(const SchedulerStats& stats : worker_stats_){
+            stats_.merge(stats);
+        }
+        stats_.total_sim_time = wall_time;
+        steals_ = steals;
+
+        SCHED_LOG_INFO(ReadyQueuePolicy::name, " real execution finished in ", wall_time, "ns, ", steals, " steals");
+    }
+
+    // wall clock latencies, total_sim_time is the wall time of the whole run
+    SchedulerStats get_stats() const { return stats_; }
+
+    // start and completion columns hold wall clock offsets from the start of run()
+    const ProcessTable& get_process_table() const { return processes_; }
+
+    size_t worker_count() const { return worker_count_; }
+
+    // record scheduling events with wall clock times: worker i writes buffer i and the
+    // dispatcher writes buffer worker_count(), so the tracer needs worker_count() + 1
+    // buffers. nullptr turns tracing off. the tracer must outlive run()
+    bool set_tracer(EventTracer* tracer){
+        if(tracer && tracer->buffer_count() < worker_count_ + 1){
+            SCHED_LOG_ERROR("ERROR: Event tracer has ", tracer->buffer_count(), " buffers for ",
+                            worker_count_, " workers and a dispatcher");
+            return false;
+        }
+        tracer_ = tracer;
+        return true;
+    }
+
+    // processes a worker took from another worker during the last run
+    uint64_t steals() const { return steals_; }
+
+private:
+    ProcessTable processes_;
+    ReadyQueuePolicy ready_queue_;
+    ArrivalIndex arrivals_;
+
+    const size_t worker_count_;
+    const size_t max_in_flight_;
+    const LatencyMode latency_mode_;
+
+    steady_clock::time_point start_;
+
+    // each worker records into its own stats, merged once the pool has stopped
+    std::vector<SchedulerStats> worker_stats_;
+    SchedulerStats stats_;
+    uint64_t steals_ = 0;
+
+    EventTracer* tracer_ = nullptr;
+
+    std::atomic<size_t> in_flight_ = 0;
+    std::atomic<size_t> completed_ = 0;
+
+    // the dispatcher sleeps here until a task finishes or the next arrival is due
+    std::mutex progress_mutex_;
+    std::condition_variable progress_cv_;
+
+    nanoseconds elapsed() const {
+        return duration_cast<nanoseconds>(steady_clock::now() - start_);
+    }
+
+    void admit_arrivals(nanoseconds now){
+        while(arrivals_.has_arrival_by(now)){
+            ProcessHandle h = arrivals_.peek();
+            if(!ready_queue_.push(h)){
+                // leave it pending, in flight work will drain the queue
+                trace(worker_count_, SchedEventType::Drop, now, h);
+                break;
+            }
+            arrivals_.pop();
+            trace(worker_count_, SchedEventType::Arrive, processes_.arrival(h), h);
+            trace(worker_count_, SchedEventType::Enqueue, now, h);
+        }
+    }
+
+    void trace(size_t buffer, SchedEventType type, nanoseconds time, ProcessHandle h){
+        if(tracer_){
+            tracer_->record(buffer, type, time, processes_.pid(h));
+        }
+    }
+
+    void wait_for_progress(){
+        // taken first, so a task finishing while we look around still wakes us
+        size_t seen = completed_.load();
+        bool can_dispatch = !ready_queue_.empty() && in_flight_.load() < max_in_flight_;
+        bool arrived = arrivals_.has_arrival_by(elapsed()) && ready_queue_.size() < ready_queue_.capacity();
+        if(can_dispatch || arrived){
+            return;
+        }
+
+        nanoseconds next_arrival = arrivals_.next_arrival();
+        std::unique_lock<std::mutex> lock(progress_mutex_);
+        auto progressed = [this, seen]{ return completed_.load() != seen; };
+        if(next_arrival == nanoseconds::max() || ready_queue_.size() >= ready_queue_.capacity()){
+            progress_cv_.wait(lock, progressed);
+        } else {
+            progress_cv_.wait_until(lock, start_ + next_arrival, progressed);
+        }
+    }
+
+    // runs on a worker thread. each handle is touched by exactly one worker, and the
+    // dispatcher only reads columns that never change, so the table needs no lock
+    void execute(ProcessHandle h, size_t worker){
+        nanoseconds started = elapsed();
+        processes_.start(h) = started;
+        processes_.state(h) = Process::State::RUNNING;
+        trace(worker, SchedEventType::Dispatch, started, h);
+
+        if(Process* p = processes_.owner(h)){
+            p->task();
+        } else {
+            // no task of its own, occupy the worker for the burst
+            auto until = start_ + started + processes_.burst(h);
+            while(steady_clock::now() < until){
+            }
+        }
+
+        nanoseconds finished = elapsed();
+        processes_.completion(h) = finished;
+        processes_.last_run(h) = finished;
+        processes_.remaining(h) = 0ns;
+        processes_.state(h) = Process::State::COMPLETED;
+        processes_.sync_owner(h);
+        trace(worker, SchedEventType::Complete, finished, h);
+        worker_stats_[worker].record_measured_completion(processes_.arrival(h), started, finished);
+
+        in_flight_--;
+        {
+            std::lock_guard<std::mutex> lock(progress_mutex_);
+            completed_++;
+        }
+        progress_cv_.notify_one();
+    }
+};
+
+#endif
@@ -0,0 +1,5 @@
+#include "RealExecutionScheduler.h"
+
+// the dispatcher and worker code lives in RealExecutionEngine.h, compile it once here
+template class RealExecutionEngine<FifoReadyQueue>;
+template class RealExecutionEngine<ShortestJobReadyQueue>;
@@ -0,0 +1,16 @@
+#ifndef REAL_EXECUTION_SCHEDULER_H
+#define REAL_EXECUTION_SCHEDULER_H
+
+#include "RealExecutionEngine.h"
+#include "FCFSScheduler.h"
+#include "SJFScheduler.h"
+
+// FCFS and SJF admission in front of a work-stealing pool that runs the tasks for real
+using RealFCFSExecutor = RealExecutionEngine<FifoReadyQueue>;
+using RealSJFExecutor = RealExecutionEngine<ShortestJobReadyQueue>;
+
+// instantiated once in RealExecutionScheduler.cpp
+extern template class RealExecutionEngine<FifoReadyQueue>;
+extern template class RealExecutionEngine<ShortestJobReadyQueue>;
+
+#endif
@@ -0,0 +1,240 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// keep producer and consumer indices on separate lines so they don't false share
+inline constexpr std::size_t cache_line_size = 64;
+
+// round a requested capacity up to a power of two so wrap-around is a mask instead of a %
+inline std::size_t ring_capacity_for(std::size_t requested){
+    std::size_t capacity = 2;
+    while(capacity < requested){
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+// lock-free queue for exactly one producer thread and one consumer thread
+template <typename T>
+class SPSCRingBuffer{
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    std::unique_ptr<T[]> slots_;
+
+    // written by the consumer, cached copy of tail to avoid touching the producer's line
+    alignas(cache_line_size) std::atomic<std::size_t> head_{0};
+    std::size_t cached_tail_ = 0;
+
+    // written by the producer, cached copy of head to avoid touching the consumer's line
+    alignas(cache_line_size) std::atomic<std::size_t> tail_{0};
+    std::size_t cached_head_ = 0;
+
+public:
+    explicit SPSCRingBuffer(std::size_t capacity)
+        : capacity_(ring_capacity_for(capacity)), mask_(capacity_ - 1), slots_(new T[capacity_]) {}
+
+    std::size_t capacity() const { return capacity_; }
+
+    // approximate unless called from the producer or consumer thread
+    std::size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+
+    bool full() const { return size() == capacity_; }
+
+    bool enqueue(const T& item){
+        return enqueue_n(&item, 1) == 1;
+    }
+
+    // enqueue up to n items, returns how many fit
+    std::size_t enqueue_n(const T* items, std::size_t n){
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if(capacity_ - (tail - cached_head_) < n){
+            cached_head_ = head_.load(std::memory_order_acquire);
+        }
+
+        std::size_t free_slots = capacity_ - (tail - cached_head_);
+        std::size_t count = n < free_slots ? n : free_slots;
+        for(std::size_t i = 0; i < count; ++i){
+            slots_[(tail + i) & mask_] = items[i];
+        }
+
+        if(count > 0){
+            tail_.store(tail + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    bool dequeue(T& out){
+        return dequeue_n(&out, 1) == 1;
+    }
+
+    // dequeue up to n items into out, returns how many were taken
+    std::size_t dequeue_n(T* out, std::size_t n){
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if(cached_tail_ - head < n){
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+        }
+
+        std::size_t available = cached_tail_ - head;
+        std::size_t count = n < available ? n : available;
+        for(std::size_t i = 0; i < count; ++i){
+            out[i] = slots_[(head + i) & mask_];
+        }
+
+        if(count > 0){
+            head_.store(head + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // consumer only, nullptr if empty
+    const T* peek(){
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if(cached_tail_ == head){
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if(cached_tail_ == head){
+                return nullptr;
+            }
+        }
+        return &slots_[head & mask_];
+    }
+};
+
+// bounded lock-free queue for any number of producers and consumers. every slot
+// carries a sequence number that says whether it is free or holds an item for
+// the current lap, so producers and consumers only contend on their own index
+template <typename T>
+class MPMCRingBuffer{
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        T item;
+    };
+
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    alignas(cache_line_size) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(cache_line_size) std::atomic<std::size_t> dequeue_pos_{0};
+
+public:
+    explicit MPMCRingBuffer(std::size_t capacity)
+        : capacity_(ring_capacity_for(capacity)), mask_(capacity_ - 1), slots_(new Slot[capacity_]) {
+        for(std::size_t i = 0; i < capacity_; ++i){
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t capacity() const { return capacity_; }
+
+    // snapshot, may be stale by the time it is used if other threads are active
+    std::size_t size() const {
+        std::size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+        std::size_t head = dequeue_pos_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    bool full() const { return size() >= capacity_; }
+
+    bool enqueue(const T& item){
+        return enqueue_n(&item, 1) == 1;
+    }
+
+    // claims a run of consecutive free slots with a single CAS, returns how many items were enqueued
+    std::size_t enqueue_n(const T* items, std::size_t n){
+        if(n == 0){
+            return 0;
+        }
+
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        std::size_t count;
+        for(;;){
+            count = 0;
+            while(count < n){
+                std::size_t seq = slots_[(pos + count) & mask_].sequence.load(std::memory_order_acquire);
+                if(seq != pos + count){
+                    break;
+                }
+                count++;
+            }
+
+            if(count == 0){
+                std::size_t seq = slots_[pos & mask_].sequence.load(std::memory_order_acquire);
+                if(seq < pos){
+                    // slot still holds an item from the previous lap, queue is full
+                    return 0;
+                }
+                // another producer got here first
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if(enqueue_pos_.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)){
+                break;
+            }
+        }
+
+        for(std::size_t i = 0; i < count; ++i){
+            Slot& slot = slots_[(pos + i) & mask_];
+            slot.item = items[i];
+            slot.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+    bool dequeue(T& out){
+        return dequeue_n(&out, 1) == 1;
+    }
+
+    // claims a run of consecutive filled slots with a single CAS, returns how many items were taken
+    std::size_t dequeue_n(T* out, std::size_t n){
+        if(n == 0){
+            return 0;
+        }
+
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        std::size_t count;
+        for(;;){
+            count = 0;
+            while(count < n){
+                std::size_t seq = slots_[(pos + count) & mask_].sequence.load(std::memory_order_acquire);
+                if(seq != pos + count + 1){
+                    break;
+                }
+                count++;
+            }
+
+            if(count == 0){
+                std::size_t seq = slots_[pos & mask_].sequence.load(std::memory_order_acquire);
+                if(seq < pos + 1){
+                    // nothing published at the head yet, queue is empty
+                    return 0;
+                }
+                // another consumer got here first
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if(dequeue_pos_.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)){
+                break;
+            }
+        }
+
+        for(std::size_t i = 0; i < count; ++i){
+            Slot& slot = slots_[(pos + i) & mask_];
+            out[i] = slot.item;
+            slot.sequence.store(pos + i + capacity_, std::memory_order_release);
+        }
+        return count;
+    }
+};
+
+#endif
@@ -0,0 +1,4 @@
+#include "RoundRobinScheduler.h"
+
+// the loop itself lives in SimulationEngine.h, compile the round robin flavour once here
+template class SimulationEngine<FifoReadyQueue, FixedQuantum>;
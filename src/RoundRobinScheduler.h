@@ -0,0 +1,33 @@
+#ifndef ROUND_ROBIN_SCHEDULER_H
+#define ROUND_ROBIN_SCHEDULER_H
+
+#include <chrono>
+
+#include "ProcessTable.h"
+#include "FCFSScheduler.h"
+#include "SimulationEngine.h"
+
+using namespace std::chrono;
+
+// ClockPolicy that gives every dispatch at most one quantum, the clock moves by
+// min(quantum, remaining) in a single step however long the burst is
+struct FixedQuantum {
+    static constexpr const char* name = "RoundRobin";
+
+    nanoseconds quantum = 10ns;
+
+    nanoseconds slice(const ProcessTable& table, ProcessHandle h, nanoseconds /*now*/, nanoseconds /*next_arrival*/) const {
+        nanoseconds remaining = table.remaining(h);
+        return quantum < remaining ? quantum : remaining;
+    }
+};
+
+// round robin is the FIFO ready queue with quantum slicing, a preempted process goes
+// to the back of the queue behind anything that arrived during its slice.
+// e.g. RoundRobinScheduler rr(capacity, LatencyMode::Histogram, FixedQuantum{20ns});
+using RoundRobinScheduler = SimulationEngine<FifoReadyQueue, FixedQuantum>;
+
+// instantiated once in RoundRobinScheduler.cpp
+extern template class SimulationEngine<FifoReadyQueue, FixedQuantum>;
+
+#endif
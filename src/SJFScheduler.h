@@ -2,77 +2,67 @@
 #define SJF_SCHEDULER_H
 
 #include <chrono>
-#include <iostream>
-#include <mutex>
+#include <cstddef>
 #include <vector>
-#include <queue>    
-#include <atomic>   
-#include <set>      
 
 #include "Process.h" 
-#include "SchedulerStats.h"
+#include "ProcessTable.h"
+#include "IndexedHeap.h"
+#include "SimulationEngine.h"
 
 using namespace std::chrono;
 
-// sort based on remaining time
-struct ProcessComparator {
-    bool operator()(const Process* a, const Process* b) const {
-        return a->remaining_time.load() > b->remaining_time.load();
-    }
-};
-
-class SJFScheduler{
+// ready queue policy for shortest job first: the process with the least remaining time
+// runs next. the remaining time is copied into the heap on push (it can't change while a
+// process waits), so sifts never touch the table
+class ShortestJobReadyQueue{
 public:
-    explicit SJFScheduler(int queue_capacity);
+    static constexpr const char* name = "SJF";
 
-    // add a process to the "ready" queue
-    void add_process(Process* p);
+    ShortestJobReadyQueue(const ProcessTable& table, size_t capacity)
+        : table_(table), capacity_(capacity) {}
 
-    // get the next ready process
-    Process* get_next_process();
-
-    // begin the simulation
-    void run_simulation();
-
-    // record current performance metrics
-    SchedulerStats get_stats() const;
+    bool push(ProcessHandle h){
+        // Check if there's space in the ready queue
+        if(queue_.size() >= capacity_){
+            return false;
+        }
+        return queue_.push(h, table_.remaining(h));
+    }
 
-    // helper
-    bool is_simulation_complete();
-private:
-    // ready priority queue for tasks - now uses the custom comparator
-    std::priority_queue<Process*, std::vector<Process*>, ProcessComparator> ready_queue_;
+    ProcessHandle pop(){
+        // get and remove next process
+        return queue_.pop();
+    }
 
-    // mutex to make the task queue thread-safe
-    mutable std::mutex scheduler_mutex_;
+    bool contains(ProcessHandle h) const { return queue_.contains(h); }
 
-    // track current time in the simulation
-    std::chrono::nanoseconds current_sim_time_ = 0ns;
+    // re-read the remaining time of a queued process after it was changed in the table
+    bool update(ProcessHandle h){ return queue_.update(h, table_.remaining(h)); }
 
-    // just to keep track of all stats after simulation
-    std::vector<Process*> all_processes_;
+    // take a queued process out, e.g. when it is cancelled
+    bool erase(ProcessHandle h){ return queue_.erase(h); }
 
-    // object to store metrics in
-    SchedulerStats stats_;
+    bool empty() const { return queue_.empty(); }
 
-    // is simulation still running or has it completed
-    std::atomic<bool> simulation_active_ = false;
+    size_t size() const { return queue_.size(); }
 
-    // Member to store the maximum capacity of the ready queue
-    const int queue_capacity_;
+    size_t capacity() const { return capacity_; }
 
-    // NEW: Set to keep track of PIDs for which stats have already been updated
-    std::set<int> pids_with_updated_stats_;
+private:
+    const ProcessTable& table_;
 
-    // let process run
-    void dispatch_process(Process* p);
+    // ready priority queue for tasks, keyed by remaining time
+    IndexedHeap<nanoseconds> queue_;
 
-    // retrieve all the processes who would have arrived at current simulation time
-    void handle_new_arrivals();
+    // maximum capacity of the ready queue
+    const size_t capacity_;
+};
 
-    bool all_processes_finished();
+// SJF is the shared simulation loop with a shortest-remaining-time heap, each process runs to completion
+using SJFScheduler = SimulationEngine<ShortestJobReadyQueue, RunToCompletion>;
 
-    void update_stats_for_completed_processes();
-};
+// instantiated once in SJFScheduler.cpp
+extern template class SimulationEngine<ShortestJobReadyQueue, RunToCompletion>;
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,4 @@
+#include "SRTFScheduler.h"
+
+// the loop itself lives in SimulationEngine.h, compile the SRTF flavour once here
+template class SimulationEngine<ShortestJobReadyQueue, PreemptOnArrival>;
@@ -0,0 +1,33 @@
+#ifndef SRTF_SCHEDULER_H
+#define SRTF_SCHEDULER_H
+
+#include <chrono>
+
+#include "ProcessTable.h"
+#include "SJFScheduler.h"
+#include "SimulationEngine.h"
+
+using namespace std::chrono;
+
+// ClockPolicy that runs a process until it finishes or the next process arrives,
+// whichever comes first, so a shorter arrival can take the CPU away from it
+struct PreemptOnArrival {
+    static constexpr const char* name = "SRTF";
+
+    nanoseconds slice(const ProcessTable& table, ProcessHandle h, nanoseconds now, nanoseconds next_arrival) const {
+        nanoseconds remaining = table.remaining(h);
+        if(next_arrival <= now || next_arrival - now >= remaining){
+            return remaining;
+        }
+        return next_arrival - now;
+    }
+};
+
+// shortest remaining time first is the SJF heap sliced at every arrival. when the
+// running process is still the shortest it simply continues without a context switch
+using SRTFScheduler = SimulationEngine<ShortestJobReadyQueue, PreemptOnArrival>;
+
+// instantiated once in SRTFScheduler.cpp
+extern template class SimulationEngine<ShortestJobReadyQueue, PreemptOnArrival>;
+
+#endif
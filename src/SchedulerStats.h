@@ -1,59 +1,355 @@
+#ifndef SCHEDULER_STATS_H
+#define SCHEDULER_STATS_H
+
+#include <array>
 #include <chrono>
+#include <iostream>
 #include <vector>
 #include <numeric>
 #include <algorithm>
 #include <cmath>
 
+#include "ProcessTable.h"
+#include "LatencyHistogram.h"
+
 using namespace std::chrono;
 
 struct SchedulerStats {
     nanoseconds total_sim_time = 0ns;
     nanoseconds total_cpu_burst_time = 0ns;
 
-    std::vector<nanoseconds> turnaround_times;
-    std::vector<nanoseconds> waiting_times;
-    std::vector<nanoseconds> response_times;
-    std::vector<nanoseconds> context_switch_latencies;
+    // bounded histograms by default, LatencyMode::Exact keeps every sample
+    LatencyDistribution turnaround_times;
+    LatencyDistribution waiting_times;
+    LatencyDistribution response_times;
+    LatencyDistribution context_switch_latencies;
+    // start to completion, the time a process actually held the CPU (plus any preemptions)
+    LatencyDistribution service_times;
 
     int total_processes_completed = 0;
     int total_context_switches = 0;
 
-    void add_process_stats(const Process* p){
+    // per-core figures from the multi-core engine, empty for single core runs
+    std::vector<nanoseconds> core_busy_times;
+    // processes each core stole from another core's ready queue
+    std::vector<int> core_migrations;
+    int total_migrations = 0;
+
+    // from priority policies (MLFQ), empty and zero for the others.
+    // dispatches at each priority level, level 0 is the highest
+    std::vector<int64_t> level_dispatches;
+    int64_t demotions = 0;
+    int64_t priority_boosts = 0;
+    // longest single stretch a process spent in a ready queue, and how many dispatches
+    // came after a wait longer than the policy's starvation threshold
+    nanoseconds max_ready_wait = 0ns;
+    int64_t starved_dispatches = 0;
+    // processes that finished without ever dropping below the top level
+    int64_t interactive_completions = 0;
+
+    // fairness, recorded for every policy so weighted and unweighted ones can be compared.
+    // a process's service rate is burst / turnaround, the fraction of its time in the
+    // system it spent on the CPU, and dividing by its weight gives its rate per unit of
+    // share. jain's index over those is 1 when every process got exactly its share
+    double weighted_rate_sum = 0.0;
+    double weighted_rate_squares = 0.0;
+    int64_t weighted_rate_count = 0;
+    // per nice level (index nice - min_nice): completions, cpu time and summed service rate
+    static constexpr size_t nice_levels = max_nice - min_nice + 1;
+    std::array<int64_t, nice_levels> nice_completions{};
+    std::array<nanoseconds, nice_levels> nice_cpu_time{};
+    std::array<double, nice_levels> nice_rate_sum{};
+
+    // admission: arrivals that went straight into the ready queue, arrivals that found it
+    // full and waited in the backlog, and processes the admission policy turned away.
+    // every added process ends up admitted or shed, a deferred one usually both
+    int64_t admitted = 0;
+    int64_t deferred = 0;
+    int64_t shed = 0;
+    size_t max_backlog_depth = 0;
+    // backlog depth integrated over simulated time, i.e. the total time processes spent
+    // waiting in the backlog
+    nanoseconds backlog_time = 0ns;
+
+    // I/O, zero unless processes have I/O bursts. io_time adds up every I/O wait,
+    // io_busy_time is the time at least one process was waiting on I/O, and
+    // cpu_io_overlap the part of that during which the CPU was running something
+    int64_t io_bursts = 0;
+    nanoseconds io_time = 0ns;
+    nanoseconds io_busy_time = 0ns;
+    nanoseconds cpu_io_overlap = 0ns;
+
+    // online runs: processes taken in from the intake, the run's wall clock time, and how
+    // long each submitted process took on the wall clock from submit() to its first dispatch
+    int64_t submitted = 0;
+    nanoseconds online_wall_time = 0ns;
+    LatencyDistribution submit_latencies;
+
+    // proportional share (lottery, stride): while runnable, a process is owed its tickets'
+    // fraction of the CPU among everything runnable. share_error adds up |cpu it got - cpu
+    // it was owed| over the completed processes, share_cpu the cpu they got
+    double share_error = 0.0;
+    double share_cpu = 0.0;
+
+    explicit SchedulerStats(LatencyMode latency_mode = LatencyMode::Histogram)
+        : turnaround_times(latency_mode), waiting_times(latency_mode),
+          response_times(latency_mode), context_switch_latencies(latency_mode),
+          service_times(latency_mode), submit_latencies(latency_mode) {}
+
+    void add_process_stats(const ProcessTable& table, ProcessHandle h){
         // make sure the process is completed first
-        if (p->current_state.load() == Process::State::COMPLETED) {
-            turnaround_times.push_back(p->get_turnaround_time());
-            waiting_times.push_back(p->get_waiting_time());
-            response_times.push_back(p->get_response_time());
-            total_cpu_burst_time += p->burst_time;
+        if (table.state(h) == Process::State::COMPLETED) {
+            turnaround_times.record(table.turnaround(h));
+            waiting_times.record(table.waiting(h));
+            response_times.record(table.response(h));
+            service_times.record(table.completion(h) - table.start(h));
+            total_cpu_burst_time += table.burst(h);
+            // time on I/O is time it didn't want the CPU, so it doesn't count against its share
+            record_share(table.nice(h), table.burst(h), table.turnaround(h) - table.io_time(h));
         }
-        total_context_switches += p->context_switches.load();
+        total_context_switches += static_cast<int>(table.context_switches(h));
+    }
+
+    // completion event, called once per process when it finishes so stats stay O(1) per completion
+    void record_completion(const ProcessTable& table, ProcessHandle h){
+        total_processes_completed++;
+        add_process_stats(table, h);
+    }
+
+    // completion timed on a real clock rather than simulated. a task runs to completion
+    // once started, so waiting and response are both arrival to start
+    void record_measured_completion(nanoseconds arrival, nanoseconds start, nanoseconds completion){
+        total_processes_completed++;
+        turnaround_times.record(completion - arrival);
+        waiting_times.record(start - arrival);
+        response_times.record(start - arrival);
+        service_times.record(completion - start);
+        total_cpu_burst_time += completion - start;
+        record_share(0, completion - start, completion - arrival);
     }
     
-    // returns the item at the given percentile
-    nanoseconds calculate_percentile(const std::vector<nanoseconds>& data, double percentile) const {
-        if(data.empty()) return 0ns;
 
-        std::vector<nanoseconds> sorted_data = data;
-        std::sort(sorted_data.begin(), sorted_data.end());
-        size_t index = static_cast<size_t>(ceil(percentile / 100.0 * sorted_data.size())) - 1;
+    // fold in the stats of another run, e.g. from a parallel sweep
+    void merge(const SchedulerStats& other){
+        total_sim_time += other.total_sim_time;
+        total_cpu_burst_time += other.total_cpu_burst_time;
+        turnaround_times.merge(other.turnaround_times);
+        waiting_times.merge(other.waiting_times);
+        response_times.merge(other.response_times);
+        context_switch_latencies.merge(other.context_switch_latencies);
+        service_times.merge(other.service_times);
+        total_processes_completed += other.total_processes_completed;
+        total_context_switches += other.total_context_switches;
+
+        if(other.core_busy_times.size() > core_busy_times.size()){
+            core_busy_times.resize(other.core_busy_times.size(), 0ns);
+            core_migrations.resize(other.core_busy_times.size(), 0);
+        }
+        for(size_t core = 0; core < other.core_busy_times.size(); ++core){
+            core_busy_times[core] += other.core_busy_times[core];
+            core_migrations[core] += other.core_migrations[core];
+        }
+        total_migrations += other.total_migrations;
+
+        if(other.level_dispatches.size() > level_dispatches.size()){
+            level_dispatches.resize(other.level_dispatches.size(), 0);
+        }
+        for(size_t level = 0; level < other.level_dispatches.size(); ++level){
+            level_dispatches[level] += other.level_dispatches[level];
+        }
+        demotions += other.demotions;
+        priority_boosts += other.priority_boosts;
+        max_ready_wait = std::max(max_ready_wait, other.max_ready_wait);
+        starved_dispatches += other.starved_dispatches;
+        interactive_completions += other.interactive_completions;
+
+        weighted_rate_sum += other.weighted_rate_sum;
+        weighted_rate_squares += other.weighted_rate_squares;
+        weighted_rate_count += other.weighted_rate_count;
+        for(size_t level = 0; level < nice_levels; ++level){
+            nice_completions[level] += other.nice_completions[level];
+            nice_cpu_time[level] += other.nice_cpu_time[level];
+            nice_rate_sum[level] += other.nice_rate_sum[level];
+        }
+
+        admitted += other.admitted;
+        deferred += other.deferred;
+        shed += other.shed;
+        max_backlog_depth = std::max(max_backlog_depth, other.max_backlog_depth);
+        backlog_time += other.backlog_time;
+
+        io_bursts += other.io_bursts;
+        io_time += other.io_time;
+        io_busy_time += other.io_busy_time;
+        cpu_io_overlap += other.cpu_io_overlap;
+
+        submitted += other.submitted;
+        online_wall_time += other.online_wall_time;
+        submit_latencies.merge(other.submit_latencies);
+        share_error += other.share_error;
+        share_cpu += other.share_cpu;
+    }
+
+    // jain's fairness index of the weighted service rates, from 1/n (one process got
+    // everything) to 1 (perfectly proportional)
+    double jains_index() const {
+        if(weighted_rate_count == 0 || weighted_rate_squares == 0.0) return 1.0;
+        return weighted_rate_sum * weighted_rate_sum / (weighted_rate_count * weighted_rate_squares);
+    }
+
+    // fraction of all cpu time that went to processes at this nice level
+    double cpu_share(int nice) const {
+        if(total_cpu_burst_time.count() == 0) return 0.0;
+        return static_cast<double>(nice_cpu_time[clamp_nice(nice) - min_nice].count()) / total_cpu_burst_time.count();
+    }
 
-        return sorted_data[index];
+    // mean service rate of the processes at this nice level
+    double mean_service_rate(int nice) const {
+        size_t level = clamp_nice(nice) - min_nice;
+        if(nice_completions[level] == 0) return 0.0;
+        return nice_rate_sum[level] / nice_completions[level];
+    }
+
+    // time averaged number of processes waiting in the backlog
+    double mean_backlog_depth() const {
+        if(total_sim_time.count() == 0) return 0.0;
+        return static_cast<double>(backlog_time.count()) / total_sim_time.count();
+    }
+
+    // fraction of the simulated time with I/O outstanding
+    double io_utilization() const {
+        if(total_sim_time.count() == 0) return 0.0;
+        return static_cast<double>(io_busy_time.count()) / total_sim_time.count();
+    }
+
+    // fraction of the time with I/O outstanding that the CPU was kept busy anyway
+    double io_overlap() const {
+        if(io_busy_time.count() == 0) return 0.0;
+        return static_cast<double>(cpu_io_overlap.count()) / io_busy_time.count();
+    }
+
+    // submissions taken in per second of wall clock time, over the whole online run
+    double submission_rate() const {
+        if(online_wall_time.count() == 0) return 0.0;
+        return submitted * 1e9 / online_wall_time.count();
+    }
+
+    // fraction of the cpu time that went to the wrong process, 0 for exact proportional share
+    double share_accuracy_error() const {
+        if(share_cpu == 0.0) return 0.0;
+        return share_error / share_cpu;
+    }
+
+    size_t core_count() const {
+        return core_busy_times.empty() ? 1 : core_busy_times.size();
+    }
+
+    // fraction of the simulated time the core spent running processes
+    double core_utilization(size_t core) const {
+        if(total_sim_time.count() == 0 || core >= core_busy_times.size()) return 0.0;
+        return static_cast<double>(core_busy_times[core].count()) / total_sim_time.count();
+    }
+
+    // busiest core's load over the mean load, minus one. 0 is perfectly balanced,
+    // 1 means the busiest core did twice the average work
+    double load_imbalance() const {
+        if(core_busy_times.empty()) return 0.0;
+        long double total = 0;
+        nanoseconds busiest = 0ns;
+        for(nanoseconds busy : core_busy_times){
+            total += busy.count();
+            busiest = std::max(busiest, busy);
+        }
+        if(total == 0) return 0.0;
+        long double mean = total / core_busy_times.size();
+        return static_cast<double>(busiest.count() / mean - 1.0);
+    }
+    
+    // returns the item at the given percentile, no sorting in histogram mode
+    nanoseconds calculate_percentile(const LatencyDistribution& data, double percentile) const {
+        return data.percentile(percentile);
     }
 
     void print() const {
-        std::cout << "Avg Turnaround: " << calculate_average(turnaround_times) << "ns\n";
-        std::cout << "P99 Turnaround: " << calculate_percentile(turnaround_times, 99.0) << "ns\n";
-        std::cout << "Avg Waiting: " << calculate_average(waiting_times) << "ns\n";
-        std::cout << "P99 Waiting: " << calculate_percentile(waiting_times, 99.0) << "ns\n";
-        std::cout << "Avg Response: " << calculate_average(response_times) << "ns\n";
-        std::cout << "P99 Response: " << calculate_percentile(response_times, 99.0) << "ns\n";
+        std::cout << "Avg Turnaround: " << calculate_average(turnaround_times).count() << "ns\n";
+        std::cout << "P99 Turnaround: " << calculate_percentile(turnaround_times, 99.0).count() << "ns\n";
+        std::cout << "Avg Waiting: " << calculate_average(waiting_times).count() << "ns\n";
+        std::cout << "P99 Waiting: " << calculate_percentile(waiting_times, 99.0).count() << "ns\n";
+        std::cout << "Avg Response: " << calculate_average(response_times).count() << "ns\n";
+        std::cout << "P99 Response: " << calculate_percentile(response_times, 99.0).count() << "ns\n";
+        std::cout << "Avg Service: " << calculate_average(service_times).count() << "ns\n";
+        std::cout << "P99 Service: " << calculate_percentile(service_times, 99.0).count() << "ns\n";
         std::cout << "Total Context Switches: " << total_context_switches << "\n";
-        std::cout << "CPU Utilization: " << (static_cast<double>(total_cpu_burst_time.count()) / total_sim_time.count()) * 100.0 << "%\n";
+        std::cout << "CPU Utilization: " << (static_cast<double>(total_cpu_burst_time.count()) / (total_sim_time.count() * core_count())) * 100.0 << "%\n";
+        if(!core_busy_times.empty()){
+            for(size_t core = 0; core < core_busy_times.size(); ++core){
+                std::cout << "  Core " << core << ": " << core_utilization(core) * 100.0 << "% busy, "
+                          << core_migrations[core] << " migrations\n";
+            }
+            std::cout << "Total Migrations: " << total_migrations << "\n";
+            std::cout << "Load Imbalance: " << load_imbalance() * 100.0 << "%\n";
+        }
+        if(!level_dispatches.empty()){
+            for(size_t level = 0; level < level_dispatches.size(); ++level){
+                if(level_dispatches[level] > 0){
+                    std::cout << "  Level " << level << ": " << level_dispatches[level] << " dispatches\n";
+                }
+            }
+            std::cout << "Demotions: " << demotions << "\n";
+            std::cout << "Priority Boosts: " << priority_boosts << "\n";
+            std::cout << "Max Ready Wait: " << max_ready_wait.count() << "ns\n";
+            std::cout << "Starved Dispatches: " << starved_dispatches << "\n";
+            std::cout << "Interactive Completions: " << interactive_completions << "\n";
+        }
+        if(deferred > 0 || shed > 0){
+            std::cout << "Admitted: " << admitted << ", Deferred: " << deferred << ", Shed: " << shed << "\n";
+            std::cout << "Backlog Depth: " << mean_backlog_depth() << " mean, " << max_backlog_depth << " max\n";
+        }
+        if(io_bursts > 0){
+            std::cout << "I/O Bursts: " << io_bursts << ", " << io_time.count() << "ns in total\n";
+            std::cout << "I/O Utilization: " << io_utilization() * 100.0 << "%\n";
+            std::cout << "CPU/I/O Overlap: " << io_overlap() * 100.0 << "% of I/O time\n";
+        }
+        if(submitted > 0){
+            std::cout << "Submitted: " << submitted << " in " << online_wall_time.count() << "ns wall, "
+                      << submission_rate() << "/s\n";
+            std::cout << "Avg Submit to Dispatch: " << calculate_average(submit_latencies).count() << "ns\n";
+            std::cout << "P99 Submit to Dispatch: " << calculate_percentile(submit_latencies, 99.0).count() << "ns\n";
+        }
+        if(share_cpu > 0.0){
+            std::cout << "Share Accuracy Error: " << share_accuracy_error() * 100.0 << "% of cpu time\n";
+        }
+        std::cout << "Jain's Fairness Index: " << jains_index() << "\n";
+        // the per level breakdown only says something when there is more than one level
+        if(std::count_if(nice_completions.begin(), nice_completions.end(), [](int64_t n){ return n > 0; }) > 1){
+            for(size_t level = 0; level < nice_levels; ++level){
+                if(nice_completions[level] > 0){
+                    int nice = static_cast<int>(level) + min_nice;
+                    std::cout << "  Nice " << nice << ": " << nice_completions[level] << " processes, "
+                              << cpu_share(nice) * 100.0 << "% of cpu, mean service rate "
+                              << mean_service_rate(nice) << "\n";
+                }
+            }
+        }
     }
 
 private:
-    nanoseconds calculate_average(const std::vector<nanoseconds>& data) const {
-        if(data.empty()) return 0ns;
-        return std::accumulate(data.begin(), data.end(), 0ns) / data.size();
+    nanoseconds calculate_average(const LatencyDistribution& data) const {
+        return data.mean();
     }
-};
\ No newline at end of file
+
+    void record_share(int nice, nanoseconds cpu, nanoseconds turnaround){
+        if(turnaround <= 0ns) return;
+        size_t level = clamp_nice(nice) - min_nice;
+        double rate = static_cast<double>(cpu.count()) / turnaround.count();
+        double weighted = rate * nice_0_weight / nice_weight(nice);
+        weighted_rate_sum += weighted;
+        weighted_rate_squares += weighted * weighted;
+        weighted_rate_count++;
+        nice_completions[level]++;
+        nice_cpu_time[level] += cpu;
+        nice_rate_sum[level] += rate;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,706 @@
+#ifndef SIMULATION_ENGINE_H
+#define SIMULATION_ENGINE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "Admission.h"
+#include "EventTracer.h"
+#include "Log.h"
+#include "PhaseProfiler.h"
+#include "Process.h"
+#include "ProcessTable.h"
+#include "ArrivalIndex.h"
+#include "SchedulerStats.h"
+#include "SubmissionQueue.h"
+#include "Telemetry.h"
+#include "TimingWheel.h"
+
+using namespace std::chrono;
+
+// ClockPolicy that lets every dispatched process run until it is done. clock policies
+// that return less than the remaining time make the engine preemptive: the process
+// goes back into the ready queue and the clock moves by the whole slice in one step
+struct RunToCompletion {
+    nanoseconds slice(const ProcessTable& table, ProcessHandle h, nanoseconds /*now*/, nanoseconds /*next_arrival*/) const {
+        return table.remaining(h);
+    }
+};
+
+// what a scheduler logs itself as: the clock policy's name when it has one, since round
+// robin and SRTF reuse the FCFS and SJF ready queues, otherwise the ready queue's
+template <typename ReadyQueuePolicy, typename ClockPolicy>
+constexpr const char* scheduler_name(){
+    if constexpr(requires { ClockPolicy::name; }){
+        return ClockPolicy::name;
+    } else {
+        return ReadyQueuePolicy::name;
+    }
+}
+
+// the simulation loop shared by every scheduler: admit arrivals and I/O wakeups, pick,
+// dispatch, record stats and skip the clock when idle. the ready queue and clock
+// behaviour are template policies, so the per-dispatch path has no virtual calls.
+//
+// a process whose cpu burst ends before its last waits on I/O in a TimingWheel, and
+// comes back through the ready queue once it is done.
+//
+// run_simulation() plays a workload added up front and returns when it is done.
+// run_online() also takes processes submitted from other threads while it runs, and only
+// returns once shutdown() is called and everything submitted before it has finished.
+//
+// ReadyQueuePolicy is constructed from (ProcessTable&, capacity) and provides
+//     bool push(ProcessHandle)       false if the queue is full
+//     ProcessHandle pop()            invalid_process_handle if empty
+//     bool empty() const, size_t size() const, size_t capacity() const
+//     static constexpr const char* name
+// and optionally, for policies that keep time slices and metrics of their own (MLFQ)
+//     nanoseconds time_slice(ProcessHandle, nanoseconds now)   caps each slice, called once per dispatch
+//     void report(SchedulerStats&) const                        adds its metrics at the end of a run
+//     void block(ProcessHandle)                                  h left the CPU for I/O rather than the queue
+//     void complete(ProcessHandle)                               h left the CPU finished
+// ClockPolicy provides
+//     nanoseconds slice(const ProcessTable&, ProcessHandle, nanoseconds now, nanoseconds next_arrival) const
+// and optionally static constexpr const char* name, see scheduler_name
+template <typename ReadyQueuePolicy, typename ClockPolicy = RunToCompletion>
+class SimulationEngine{
+public:
+    static constexpr const char* name = scheduler_name<ReadyQueuePolicy, ClockPolicy>();
+
+    // latency_mode picks bounded histograms (default) or exact per-process samples for the stats
+    explicit SimulationEngine(int queue_capacity, LatencyMode latency_mode = LatencyMode::Histogram,
+                              ClockPolicy clock = ClockPolicy{})
+        : ready_queue_(processes_, static_cast<size_t>(queue_capacity)),
+          clock_(clock),
+          stats_(latency_mode)
+    {
+        SCHED_LOG_INFO(name, "Scheduler ready queue initialized with capacity: ",
+                       ready_queue_.capacity(), " (requested ", queue_capacity, ")");
+    }
+
+    // add a process to the "ready" queue, p must outlive the simulation
+    ProcessHandle add_process(Process* p){
+        if(!p){
+            SCHED_LOG_ERROR("ERROR: Attempted to add null process to arrival index");
+            return invalid_process_handle;
+        }
+
+        std::lock_guard<std::mutex> lock(scheduler_mutex_);
+        ProcessHandle h = processes_.add(p->pid, p->arrival_time, p->burst_time, p);
+        processes_.set_nice(h, p->nice);
+        processes_.set_tickets(h, p->tickets);
+        if(!p->bursts.empty() && !processes_.set_bursts(h, p->bursts)){
+            SCHED_LOG_ERROR("ERROR: Process ", p->pid, " has invalid cpu/I/O bursts, running it as one burst of ",
+                            p->burst_time);
+        }
+        arrivals_.add(h, p->arrival_time);
+        processes_added_++;
+        SCHED_LOG_DEBUG("Process ", p->pid, " added to arrival index (arrival at: ", p->arrival_time, "ns)");
+        return h;
+    }
+
+    // add a process without a backing Process object, for large generated workloads
+    ProcessHandle add_process(int pid, nanoseconds arrival, nanoseconds burst, int nice = 0){
+        std::lock_guard<std::mutex> lock(scheduler_mutex_);
+        ProcessHandle h = processes_.add(pid, arrival, burst);
+        processes_.set_nice(h, nice);
+        arrivals_.add(h, arrival);
+        processes_added_++;
+        return h;
+    }
+
+    // add a process with alternating cpu and I/O bursts, cpu first and last. returns
+    // invalid_process_handle if the bursts aren't valid, see ProcessTable::set_bursts
+    ProcessHandle add_process(int pid, nanoseconds arrival, std::span<const nanoseconds> bursts, int nice = 0){
+        std::lock_guard<std::mutex> lock(scheduler_mutex_);
+        ProcessHandle h = processes_.add(pid, arrival, 0ns);
+        if(!processes_.set_bursts(h, bursts)){
+            SCHED_LOG_ERROR("ERROR: Process ", pid, " has invalid cpu/I/O bursts, not adding it");
+            processes_.release(h);
+            return invalid_process_handle;
+        }
+        processes_.set_nice(h, nice);
+        arrivals_.add(h, arrival);
+        processes_added_++;
+        return h;
+    }
+
+    // reserve room for n processes up front, e.g. before loading a trace
+    void reserve(size_t n){
+        std::lock_guard<std::mutex> lock(scheduler_mutex_);
+        processes_.reserve(n);
+        arrivals_.reserve(n);
+    }
+
+    // get the next ready process, invalid_process_handle if there is none
+    ProcessHandle get_next_process(){
+        return ready_queue_.pop();
+    }
+
+    // begin the simulation, processes must not be added while it runs
+    void run_simulation(){
+        run(false);
+    }
+
+    // make room for intake_capacity submissions from other threads, before the first
+    // submit(). from then on finished processes are always released from the table, with
+    // or without a retire callback, so the table stays as big as the live processes
+    void open_intake(size_t intake_capacity = default_intake_capacity){
+        std::lock_guard<std::mutex> lock(scheduler_mutex_);
+        if(!intake_){
+            intake_ = std::make_unique<SubmissionQueue>(intake_capacity);
+        }
+    }
+
+    // hand a process to run_online() from any thread, without taking a lock. it arrives
+    // when the simulation loop takes it in. waits while the intake is full, false once
+    // shutdown() was called or if the intake was never opened
+    bool submit(int pid, nanoseconds burst, int nice = 0){
+        return intake_ && intake_->submit(Submission{pid, burst, nice, steady_clock::now()});
+    }
+
+    // submit() that gives up when the intake is full
+    bool try_submit(int pid, nanoseconds burst, int nice = 0){
+        return intake_ && intake_->try_submit(Submission{pid, burst, nice, steady_clock::now()});
+    }
+
+    // stop accepting submissions. run_online() returns once the ones already accepted,
+    // and everything else it was given, have finished
+    void shutdown(){
+        if(intake_){
+            intake_->close();
+        }
+    }
+
+    // run_simulation() that keeps going while the intake is open: when everything has
+    // finished it waits for the next submission instead of returning. processes added up
+    // front run as usual. the loop only takes submissions in while fewer than ready queue
+    // plus intake capacity processes are live, so a slow scheduler pushes back on the
+    // producers instead of growing. opens the intake if open_intake() wasn't called
+    void run_online(){
+        open_intake();
+        auto started = steady_clock::now();
+        run(true);
+        std::lock_guard<std::mutex> lock(scheduler_mutex_);
+        stats_.online_wall_time = duration_cast<nanoseconds>(steady_clock::now() - started);
+    }
+
+    // submissions the intake holds by default
+    static constexpr size_t default_intake_capacity = 4096;
+
+    // record current performance metrics
+    SchedulerStats get_stats() const {
+        std::lock_guard<std::mutex> lock(scheduler_mutex_);
+        return stats_;
+    }
+
+    // helper
+    bool is_simulation_complete(){
+        std::lock_guard<std::mutex> lock(scheduler_mutex_);
+        return ready_queue_.empty() && all_processes_finished();
+    }
+
+    // called with each process once it has completed and its stats are recorded, or once the
+    // admission policy has shed it. setting it opts in to retirement: the table slot is
+    // released right after the callback returns, so long runs don't hold on to finished processes.
+    // an open intake releases them with or without a callback
+    void set_retire_callback(std::function<void(ProcessHandle)> callback){
+        std::lock_guard<std::mutex> lock(scheduler_mutex_);
+        retire_callback_ = std::move(callback);
+    }
+
+    // record arrive/enqueue/drop/shed/dispatch/preempt/complete events into buffer 0 of tracer,
+    // nullptr turns tracing off. the tracer must outlive the simulation
+    void set_tracer(EventTracer* tracer){ tracer_ = tracer; }
+
+    // record ready queue depth, arrivals, completions, drops, sheds, cpu busy time and
+    // turnaround per window of simulated time, nullptr turns it off. the telemetry must
+    // outlive the simulation
+    void set_telemetry(WindowedTelemetry* telemetry){ telemetry_ = telemetry; }
+
+    // what to do with arrivals that find the ready queue full, set before the run. the
+    // default defers them into an unbounded backlog, so every process is eventually admitted
+    void set_admission(AdmissionConfig config){
+        std::lock_guard<std::mutex> lock(scheduler_mutex_);
+        backlog_ = AdmissionBacklog(config);
+    }
+
+    // time spent in each phase of the last run_simulation(), empty unless the build has
+    // SCHEDULER_PROFILE on
+    PhaseProfile get_profile() const {
+#if SCHEDULER_PROFILE
+        return profiler_.profile();
+#else
+        return PhaseProfile{};
+#endif
+    }
+
+    // count cycles, instructions, cache misses and branch misses per phase as well. false
+    // if the build has no profiling or perf_event_open isn't allowed here
+    bool enable_hardware_counters(){
+#if SCHEDULER_PROFILE
+        return profiler_.enable_hardware_counters();
+#else
+        return false;
+#endif
+    }
+
+    // the ready queue policy itself, for policies with settings of their own
+    ReadyQueuePolicy& ready_queue(){ return ready_queue_; }
+
+    // state of every process the scheduler knows about
+    const ProcessTable& get_process_table() const { return processes_; }
+
+    nanoseconds get_current_time() const { return current_sim_time_; }
+
+private:
+    // dense per-process state, everything else refers to processes by handle
+    ProcessTable processes_;
+
+    ReadyQueuePolicy ready_queue_;
+    ClockPolicy clock_;
+
+    // mutex to protect the arrival index and stats
+    mutable std::mutex scheduler_mutex_;
+
+    // track current time in the simulation
+    nanoseconds current_sim_time_ = 0ns;
+
+    // processes submitted while run_online() runs, nullptr until open_intake()
+    std::unique_ptr<SubmissionQueue> intake_;
+    // when each taken submission was submitted, by handle, cleared once it is dispatched
+    std::vector<steady_clock::time_point> submitted_at_;
+
+    // processes that have not been admitted to the ready queue yet, in arrival order
+    ArrivalIndex arrivals_;
+
+    // object to store metrics in
+    SchedulerStats stats_;
+
+    // completion is tracked with counters instead of rescanning every process
+    std::atomic<size_t> processes_added_ = 0;
+    std::atomic<size_t> processes_completed_ = 0;
+
+    // optional hook for releasing completed processes
+    std::function<void(ProcessHandle)> retire_callback_;
+
+    // is simulation still running or has it completed
+    std::atomic<bool> simulation_active_ = false;
+
+    // arrived processes waiting for room in the ready queue, ahead of anything still in arrivals_
+    AdmissionBacklog backlog_;
+    // backlog_time is accounted up to here
+    nanoseconds backlog_since_ = 0ns;
+    // shed processes count as finished, they will never run
+    std::atomic<size_t> processes_shed_ = 0;
+    // shed under the lock, retired once it is released
+    std::vector<ProcessHandle> shed_;
+
+    // processes waiting on I/O, by the time it finishes
+    TimingWheel io_wheel_;
+    // back from I/O but the ready queue was full, they go ahead of the backlog
+    std::deque<ProcessHandle> woken_;
+    // latest time any process's I/O finishes, so the time with I/O outstanding is known
+    // without tracking every interval
+    nanoseconds io_busy_until_ = 0ns;
+
+    // process that ran the previous slice, so re-picking it isn't counted as a context switch
+    ProcessHandle last_dispatched_ = invalid_process_handle;
+
+    EventTracer* tracer_ = nullptr;
+    WindowedTelemetry* telemetry_ = nullptr;
+
+#if SCHEDULER_PROFILE
+    PhaseProfiler profiler_;
+#endif
+
+    // the simulation loop. online, running out of work means waiting for the next
+    // submission, and only a drained intake ends the run
+    void run(bool online){
+        simulation_active_ = true;
+        SCHED_LOG_INFO("Starting ", name, " Scheduler Simulation", online ? " (online)" : "");
+#if SCHEDULER_PROFILE
+        profiler_.start();
+#endif
+
+        while(!all_processes_finished() || (online && wait_for_submissions())){
+            // first check if any new processes have arrived
+            handle_new_arrivals();
+
+            ProcessHandle curr_process;
+            {
+                SCHED_PROFILE_PHASE(profiler_, SimPhase::Pick);
+                curr_process = get_next_process();
+            }
+            if(curr_process != invalid_process_handle){
+                if(telemetry_){
+                    telemetry_->depth(current_sim_time_, ready_queue_.size());
+                }
+                SCHED_LOG_DEBUG(" Dispatching Process ", processes_.pid(curr_process), " (Remaining : ",
+                                processes_.remaining(curr_process), "ns)");
+                dispatch_process(curr_process);
+                continue;
+            }
+
+            // nothing is ready, so skip the clock to the next arrival or I/O wakeup
+            SCHED_PROFILE_PHASE(profiler_, SimPhase::ClockSkip);
+            nanoseconds next_arrival = next_event();
+            if(next_arrival == nanoseconds::max()){
+                if(online && all_processes_finished()){
+                    // a producer has claimed a slot in the intake but not filled it yet
+                    std::this_thread::yield();
+                    continue;
+                }
+                SCHED_LOG_WARN("WARNING: No future arrivals found and ready queue empty, stopping simulation.");
+                break;
+            }
+
+            SCHED_LOG_DEBUG(" Ready queue is empty. Skipping to next available process arrival.");
+            // never move the clock backwards
+            current_sim_time_ = std::max(current_sim_time_, next_arrival);
+        }
+#if SCHEDULER_PROFILE
+        profiler_.stop();
+#endif
+
+        if(telemetry_){
+            telemetry_->advance(current_sim_time_);
+        }
+        {
+            std::lock_guard<std::mutex> lock(scheduler_mutex_);
+            stats_.total_sim_time = current_sim_time_;
+            account_backlog();
+            if constexpr(requires(const ReadyQueuePolicy& q, SchedulerStats& s){ q.report(s); }){
+                ready_queue_.report(stats_);
+            }
+        }
+        simulation_active_ = false;
+        if(stats_.deferred > 0 || stats_.shed > 0){
+            SCHED_LOG_WARN("WARNING: ", name, " ready queue was full, ", stats_.deferred,
+                           " arrivals were deferred (backlog peaked at ", stats_.max_backlog_depth, ") and ",
+                           stats_.shed, " were shed by the ", admission_policy_name(backlog_.config().policy),
+                           " policy.");
+        }
+        SCHED_LOG_INFO(name, "Scheduler Simulation Finished");
+    }
+
+    // online and out of work: block until something is submitted, false once the intake
+    // is drained and the run is over
+    bool wait_for_submissions(){
+        SCHED_LOG_DEBUG(" Nothing left to run at ", current_sim_time_, "ns, waiting for submissions.");
+        return intake_->wait();
+    }
+
+    void trace(SchedEventType type, nanoseconds time, ProcessHandle h){
+        if(tracer_){
+            tracer_->record(0, type, time, processes_.pid(h));
+        }
+    }
+
+    // earliest arrival or I/O wakeup, nanoseconds::max() if there is neither
+    nanoseconds next_event(){
+        nanoseconds next = arrivals_.next_arrival();
+        return io_wheel_.empty() ? next : std::min(next, io_wheel_.next_expiry());
+    }
+
+    // let process run for the slice the clock policy gives it, the clock advances with it
+    void dispatch_process(ProcessHandle h){
+        SCHED_PROFILE_PHASE(profiler_, SimPhase::Dispatch);
+        if(processes_.state(h) == Process::State::READY){
+            SCHED_LOG_DEBUG("Process ", processes_.pid(h), " starting running at ", current_sim_time_, "ns.");
+            if(h < submitted_at_.size() && submitted_at_[h] != steady_clock::time_point{}){
+                // first dispatch of a submitted process, on the wall clock
+                std::lock_guard<std::mutex> lock(scheduler_mutex_);
+                stats_.submit_latencies.record(duration_cast<nanoseconds>(steady_clock::now() - submitted_at_[h]));
+                submitted_at_[h] = steady_clock::time_point{};
+            }
+        } else if(processes_.state(h) == Process::State::BLOCKED && h == last_dispatched_){
+            // picked again straight after its own slice, it never left the CPU so this isn't a switch
+            processes_.state(h) = Process::State::RUNNING;
+        } else {
+            SCHED_PROFILE_PHASE(profiler_, SimPhase::Stats);
+            std::lock_guard<std::mutex> lock(scheduler_mutex_);
+            // how long the process waited to get the CPU back, since its last slice or its I/O
+            stats_.context_switch_latencies.record(current_sim_time_ - processes_.last_run(h));
+        }
+        last_dispatched_ = h;
+        trace(SchedEventType::Dispatch, current_sim_time_, h);
+
+        nanoseconds slice = clock_.slice(processes_, h, current_sim_time_, next_event());
+        if constexpr(requires(ReadyQueuePolicy& q){ q.time_slice(h, current_sim_time_); }){
+            slice = std::min(slice, ready_queue_.time_slice(h, current_sim_time_));
+        }
+        nanoseconds started = current_sim_time_;
+        nanoseconds ran = std::min(slice, processes_.burst_left(h));
+        bool completed = processes_.execute_slice(h, current_sim_time_, ran);
+        current_sim_time_ += ran;
+        if(telemetry_){
+            telemetry_->busy(started, current_sim_time_);
+        }
+        if(io_busy_until_ > started){
+            // the CPU ran while some other process's I/O was outstanding
+            std::lock_guard<std::mutex> lock(scheduler_mutex_);
+            stats_.cpu_io_overlap += std::min(current_sim_time_, io_busy_until_) - started;
+        }
+        bool blocks = !completed && processes_.burst_left(h) == 0ns;
+        trace(completed ? SchedEventType::Complete : (blocks ? SchedEventType::Block : SchedEventType::Preempt),
+              current_sim_time_, h);
+
+        if(completed){
+            SCHED_LOG_DEBUG(" Process: ", processes_.pid(h), " COMPLETED at ", processes_.completion(h),
+                            "ns (Burst: ", processes_.burst(h), "ns).");
+
+            if constexpr(requires(ReadyQueuePolicy& q){ q.complete(h); }){
+                ready_queue_.complete(h);
+            }
+            // stats are recorded exactly once, at the moment the process completes
+            record_completion(h);
+            return;
+        }
+        if(blocks){
+            start_io(h);
+            return;
+        }
+
+        // preempted: anything that arrived during the slice queues ahead of it, but one
+        // slot is held back so the preempted process can never be pushed out
+        handle_new_arrivals(1);
+        SCHED_PROFILE_PHASE(profiler_, SimPhase::Pick);
+        ready_queue_.push(h);
+        if(telemetry_){
+            telemetry_->depth(current_sim_time_, ready_queue_.size());
+        }
+    }
+
+    // retrieve all the processes who would have arrived at current simulation time,
+    // keeping reserved_slots of the ready queue free
+    void handle_new_arrivals(size_t reserved_slots = 0){
+        SCHED_PROFILE_PHASE(profiler_, SimPhase::Arrivals);
+        {
+            std::lock_guard<std::mutex> lock(scheduler_mutex_);
+            account_backlog();
+            wake_io(reserved_slots);
+
+            // the backlog arrived before anything still in the arrival index, so it goes first
+            while(!backlog_.empty()){
+                ProcessHandle h = backlog_.front();
+                if(!admit(h, reserved_slots)){
+                    break;
+                }
+                backlog_.pop();
+            }
+
+            // only the front of the arrival index can have arrived, so each process is taken exactly once
+            while(arrivals_.has_arrival_by(current_sim_time_)){
+                ProcessHandle h = arrivals_.peek();
+                arrivals_.pop();
+                arrive(h, reserved_slots);
+            }
+
+            // submissions arrive now, after everything that arrived before them
+            if(intake_){
+                take_submissions(reserved_slots);
+            }
+        }
+        if(telemetry_){
+            telemetry_->depth(current_sim_time_, ready_queue_.size());
+        }
+        retire_shed();
+    }
+
+    // h has arrived, into the ready queue if the backlog is empty and there is room, called with the lock held
+    void arrive(ProcessHandle h, size_t reserved_slots){
+        trace(SchedEventType::Arrive, processes_.arrival(h), h);
+        if(telemetry_){
+            telemetry_->arrival(processes_.arrival(h));
+        }
+        if(backlog_.empty() && admit(h, reserved_slots)){
+            return;
+        }
+        defer(h);
+    }
+
+    // add what producers have submitted to the table, arriving at the current time. stops
+    // once ready queue plus intake capacity processes are live, what is left stays in the
+    // intake and producers wait for room. called with the lock held
+    void take_submissions(size_t reserved_slots){
+        constexpr size_t batch = 64;
+        Submission taken[batch];
+        size_t limit = ready_queue_.capacity() + intake_->capacity();
+        for(;;){
+            size_t live = processes_added_.load() - processes_completed_.load() - processes_shed_.load();
+            if(live >= limit){
+                return;
+            }
+            size_t count = intake_->take(taken, std::min(batch, limit - live));
+            for(size_t i = 0; i < count; ++i){
+                const Submission& submission = taken[i];
+                ProcessHandle h = processes_.add(submission.pid, current_sim_time_, submission.burst);
+                processes_.set_nice(h, submission.nice);
+                if(h >= submitted_at_.size()){
+                    submitted_at_.resize(processes_.size());
+                }
+                submitted_at_[h] = submission.submitted;
+                processes_added_++;
+                stats_.submitted++;
+                arrive(h, reserved_slots);
+            }
+            if(count < batch){
+                return;
+            }
+        }
+    }
+
+    // h's cpu burst is over, park it until its I/O finishes
+    void start_io(ProcessHandle h){
+        nanoseconds io = processes_.start_io(h);
+        nanoseconds done = current_sim_time_ + io;
+        if constexpr(requires(ReadyQueuePolicy& q){ q.block(h); }){
+            ready_queue_.block(h);
+        }
+        {
+            std::lock_guard<std::mutex> lock(scheduler_mutex_);
+            io_wheel_.schedule(h, done);
+            stats_.io_bursts++;
+            stats_.io_time += io;
+            // every I/O so far started at or before now, so from now on the union of them
+            // is [now, io_busy_until_) and only the part past that is new
+            if(done > io_busy_until_){
+                stats_.io_busy_time += done - std::max(current_sim_time_, io_busy_until_);
+                io_busy_until_ = done;
+            }
+        }
+        SCHED_LOG_DEBUG("Process ", processes_.pid(h), " waiting on I/O until ", done, "ns.");
+    }
+
+    // move processes whose I/O has finished back into the ready queue, called with the lock held
+    void wake_io(size_t reserved_slots){
+        if(!io_wheel_.empty()){
+            io_wheel_.advance(current_sim_time_, [this](ProcessHandle h, nanoseconds done){
+                // waiting for the CPU starts now, see dispatch_process
+                processes_.last_run(h) = done;
+                trace(SchedEventType::Wake, done, h);
+                woken_.push_back(h);
+            });
+        }
+        while(!woken_.empty()){
+            ProcessHandle h = woken_.front();
+            if(ready_queue_.size() + reserved_slots >= ready_queue_.capacity() || !ready_queue_.push(h)){
+                break;
+            }
+            woken_.pop_front();
+            trace(SchedEventType::Enqueue, current_sim_time_, h);
+        }
+    }
+
+    // push h into the ready queue if there is room for it and reserved_slots more
+    bool admit(ProcessHandle h, size_t reserved_slots){
+        if(ready_queue_.size() + reserved_slots >= ready_queue_.capacity() || !ready_queue_.push(h)){
+            return false;
+        }
+        stats_.admitted++;
+        trace(SchedEventType::Enqueue, current_sim_time_, h);
+        SCHED_LOG_DEBUG("Process ", processes_.pid(h), " arrived and added to ready queue at ",
+                        current_sim_time_, "ns. Queue size: ", ready_queue_.size());
+        return true;
+    }
+
+    // the ready queue is full, hand h to the admission policy
+    void defer(ProcessHandle h){
+        ProcessHandle victim = backlog_.offer(h, processes_.remaining(h));
+        if(victim != h){
+            stats_.deferred++;
+            stats_.max_backlog_depth = std::max(stats_.max_backlog_depth, backlog_.size());
+            trace(SchedEventType::Drop, current_sim_time_, h);
+            if(telemetry_){
+                telemetry_->drop(current_sim_time_);
+            }
+            SCHED_LOG_DEBUG("WARNING: ", name, " ready queue full (capacity: ",
+                            ready_queue_.capacity(), "), deferring process ", processes_.pid(h),
+                            " (arrived at ", processes_.arrival(h), "ns, sim_time: ", current_sim_time_,
+                            "ns, backlog: ", backlog_.size(), ").");
+        }
+        if(victim != invalid_process_handle){
+            shed(victim);
+        }
+    }
+
+    // the process will never run, it leaves the simulation without stats of its own
+    void shed(ProcessHandle h){
+        stats_.shed++;
+        trace(SchedEventType::Shed, current_sim_time_, h);
+        if(telemetry_){
+            telemetry_->shed(current_sim_time_);
+        }
+        SCHED_LOG_DEBUG("Process ", processes_.pid(h), " shed by the ", admission_policy_name(backlog_.config().policy),
+                        " policy at ", current_sim_time_, "ns (arrived at ", processes_.arrival(h), "ns).");
+        if(h < submitted_at_.size()){
+            submitted_at_[h] = steady_clock::time_point{};
+        }
+        if(retires()){
+            shed_.push_back(h);
+        }
+        processes_shed_++;
+    }
+
+    void retire_shed(){
+        for(ProcessHandle h : shed_){
+            if(retire_callback_){
+                retire_callback_(h);
+            }
+            std::lock_guard<std::mutex> lock(scheduler_mutex_);
+            processes_.release(h);
+        }
+        shed_.clear();
+    }
+
+    // fold the time since the last call into backlog_time, called with the lock held
+    void account_backlog(){
+        stats_.backlog_time += (current_sim_time_ - backlog_since_) * static_cast<int64_t>(backlog_.size());
+        backlog_since_ = current_sim_time_;
+    }
+
+    // finished processes are released from the table with a retire callback, and always once the intake is open
+    bool retires() const { return retire_callback_ || intake_; }
+
+    bool all_processes_finished() const {
+        return processes_completed_.load() + processes_shed_.load() == processes_added_.load();
+    }
+
+    // push a completed process into the stats and retire it
+    void record_completion(ProcessHandle h){
+        SCHED_PROFILE_PHASE(profiler_, SimPhase::Stats);
+        // hand the final state back to the caller's Process, if there is one
+        processes_.sync_owner(h);
+        {
+            std::lock_guard<std::mutex> lock(scheduler_mutex_);
+            stats_.record_completion(processes_, h);
+        }
+        if(telemetry_){
+            telemetry_->completion(processes_.completion(h), processes_.turnaround(h));
+        }
+        processes_completed_++;
+
+        SCHED_LOG_DEBUG("Stats for Process ", processes_.pid(h), ": Turnaround=", processes_.turnaround(h),
+                        "ns, Waiting= ", processes_.waiting(h), "ns.");
+
+        // the scheduler never touches h again, so its slot can be reused
+        if(retires()){
+            if(retire_callback_){
+                retire_callback_(h);
+            }
+            std::lock_guard<std::mutex> lock(scheduler_mutex_);
+            processes_.release(h);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef SUBMISSION_QUEUE_H
+#define SUBMISSION_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "RingBuffer.h"
+
+using namespace std::chrono;
+
+// a process handed to a running simulation. it arrives when the simulation loop takes it
+// in, submitted is only used to measure how long it took to reach the CPU
+struct Submission {
+    int pid = 0;
+    nanoseconds burst = 0ns;
+    int nice = 0;
+    steady_clock::time_point submitted;
+};
+
+// intake for processes submitted while the simulation runs: any number of producer threads
+// push into a bounded MPMCRingBuffer, and the simulation loop is its only consumer.
+// submitting never takes a lock. a full intake pushes back on producers instead of growing.
+//
+// close() is the shutdown signal. once it returns no new submission is accepted, and the
+// consumer sees the intake as drained when everything accepted before it has been taken.
+// the consumer blocks on a generation counter when it has nothing to do, producers bump it
+// after every push
+class SubmissionQueue{
+public:
+    explicit SubmissionQueue(size_t capacity) : ring_(capacity) {}
+
+    SubmissionQueue(const SubmissionQueue&) = delete;
+    SubmissionQueue& operator=(const SubmissionQueue&) = delete;
+
+    size_t capacity() const { return ring_.capacity(); }
+
+    // snapshot, stale as soon as producers are active
+    size_t size() const { return ring_.size(); }
+    bool empty() const { return ring_.empty(); }
+
+    // false if the intake is full or closed
+    bool try_submit(const Submission& submission){
+        // counted as in flight before looking at closed_, so the consumer can't see the
+        // intake drained while this push is still on its way in
+        producers_.fetch_add(1);
+        bool closed = closed_.load();
+        bool accepted = !closed && ring_.enqueue(submission);
+        producers_.fetch_sub(1);
+        if(accepted || closed){
+            signal();
+        }
+        return accepted;
+    }
+
+    // wait for room while the intake is full, false only once it is closed
+    bool submit(const Submission& submission){
+        while(!try_submit(submission)){
+            if(closed_.load()){
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    // stop accepting submissions, the ones already accepted are still taken
+    void close(){
+        closed_.store(true);
+        signal();
+    }
+
+    bool closed() const { return closed_.load(); }
+
+    // consumer only: take up to n submissions, oldest first, returns how many were taken
+    size_t take(Submission* out, size_t n){ return ring_.dequeue_n(out, n); }
+
+    // consumer only: closed, and nothing accepted is left to take
+    bool drained() const { return closed_.load() && producers_.load() == 0 && ring_.empty(); }
+
+    // consumer only: block until something is submitted or the intake is closed. false
+    // once it is drained, true when something was submitted. a producer may still be
+    // filling in its slot, so take() can come back empty straight after
+    bool wait(){
+        for(;;){
+            uint32_t seen = generation_.load();
+            if(!ring_.empty()){
+                return true;
+            }
+            if(drained()){
+                return false;
+            }
+            // a push after the generation was read changes it, so this can't miss one
+            generation_.wait(seen);
+        }
+    }
+
+private:
+    MPMCRingBuffer<Submission> ring_;
+    std::atomic<bool> closed_ = false;
+    alignas(cache_line_size) std::atomic<uint32_t> producers_ = 0;
+    alignas(cache_line_size) std::atomic<uint32_t> generation_ = 0;
+
+    void signal(){
+        generation_.fetch_add(1);
+        generation_.notify_one();
+    }
+};
+
+#endif
@@ -0,0 +1,177 @@
+#include "Telemetry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "Log.h"
+
+WindowedTelemetry::WindowedTelemetry(nanoseconds window, size_t capacity)
+    : window_(std::max<int64_t>(window.count(), 1)),
+      mask_(std::bit_ceil(std::max<size_t>(capacity, 1)) - 1),
+      window_end_(window_)
+{
+    size_t slots = mask_ + 1;
+    depth_min_.resize(slots);
+    depth_max_.resize(slots);
+    depth_area_.resize(slots);
+    arrivals_.resize(slots);
+    completions_.resize(slots);
+    drops_.resize(slots);
+    shed_.resize(slots);
+    busy_.resize(slots);
+    latency_max_.resize(slots);
+    latency_.resize(slots * latency_buckets);
+    open(0);
+}
+
+void WindowedTelemetry::clear(){
+    current_ = 0;
+    window_end_ = window_;
+    last_ = 0;
+    depth_ = 0;
+    open(0);
+}
+
+void WindowedTelemetry::open(uint64_t w){
+    size_t slot = w & mask_;
+    depth_min_[slot] = depth_;
+    depth_max_[slot] = depth_;
+    depth_area_[slot] = 0.0;
+    arrivals_[slot] = 0;
+    completions_[slot] = 0;
+    drops_[slot] = 0;
+    shed_[slot] = 0;
+    busy_[slot] = 0;
+    latency_max_[slot] = 0;
+    std::fill_n(latency_.begin() + static_cast<ptrdiff_t>(slot * latency_buckets), latency_buckets, 0u);
+}
+
+void WindowedTelemetry::roll(int64_t t){
+    depth_area_[current_ & mask_] += static_cast<double>(depth_) * (window_end_ - last_);
+
+    // the windows in between saw no events, only the current depth. any that would be
+    // overwritten before t's window is reached are never opened
+    uint64_t target = window_of(t);
+    uint64_t next = std::max(current_ + 1, target > mask_ ? target - mask_ : 0);
+    for(uint64_t w = next; w <= target; ++w){
+        open(w);
+        if(w < target){
+            depth_area_[w & mask_] = static_cast<double>(depth_) * window_;
+        }
+    }
+    current_ = target;
+    last_ = static_cast<int64_t>(target) * window_;
+    window_end_ = last_ + window_;
+}
+
+double WindowedTelemetry::depth_mean(size_t i) const {
+    int64_t len = length(i).count();
+    return len == 0 ? static_cast<double>(depth_min(i)) : depth_area_[slot_at(i)] / len;
+}
+
+double WindowedTelemetry::busy_fraction(size_t i) const {
+    int64_t len = length(i).count();
+    return len == 0 ? 0.0 : static_cast<double>(busy_[slot_at(i)]) / len;
+}
+
+nanoseconds WindowedTelemetry::latency_percentile(size_t i, double percentile) const {
+    uint64_t total = completions(i);
+    if(total == 0) return 0ns;
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * total));
+    rank = std::clamp<uint64_t>(rank, 1, total);
+
+    uint64_t seen = 0;
+    for(size_t b = 0; b < latency_buckets; ++b){
+        seen += latency_count(i, b);
+        if(seen >= rank){
+            int64_t upper = b == 0 ? 0 : static_cast<int64_t>((uint64_t{1} << b) - 1);
+            return std::min(nanoseconds(upper), latency_max(i));
+        }
+    }
+    return latency_max(i);
+}
+
+bool write_telemetry_csv(const WindowedTelemetry& telemetry, const std::string& path){
+    std::ofstream out(path);
+    if(!out){
+        SCHED_LOG_ERROR("ERROR: could not open ", path, " for writing");
+        return false;
+    }
+    out << "start_ns,length_ns,depth_min,depth_mean,depth_max,arrivals,completions,drops,shed,"
+        << "busy_fraction,latency_p50_ns,latency_p99_ns,latency_max_ns\n";
+    for(size_t i = 0; i < telemetry.size(); ++i){
+        out << telemetry.start(i).count() << ',' << telemetry.length(i).count() << ','
+            << telemetry.depth_min(i) << ',' << telemetry.depth_mean(i) << ',' << telemetry.depth_max(i) << ','
+            << telemetry.arrivals(i) << ',' << telemetry.completions(i) << ',' << telemetry.drops(i) << ','
+            << telemetry.sheds(i) << ',' << telemetry.busy_fraction(i) << ','
+            << telemetry.latency_percentile(i, 50.0).count() << ','
+            << telemetry.latency_percentile(i, 99.0).count() << ','
+            << telemetry.latency_max(i).count() << '\n';
+    }
+    out.close();
+    if(!out){
+        SCHED_LOG_ERROR("ERROR: failed writing ", path);
+        return false;
+    }
+    return true;
+}
+
+namespace {
+
+// one column of the held windows, oldest first
+template <typename T, typename Fn>
+void write_column(std::ofstream& out, const WindowedTelemetry& telemetry, Fn&& value){
+    std::vector<T> column(telemetry.size());
+    for(size_t i = 0; i < column.size(); ++i){
+        column[i] = static_cast<T>(value(i));
+    }
+    out.write(reinterpret_cast<const char*>(column.data()), static_cast<std::streamsize>(column.size() * sizeof(T)));
+}
+
+} // namespace
+
+bool write_telemetry_columns(const WindowedTelemetry& telemetry, const std::string& path){
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if(!out){
+        SCHED_LOG_ERROR("ERROR: could not open ", path, " for writing");
+        return false;
+    }
+
+    TelemetryHeader header{};
+    std::copy(std::begin(telemetry_magic), std::end(telemetry_magic), header.magic);
+    header.version = telemetry_version;
+    header.latency_buckets = WindowedTelemetry::latency_buckets;
+    header.rows = telemetry.size();
+    header.window_ns = telemetry.window().count();
+    header.first_window = telemetry.overwritten();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    write_column<int64_t>(out, telemetry, [&](size_t i){ return telemetry.start(i).count(); });
+    write_column<int64_t>(out, telemetry, [&](size_t i){ return telemetry.length(i).count(); });
+    write_column<uint32_t>(out, telemetry, [&](size_t i){ return telemetry.depth_min(i); });
+    write_column<uint32_t>(out, telemetry, [&](size_t i){ return telemetry.depth_max(i); });
+    write_column<double>(out, telemetry, [&](size_t i){ return telemetry.depth_mean(i); });
+    write_column<uint32_t>(out, telemetry, [&](size_t i){ return telemetry.arrivals(i); });
+    write_column<uint32_t>(out, telemetry, [&](size_t i){ return telemetry.completions(i); });
+    write_column<uint32_t>(out, telemetry, [&](size_t i){ return telemetry.drops(i); });
+    write_column<uint32_t>(out, telemetry, [&](size_t i){ return telemetry.sheds(i); });
+    write_column<int64_t>(out, telemetry, [&](size_t i){ return telemetry.busy_time(i).count(); });
+    write_column<int64_t>(out, telemetry, [&](size_t i){ return telemetry.latency_max(i).count(); });
+
+    std::vector<uint32_t> histograms(telemetry.size() * WindowedTelemetry::latency_buckets);
+    for(size_t i = 0; i < telemetry.size(); ++i){
+        for(size_t b = 0; b < WindowedTelemetry::latency_buckets; ++b){
+            histograms[i * WindowedTelemetry::latency_buckets + b] = telemetry.latency_count(i, b);
+        }
+    }
+    out.write(reinterpret_cast<const char*>(histograms.data()),
+              static_cast<std::streamsize>(histograms.size() * sizeof(uint32_t)));
+
+    out.close();
+    if(!out){
+        SCHED_LOG_ERROR("ERROR: failed writing ", path);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,193 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+// the simulation as a time series: simulated time is cut into fixed windows, and each
+// window keeps the ready queue depth (min, time weighted mean, max), arrivals,
+// completions, drops (arrivals deferred to the backlog), sheds, cpu busy time and a
+// histogram of the turnaround times of the processes that completed in it.
+//
+// windows live in preallocated columns used as a ring, so recording never allocates and
+// the oldest windows are overwritten once the ring is full: it always holds the latest
+// `capacity` windows of a run. recording is a compare against the end of the open window
+// plus a few adds, the window bookkeeping only runs when the clock crosses into the next
+// one. like EventTracer, one thread records and the columns are read once it has stopped
+class WindowedTelemetry{
+public:
+    // log2 buckets of the per window latency histograms, bucket b holds [2^(b-1), 2^b)
+    static constexpr size_t latency_buckets = 64;
+
+    // capacity is rounded up to a power of two
+    WindowedTelemetry(nanoseconds window, size_t capacity);
+
+    nanoseconds window() const { return nanoseconds(window_); }
+    size_t capacity() const { return mask_ + 1; }
+
+    // windows held, oldest first, including the open one
+    size_t size() const { return static_cast<size_t>(std::min<uint64_t>(current_ + 1, capacity())); }
+    // windows of this run that no longer fit in the ring
+    uint64_t overwritten() const { return current_ + 1 - size(); }
+
+    // the ready queue holds depth processes from now on
+    void depth(nanoseconds now, size_t depth){
+        advance(now);
+        depth_ = static_cast<uint32_t>(depth);
+        size_t slot = current_ & mask_;
+        depth_min_[slot] = std::min(depth_min_[slot], depth_);
+        depth_max_[slot] = std::max(depth_max_[slot], depth_);
+    }
+
+    // move the clock to now without a change in depth, e.g. at the end of a run
+    void advance(nanoseconds now){
+        int64_t t = now.count();
+        if(t >= window_end_){
+            roll(t);
+        }
+        if(t > last_){
+            depth_area_[current_ & mask_] += static_cast<double>(depth_) * (t - last_);
+            last_ = t;
+        }
+    }
+
+    // the cpu ran from start to end, split over the windows it spans
+    void busy(nanoseconds start, nanoseconds end){
+        advance(end);
+        int64_t to = end.count();
+        // anything before the oldest held window is gone already
+        int64_t from = std::max(start.count(), this->start(0).count());
+        for(uint64_t w = window_of(from); w <= current_ && from < to; ++w){
+            int64_t window_end = static_cast<int64_t>(w + 1) * window_;
+            int64_t until = std::min(to, window_end);
+            if(held(w)){
+                busy_[w & mask_] += until - from;
+            }
+            from = until;
+        }
+    }
+
+    // counted in the window of the time they happened, if that window is still held
+    void arrival(nanoseconds at){
+        if(uint32_t* slot = counter(arrivals_, at)) ++*slot;
+    }
+
+    void drop(nanoseconds at){
+        if(uint32_t* slot = counter(drops_, at)) ++*slot;
+    }
+
+    void shed(nanoseconds at){
+        if(uint32_t* slot = counter(shed_, at)) ++*slot;
+    }
+
+    void completion(nanoseconds at, nanoseconds latency){
+        uint32_t* slot = counter(completions_, at);
+        if(!slot){
+            return;
+        }
+        ++*slot;
+        size_t index = static_cast<size_t>(slot - completions_.data());
+        uint64_t value = latency.count() > 0 ? static_cast<uint64_t>(latency.count()) : 0;
+        latency_[index * latency_buckets + std::min<size_t>(std::bit_width(value), latency_buckets - 1)]++;
+        latency_max_[index] = std::max(latency_max_[index], static_cast<int64_t>(value));
+    }
+
+    // forget everything, the clock goes back to 0
+    void clear();
+
+    // row i of the held windows, 0 is the oldest and size() - 1 the open one
+    nanoseconds start(size_t i) const { return nanoseconds(static_cast<int64_t>(window_at(i)) * window_); }
+    // a full window, except for the open one which only reaches as far as the clock
+    nanoseconds length(size_t i) const {
+        return window_at(i) == current_ ? nanoseconds(last_) - start(i) : window();
+    }
+    size_t depth_min(size_t i) const { return depth_min_[slot_at(i)]; }
+    size_t depth_max(size_t i) const { return depth_max_[slot_at(i)]; }
+    double depth_mean(size_t i) const;
+    uint64_t arrivals(size_t i) const { return arrivals_[slot_at(i)]; }
+    uint64_t completions(size_t i) const { return completions_[slot_at(i)]; }
+    uint64_t drops(size_t i) const { return drops_[slot_at(i)]; }
+    uint64_t sheds(size_t i) const { return shed_[slot_at(i)]; }
+    nanoseconds busy_time(size_t i) const { return nanoseconds(busy_[slot_at(i)]); }
+    double busy_fraction(size_t i) const;
+    // upper edge of the log2 bucket holding the percentile, so within a factor of two,
+    // clamped to the largest latency of the window
+    nanoseconds latency_percentile(size_t i, double percentile) const;
+    nanoseconds latency_max(size_t i) const { return nanoseconds(latency_max_[slot_at(i)]); }
+    uint32_t latency_count(size_t i, size_t bucket) const { return latency_[slot_at(i) * latency_buckets + bucket]; }
+
+private:
+    int64_t window_;
+    size_t mask_;
+    // absolute number of the open window, its end, and how far into it the clock is
+    uint64_t current_ = 0;
+    int64_t window_end_;
+    int64_t last_ = 0;
+    uint32_t depth_ = 0;
+
+    // one entry per slot of the ring
+    std::vector<uint32_t> depth_min_;
+    std::vector<uint32_t> depth_max_;
+    // depth integrated over the window's time
+    std::vector<double> depth_area_;
+    std::vector<uint32_t> arrivals_;
+    std::vector<uint32_t> completions_;
+    std::vector<uint32_t> drops_;
+    std::vector<uint32_t> shed_;
+    std::vector<int64_t> busy_;
+    std::vector<int64_t> latency_max_;
+    // latency_buckets per slot
+    std::vector<uint32_t> latency_;
+
+    uint64_t window_of(int64_t t) const { return t > 0 ? static_cast<uint64_t>(t / window_) : 0; }
+    bool held(uint64_t w) const { return w <= current_ && current_ - w <= mask_; }
+    uint64_t window_at(size_t i) const { return current_ + 1 - size() + i; }
+    size_t slot_at(size_t i) const { return window_at(i) & mask_; }
+
+    uint32_t* counter(std::vector<uint32_t>& column, nanoseconds at){
+        uint64_t w = window_of(at.count());
+        if(w > current_){
+            advance(at);
+        }
+        return held(w) ? &column[w & mask_] : nullptr;
+    }
+
+    // close the open window and open the one t falls in
+    void roll(int64_t t);
+    void open(uint64_t w);
+};
+
+// one row per held window: start, length, depth min/mean/max, counts, busy fraction and
+// the window's p50, p99 and max latency. false if the file can't be written
+bool write_telemetry_csv(const WindowedTelemetry& telemetry, const std::string& path);
+
+// the same windows as binary columns for plotting tools: a 40 byte header, then each
+// column as `rows` little-endian values in this order: start_ns, length_ns (int64),
+// depth_min, depth_max (uint32), depth_mean (double), arrivals, completions, drops, shed
+// (uint32), busy_ns, latency_max_ns (int64), and last the latency histograms as rows x 64
+// uint32 counts. false if the file can't be written
+bool write_telemetry_columns(const WindowedTelemetry& telemetry, const std::string& path);
+
+struct TelemetryHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t latency_buckets;
+    uint64_t rows;
+    int64_t window_ns;
+    // windows before the first row that were overwritten
+    uint64_t first_window;
+};
+
+static_assert(sizeof(TelemetryHeader) == 40, "telemetry header layout is part of the file format");
+
+inline constexpr char telemetry_magic[8] = {'S', 'C', 'H', 'D', 'T', 'E', 'L', '1'};
+inline constexpr uint32_t telemetry_version = 1;
+
+#endif
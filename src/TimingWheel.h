@@ -0,0 +1,283 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ProcessTable.h"
+
+using namespace std::chrono;
+
+// hierarchical timing wheel of per-process timers, for waking processes when their I/O
+// finishes. level k has 64 slots of 64^k nanoseconds, and a timer sits at the level of
+// the highest 6-bit digit in which its expiry differs from the wheel's clock, so every
+// timer in level k fires after every timer below it. eleven levels cover the whole
+// 63-bit clock.
+//
+// scheduling and cancelling are O(1): a slot is an intrusive list threaded through
+// per-handle arrays, like MultiLevelFeedbackQueue's levels. advancing finds the next
+// occupied slot through a bitmap per level, so a jump of any length costs nothing for
+// the empty time in between, and a timer is moved down at most once per level before it
+// fires. timers fire in expiry order, those with the same expiry in the order they were
+// scheduled
+class TimingWheel{
+public:
+    static constexpr size_t slot_bits = 6;
+    static constexpr size_t slots = size_t(1) << slot_bits;
+    static constexpr size_t levels = 11;
+
+    TimingWheel(){
+        head_.fill(invalid_process_handle);
+        tail_.fill(invalid_process_handle);
+    }
+
+    void reserve(size_t max_handle){
+        if(max_handle >= next_.size()){
+            grow(max_handle + 1);
+        }
+    }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+
+    // the wheel's clock, the time it was last advanced to
+    nanoseconds now() const { return nanoseconds(now_); }
+
+    bool contains(ProcessHandle h) const { return h < bucket_.size() && bucket_[h] != not_scheduled; }
+
+    nanoseconds expiry(ProcessHandle h) const { return nanoseconds(expiry_[h]); }
+
+    // fire h at expiry, or on the next advance if that is already past. false if h is
+    // already scheduled
+    bool schedule(ProcessHandle h, nanoseconds expiry){
+        if(h >= next_.size()){
+            grow(static_cast<size_t>(h) + 1);
+        } else if(bucket_[h] != not_scheduled){
+            return false;
+        }
+        expiry_[h] = expiry.count();
+        place(h);
+        size_++;
+        if(next_valid_ && expiry.count() < next_expiry_){
+            next_expiry_ = expiry.count();
+        }
+        return true;
+    }
+
+    // take h's timer out without firing it, false if it isn't scheduled
+    bool cancel(ProcessHandle h){
+        if(!contains(h)){
+            return false;
+        }
+        unlink(h);
+        size_--;
+        if(next_valid_ && expiry_[h] == next_expiry_){
+            next_valid_ = false;
+        }
+        return true;
+    }
+
+    // earliest expiry of any timer, nanoseconds::max() if there are none. exact, not the
+    // start of the slot it is in: the slot is scanned once and the answer kept until a
+    // timer fires or is cancelled
+    nanoseconds next_expiry(){
+        if(size_ == 0){
+            return nanoseconds::max();
+        }
+        if(!next_valid_){
+            next_expiry_ = find_next_expiry();
+            next_valid_ = true;
+        }
+        return nanoseconds(next_expiry_);
+    }
+
+    // move the clock forward to now and call fire(handle, expiry) for every timer that
+    // expired by then. fire must not schedule or cancel timers
+    template <typename Fire>
+    void advance(nanoseconds now, Fire&& fire){
+        int64_t target = now.count();
+        fire_due(fire);
+        while(level_mask_ != 0){
+            size_t level = static_cast<size_t>(std::countr_zero(level_mask_));
+            size_t slot = static_cast<size_t>(std::countr_zero(bitmap_[level]));
+            int64_t start = slot_start(level, slot);
+            if(start > target){
+                break;
+            }
+
+            // nothing is earlier than this slot, so the clock can move to its start and its
+            // timers drop to lower levels (or fire, from level 0 every timer is due)
+            now_ = start;
+            ProcessHandle h = detach(level, slot);
+            next_valid_ = false;
+            while(h != invalid_process_handle){
+                ProcessHandle next = next_[h];
+                if(level == 0){
+                    bucket_[h] = not_scheduled;
+                    size_--;
+                    fire(h, nanoseconds(expiry_[h]));
+                } else {
+                    place(h);
+                }
+                h = next;
+            }
+            fire_due(fire);
+        }
+        if(target > now_){
+            now_ = target;
+        }
+    }
+
+    void clear(){
+        for(size_t b = 0; b <= due_bucket; ++b){
+            for(ProcessHandle h = head_[b]; h != invalid_process_handle; h = next_[h]){
+                bucket_[h] = not_scheduled;
+            }
+        }
+        head_.fill(invalid_process_handle);
+        tail_.fill(invalid_process_handle);
+        bitmap_.fill(0);
+        level_mask_ = 0;
+        size_ = 0;
+        next_valid_ = false;
+    }
+
+private:
+    static constexpr uint16_t not_scheduled = UINT16_MAX;
+    // timers already expired when they were scheduled
+    static constexpr size_t due_bucket = levels * slots;
+
+    int64_t now_ = 0;
+    size_t size_ = 0;
+
+    // one list per slot plus the due list
+    std::array<ProcessHandle, due_bucket + 1> head_;
+    std::array<ProcessHandle, due_bucket + 1> tail_;
+    // occupied slots of each level, and levels with any occupied slot
+    std::array<uint64_t, levels> bitmap_{};
+    uint32_t level_mask_ = 0;
+
+    // per handle
+    std::vector<ProcessHandle> next_;
+    std::vector<ProcessHandle> prev_;
+    std::vector<int64_t> expiry_;
+    std::vector<uint16_t> bucket_;
+
+    bool next_valid_ = false;
+    int64_t next_expiry_ = 0;
+
+    void grow(size_t n){
+        next_.resize(n, invalid_process_handle);
+        prev_.resize(n, invalid_process_handle);
+        expiry_.resize(n, 0);
+        bucket_.resize(n, not_scheduled);
+    }
+
+    // every occupied slot at level has a digit above the clock's, and shares the clock's
+    // digits above level
+    int64_t slot_start(size_t level, size_t slot) const {
+        size_t shift = slot_bits * (level + 1);
+        int64_t prefix = shift >= 63 ? 0 : (now_ >> shift) << shift;
+        return prefix | static_cast<int64_t>(slot) << (slot_bits * level);
+    }
+
+    void place(ProcessHandle h){
+        int64_t expiry = expiry_[h];
+        size_t bucket = due_bucket;
+        if(expiry > now_){
+            uint64_t differ = static_cast<uint64_t>(expiry ^ now_);
+            size_t level = static_cast<size_t>(63 - std::countl_zero(differ)) / slot_bits;
+            size_t slot = static_cast<size_t>(expiry >> (slot_bits * level)) & (slots - 1);
+            bucket = level * slots + slot;
+            bitmap_[level] |= uint64_t(1) << slot;
+            level_mask_ |= uint32_t(1) << level;
+        }
+        bucket_[h] = static_cast<uint16_t>(bucket);
+        next_[h] = invalid_process_handle;
+        prev_[h] = tail_[bucket];
+        if(tail_[bucket] == invalid_process_handle){
+            head_[bucket] = h;
+        } else {
+            next_[tail_[bucket]] = h;
+        }
+        tail_[bucket] = h;
+    }
+
+    void unlink(ProcessHandle h){
+        size_t bucket = bucket_[h];
+        if(prev_[h] == invalid_process_handle){
+            head_[bucket] = next_[h];
+        } else {
+            next_[prev_[h]] = next_[h];
+        }
+        if(next_[h] == invalid_process_handle){
+            tail_[bucket] = prev_[h];
+        } else {
+            prev_[next_[h]] = prev_[h];
+        }
+        bucket_[h] = not_scheduled;
+        if(head_[bucket] == invalid_process_handle && bucket != due_bucket){
+            clear_slot(bucket / slots, bucket % slots);
+        }
+    }
+
+    // empty a slot and return its list
+    ProcessHandle detach(size_t level, size_t slot){
+        size_t bucket = level * slots + slot;
+        ProcessHandle h = head_[bucket];
+        head_[bucket] = invalid_process_handle;
+        tail_[bucket] = invalid_process_handle;
+        clear_slot(level, slot);
+        return h;
+    }
+
+    void clear_slot(size_t level, size_t slot){
+        bitmap_[level] &= ~(uint64_t(1) << slot);
+        if(bitmap_[level] == 0){
+            level_mask_ &= ~(uint32_t(1) << level);
+        }
+    }
+
+    template <typename Fire>
+    void fire_due(Fire& fire){
+        ProcessHandle h = head_[due_bucket];
+        if(h == invalid_process_handle){
+            return;
+        }
+        head_[due_bucket] = invalid_process_handle;
+        tail_[due_bucket] = invalid_process_handle;
+        next_valid_ = false;
+        while(h != invalid_process_handle){
+            ProcessHandle next = next_[h];
+            bucket_[h] = not_scheduled;
+            size_--;
+            fire(h, nanoseconds(expiry_[h]));
+            h = next;
+        }
+    }
+
+    int64_t find_next_expiry() const {
+        if(head_[due_bucket] != invalid_process_handle){
+            return now_;
+        }
+        if(level_mask_ == 0){
+            return INT64_MAX;
+        }
+        size_t level = static_cast<size_t>(std::countr_zero(level_mask_));
+        size_t slot = static_cast<size_t>(std::countr_zero(bitmap_[level]));
+        if(level == 0){
+            return slot_start(0, slot);
+        }
+        int64_t earliest = INT64_MAX;
+        for(ProcessHandle h = head_[level * slots + slot]; h != invalid_process_handle; h = next_[h]){
+            earliest = expiry_[h] < earliest ? expiry_[h] : earliest;
+        }
+        return earliest;
+    }
+};
+
+#endif
@@ -0,0 +1,252 @@
+#include "TraceFormat.h"
+
+#include <charconv>
+#include "Log.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool TraceWriter::open(const std::string& path, bool has_priority){
+    close();
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    if(!out_){
+        SCHED_LOG_ERROR("ERROR: Could not open trace file ", path, " for writing");
+        return false;
+    }
+
+    count_ = 0;
+    flags_ = has_priority ? trace_has_priority : 0;
+    buffer_.reserve(buffer_records);
+
+    // placeholder, the real header goes in once the record count is known
+    TraceHeader header{};
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    return static_cast<bool>(out_);
+}
+
+void TraceWriter::flush(){
+    if(buffer_.empty()){
+        return;
+    }
+    out_.write(reinterpret_cast<const char*>(buffer_.data()),
+               static_cast<std::streamsize>(buffer_.size() * sizeof(TraceRecord)));
+    count_ += buffer_.size();
+    buffer_.clear();
+}
+
+bool TraceWriter::close(){
+    if(!out_.is_open()){
+        return true;
+    }
+    flush();
+
+    TraceHeader header{};
+    std::memcpy(header.magic, trace_magic, sizeof(header.magic));
+    header.version = trace_version;
+    header.record_size = sizeof(TraceRecord);
+    header.record_count = count_;
+    header.flags = flags_;
+    out_.seekp(0);
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    bool ok = static_cast<bool>(out_);
+    out_.close();
+    if(!ok){
+        SCHED_LOG_ERROR("ERROR: Failed writing trace file");
+    }
+    return ok;
+}
+
+bool MappedTrace::open(const std::string& path){
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0){
+        SCHED_LOG_ERROR("ERROR: Could not open trace file ", path);
+        return false;
+    }
+
+    struct stat st{};
+    if(::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(TraceHeader)){
+        SCHED_LOG_ERROR("ERROR: ", path, " is too small to be a trace file");
+        ::close(fd);
+        return false;
+    }
+
+    size_t length = static_cast<size_t>(st.st_size);
+    void* data = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping keeps the file alive
+    ::close(fd);
+    if(data == MAP_FAILED){
+        SCHED_LOG_ERROR("ERROR: Could not mmap trace file ", path);
+        return false;
+    }
+    // records are read front to back, let the kernel read ahead aggressively
+    ::madvise(data, length, MADV_SEQUENTIAL);
+
+    TraceHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    const char* problem = nullptr;
+    if(std::memcmp(header.magic, trace_magic, sizeof(header.magic)) != 0){
+        problem = "bad magic";
+    } else if(header.version != trace_version){
+        problem = "unsupported version";
+    } else if(header.record_size != sizeof(TraceRecord)){
+        problem = "unexpected record size";
+    } else if(header.record_count > (length - sizeof(TraceHeader)) / sizeof(TraceRecord)){
+        problem = "file is shorter than its record count";
+    }
+    if(problem){
+        SCHED_LOG_ERROR("ERROR: ", path, " is not a valid trace (", problem, ")");
+        ::munmap(data, length);
+        return false;
+    }
+
+    data_ = data;
+    length_ = length;
+    records_ = static_cast<const unsigned char*>(data) + sizeof(TraceHeader);
+    count_ = static_cast<size_t>(header.record_count);
+    flags_ = header.flags;
+    return true;
+}
+
+void MappedTrace::close(){
+    if(data_){
+        ::munmap(data_, length_);
+    }
+    data_ = nullptr;
+    length_ = 0;
+    records_ = nullptr;
+    count_ = 0;
+    flags_ = 0;
+}
+
+namespace {
+
+// parse one comma separated integer field, advancing begin past the comma. anything but
+// a comma or the end of the line after the number is an error
+template <typename Int>
+bool parse_field(const char*& begin, const char* end, Int& value){
+    while(begin < end && (*begin == ' ' || *begin == '\t')){
+        ++begin;
+    }
+    auto [ptr, ec] = std::from_chars(begin, end, value);
+    if(ec != std::errc{}){
+        return false;
+    }
+    begin = ptr;
+    while(begin < end && (*begin == ' ' || *begin == '\t' || *begin == '\r')){
+        ++begin;
+    }
+    if(begin < end){
+        if(*begin != ','){
+            return false;
+        }
+        ++begin;
+    }
+    return true;
+}
+
+// a header row is a first line that doesn't even start with a number, anything else
+// that fails to parse is a bad record
+bool starts_with_number(const std::string& line){
+    const char* begin = line.data();
+    const char* end = begin + line.size();
+    while(begin < end && (*begin == ' ' || *begin == '\t')){
+        ++begin;
+    }
+    int64_t value = 0;
+    return std::from_chars(begin, end, value).ec == std::errc{};
+}
+
+} // namespace
+
+int64_t convert_csv_to_trace(const std::string& csv_path, const std::string& trace_path){
+    std::ifstream in(csv_path);
+    if(!in){
+        SCHED_LOG_ERROR("ERROR: Could not open CSV file ", csv_path);
+        return -1;
+    }
+
+    // the priority column is optional, the first record decides whether the trace has one
+    std::string line;
+    size_t line_number = 0;
+    bool has_priority = false;
+    bool seen_record = false;
+    bool seen_header = false;
+
+    TraceWriter writer;
+    // what is wrong with the line, nullptr when it is a good record
+    auto parse_line = [&](const std::string& text, TraceRecord& record, bool& priority) -> const char* {
+        const char* expected = "expected pid,arrival_ns,burst_ns[,priority]";
+        const char* begin = text.data();
+        const char* end = begin + text.size();
+        int64_t pid = 0;
+        if(!parse_field(begin, end, pid) || !parse_field(begin, end, record.arrival_ns)
+           || !parse_field(begin, end, record.burst_ns)){
+            return expected;
+        }
+        record.pid = static_cast<int32_t>(pid);
+        record.priority = 0;
+        priority = false;
+        if(begin < end){
+            int64_t value = 0;
+            if(!parse_field(begin, end, value)){
+                return expected;
+            }
+            record.priority = static_cast<int32_t>(value);
+            priority = true;
+        }
+        if(begin < end){
+            return "unexpected fields after priority";
+        }
+        if(record.arrival_ns < 0){
+            return "arrival_ns is negative";
+        }
+        if(record.burst_ns <= 0){
+            return "burst_ns must be positive";
+        }
+        return nullptr;
+    };
+
+    while(std::getline(in, line)){
+        line_number++;
+        if(line.empty() || line == "\r"){
+            continue;
+        }
+
+        TraceRecord record{};
+        bool priority = false;
+        if(const char* problem = parse_line(line, record, priority)){
+            if(!seen_record && !seen_header && !starts_with_number(line)){
+                // a header row, only the first line can be one
+                seen_header = true;
+                continue;
+            }
+            SCHED_LOG_ERROR("ERROR: ", csv_path, ":", line_number, ": ", problem);
+            return -1;
+        }
+
+        if(!seen_record){
+            has_priority = priority;
+            seen_record = true;
+            if(!writer.open(trace_path, has_priority)){
+                return -1;
+            }
+        }
+        writer.write(record);
+    }
+
+    if(!seen_record){
+        // most likely not this format at all, e.g. another separator
+        SCHED_LOG_ERROR("ERROR: ", csv_path, " has no pid,arrival_ns,burst_ns[,priority] records");
+        return -1;
+    }
+    int64_t written = static_cast<int64_t>(writer.records_written());
+    if(!writer.close()){
+        return -1;
+    }
+    return written;
+}
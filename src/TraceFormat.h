@@ -0,0 +1,136 @@
+#ifndef TRACE_FORMAT_H
+#define TRACE_FORMAT_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+// binary workload trace: a 32 byte header followed by fixed size little-endian records,
+// so a trace is read straight out of an mmap'd file with no parsing or allocation per
+// record. traces are written and read on the same kind of (little-endian) machine
+struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t record_count;
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+struct TraceRecord {
+    int32_t pid;
+    // only meaningful when the header has trace_has_priority set, 0 otherwise
+    int32_t priority;
+    int64_t arrival_ns;
+    int64_t burst_ns;
+};
+
+static_assert(sizeof(TraceHeader) == 32, "trace header layout is part of the file format");
+static_assert(sizeof(TraceRecord) == 24, "trace record layout is part of the file format");
+
+inline constexpr char trace_magic[8] = {'S', 'C', 'H', 'D', 'T', 'R', 'C', '1'};
+inline constexpr uint32_t trace_version = 1;
+inline constexpr uint32_t trace_has_priority = 1u << 0;
+
+// streams records into a trace file, the header's record count is filled in by close()
+class TraceWriter{
+public:
+    TraceWriter() = default;
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+    ~TraceWriter(){ close(); }
+
+    bool open(const std::string& path, bool has_priority = false);
+
+    void write(const TraceRecord& record){
+        buffer_.push_back(record);
+        if(buffer_.size() == buffer_records){
+            flush();
+        }
+    }
+
+    void write(int pid, nanoseconds arrival, nanoseconds burst, int priority = 0){
+        write(TraceRecord{pid, priority, arrival.count(), burst.count()});
+    }
+
+    // writes the header and closes the file, returns false if any write failed
+    bool close();
+
+    uint64_t records_written() const { return count_ + buffer_.size(); }
+
+private:
+    static constexpr size_t buffer_records = 1 << 16;
+
+    std::ofstream out_;
+    std::vector<TraceRecord> buffer_;
+    uint64_t count_ = 0;
+    uint32_t flags_ = 0;
+
+    void flush();
+};
+
+// read-only mmap of a trace file. records are copied out one at a time, so the file is
+// paged in sequentially by the kernel and never held in memory as a whole
+class MappedTrace{
+public:
+    MappedTrace() = default;
+    MappedTrace(const MappedTrace&) = delete;
+    MappedTrace& operator=(const MappedTrace&) = delete;
+    ~MappedTrace(){ close(); }
+
+    // logs the reason as an error and returns false if the file isn't a valid trace
+    bool open(const std::string& path);
+    void close();
+
+    bool is_open() const { return data_ != nullptr; }
+
+    size_t size() const { return count_; }
+
+    bool has_priority() const { return (flags_ & trace_has_priority) != 0; }
+
+    TraceRecord operator[](size_t index) const {
+        TraceRecord record;
+        std::memcpy(&record, records_ + index * sizeof(TraceRecord), sizeof(TraceRecord));
+        return record;
+    }
+
+    // visit every record in file order
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for(size_t i = 0; i < count_; ++i){
+            fn((*this)[i]);
+        }
+    }
+
+private:
+    void* data_ = nullptr;
+    size_t length_ = 0;
+    const unsigned char* records_ = nullptr;
+    size_t count_ = 0;
+    uint32_t flags_ = 0;
+};
+
+// feed every record of a trace into a scheduler through add_process(pid, arrival, burst, nice).
+// the priority column, when there is one, is the process's nice level
+template <typename Scheduler>
+size_t load_trace(const MappedTrace& trace, Scheduler& scheduler){
+    trace.for_each([&scheduler](const TraceRecord& record){
+        scheduler.add_process(record.pid, nanoseconds(record.arrival_ns), nanoseconds(record.burst_ns),
+                              record.priority);
+    });
+    return trace.size();
+}
+
+// convert "pid,arrival_ns,burst_ns[,priority]" lines into a binary trace. one header line
+// and blank lines are skipped. returns the number of records written, or -1 on error,
+// which includes a file without a single record, a negative arrival, a burst that isn't
+// positive and fields after the priority
+int64_t convert_csv_to_trace(const std::string& csv_path, const std::string& trace_path);
+
+#endif
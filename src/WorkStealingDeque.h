@@ -0,0 +1,125 @@
+#ifndef WORK_STEALING_DEQUE_H
+#define WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "RingBuffer.h"
+
+// Chase-Lev work-stealing deque (with the memory orderings from Le et al., "Correct and
+// Efficient Work-Stealing for Weak Memory Models"). the owning thread pushes and pops at
+// the bottom like a stack, any other thread steals from the top, and only the last item
+// is ever contended. T must be trivially copyable, e.g. a ProcessHandle
+template <typename T>
+class WorkStealingDeque{
+    struct Array {
+        const int64_t capacity;
+        const int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+
+        explicit Array(int64_t capacity)
+            : capacity(capacity), mask(capacity - 1), slots(new std::atomic<T>[static_cast<size_t>(capacity)]) {}
+
+        T get(int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, T item) { slots[i & mask].store(item, std::memory_order_relaxed); }
+    };
+
+    // thieves move top, the owner moves bottom, keep them on separate lines
+    alignas(cache_line_size) std::atomic<int64_t> top_{0};
+    alignas(cache_line_size) std::atomic<int64_t> bottom_{0};
+    alignas(cache_line_size) std::atomic<Array*> array_;
+
+    // arrays outgrown by push, a thief may still be reading one so they live as long as the deque
+    std::vector<std::unique_ptr<Array>> arrays_;
+
+    Array* grow(Array* old, int64_t bottom, int64_t top){
+        auto bigger = std::make_unique<Array>(old->capacity * 2);
+        for(int64_t i = top; i < bottom; ++i){
+            bigger->put(i, old->get(i));
+        }
+        Array* next = bigger.get();
+        arrays_.push_back(std::move(bigger));
+        array_.store(next, std::memory_order_release);
+        return next;
+    }
+
+public:
+    explicit WorkStealingDeque(size_t capacity = 64){
+        arrays_.push_back(std::make_unique<Array>(static_cast<int64_t>(ring_capacity_for(capacity))));
+        array_.store(arrays_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // approximate unless called from the owner
+    size_t size() const {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        int64_t top = top_.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    size_t capacity() const { return static_cast<size_t>(array_.load(std::memory_order_relaxed)->capacity); }
+
+    // owner only, grows instead of failing
+    void push(T item){
+        int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        int64_t top = top_.load(std::memory_order_acquire);
+        Array* array = array_.load(std::memory_order_relaxed);
+        if(bottom - top > array->capacity - 1){
+            array = grow(array, bottom, top);
+        }
+        array->put(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    // owner only, newest item first
+    bool pop(T& out){
+        int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Array* array = array_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+
+        if(top > bottom){
+            // empty, undo the claim
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        out = array->get(bottom);
+        if(top == bottom){
+            // last item, race the thieves for it
+            bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // any thread, oldest item first. false if empty or another thread got there first
+    bool steal(T& out){
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = bottom_.load(std::memory_order_acquire);
+        if(top >= bottom){
+            return false;
+        }
+
+        Array* array = array_.load(std::memory_order_acquire);
+        T item = array->get(top);
+        if(!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)){
+            return false;
+        }
+        out = item;
+        return true;
+    }
+};
+
+#endif
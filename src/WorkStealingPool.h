@@ -0,0 +1,157 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "RingBuffer.h"
+#include "WorkStealingDeque.h"
+
+// fixed set of worker threads, each with its own Chase-Lev deque. work submitted from
+// outside lands in a shared injection queue; a worker with nothing local takes a batch
+// from it into its own deque, and a worker with nothing at all steals from the others.
+// every item is handed to handler(item, worker_index) on one of the workers
+template <typename T>
+class WorkStealingPool{
+public:
+    using Handler = std::function<void(T, size_t)>;
+
+    // how many items a worker moves from the injection queue into its deque at once
+    static constexpr size_t injection_batch = 8;
+
+    WorkStealingPool(size_t workers, size_t injection_capacity, Handler handler)
+        : injection_(injection_capacity), handler_(std::move(handler))
+    {
+        size_t count = workers > 0 ? workers : 1;
+        for(size_t i = 0; i < count; ++i){
+            deques_.push_back(std::make_unique<WorkStealingDeque<T>>());
+        }
+        threads_.reserve(count);
+        for(size_t i = 0; i < count; ++i){
+            threads_.emplace_back([this, i]{ worker_loop(i); });
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool(){
+        shutdown();
+    }
+
+    // from any thread, false if the injection queue is full
+    bool submit(T item){
+        if(!injection_.enqueue(item)){
+            return false;
+        }
+        // sleeping_ is bumped before a worker checks the queue, so either it sees the item or we see it
+        if(sleeping_.load() > 0){
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            sleep_cv_.notify_one();
+        }
+        return true;
+    }
+
+    // finishes whatever is queued, then joins the workers
+    void shutdown(){
+        if(stopping_.exchange(true)){
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            sleep_cv_.notify_all();
+        }
+        for(std::thread& thread : threads_){
+            thread.join();
+        }
+    }
+
+    size_t worker_count() const { return deques_.size(); }
+
+    // items taken from another worker's deque
+    uint64_t steals() const { return steals_.load(); }
+
+private:
+    MPMCRingBuffer<T> injection_;
+    std::vector<std::unique_ptr<WorkStealingDeque<T>>> deques_;
+    std::vector<std::thread> threads_;
+    Handler handler_;
+
+    std::atomic<bool> stopping_ = false;
+    std::atomic<uint64_t> steals_ = 0;
+
+    // idle workers park here instead of spinning
+    std::atomic<size_t> sleeping_ = 0;
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+
+    static constexpr int spins_before_sleep = 64;
+
+    bool find_work(size_t self, T& out){
+        WorkStealingDeque<T>& own = *deques_[self];
+        if(own.pop(out)){
+            return true;
+        }
+
+        // refill from the injection queue, keeping the rest of the batch stealable
+        T batch[injection_batch];
+        size_t taken = injection_.dequeue_n(batch, injection_batch);
+        if(taken > 0){
+            // pushed newest first so the owner pops them in submission order
+            for(size_t i = taken; i-- > 1;){
+                own.push(batch[i]);
+            }
+            out = batch[0];
+            return true;
+        }
+
+        // steal from the others, starting after ourselves so victims are spread out
+        for(size_t i = 1; i < deques_.size(); ++i){
+            size_t victim = (self + i) % deques_.size();
+            if(deques_[victim]->steal(out)){
+                steals_++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void worker_loop(size_t self){
+        int idle_spins = 0;
+        T item;
+        while(true){
+            if(find_work(self, item)){
+                idle_spins = 0;
+                handler_(item, self);
+                continue;
+            }
+
+            if(stopping_.load() && injection_.empty()){
+                // other deques are drained by their owners
+                return;
+            }
+
+            if(++idle_spins < spins_before_sleep){
+                std::this_thread::yield();
+                continue;
+            }
+
+            sleeping_++;
+            {
+                std::unique_lock<std::mutex> lock(sleep_mutex_);
+                sleep_cv_.wait(lock, [this]{ return stopping_.load() || !injection_.empty(); });
+            }
+            sleeping_--;
+            idle_spins = 0;
+        }
+    }
+};
+
+#endif
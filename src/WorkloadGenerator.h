@@ -0,0 +1,276 @@
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "TraceFormat.h"
+
+using namespace std::chrono;
+
+// how processes arrive over time
+enum class ArrivalPattern {
+    // homogeneous Poisson process, exponential gaps with mean mean_interarrival
+    Poisson,
+    // two state Markov modulated Poisson process: calm periods at the base rate and
+    // bursts at burst_rate_multiplier times the base rate
+    Bursty,
+    // Poisson with a rate that follows a sine wave over diurnal_period
+    Diurnal
+};
+
+// how long each process runs
+enum class BurstDistribution {
+    // exponential with mean mean_burst
+    Exponential,
+    // heavy tailed Pareto with shape pareto_alpha, scaled so the mean is mean_burst (alpha > 1)
+    Pareto,
+    // short_burst most of the time, long_burst with probability long_fraction
+    Bimodal
+};
+
+struct WorkloadConfig {
+    uint64_t seed = 1;
+
+    ArrivalPattern arrivals = ArrivalPattern::Poisson;
+    nanoseconds mean_interarrival = 100ns;
+
+    // Bursty
+    double burst_rate_multiplier = 10.0;
+    nanoseconds mean_calm_period = 100000ns;
+    nanoseconds mean_burst_period = 10000ns;
+
+    // Diurnal, the rate swings between (1 - amplitude) and (1 + amplitude) times the base rate
+    nanoseconds diurnal_period = 86400000ns;
+    double diurnal_amplitude = 0.5;
+
+    BurstDistribution bursts = BurstDistribution::Exponential;
+    nanoseconds mean_burst = 50ns;
+
+    // Pareto
+    double pareto_alpha = 1.5;
+
+    // Bimodal
+    nanoseconds short_burst = 10ns;
+    nanoseconds long_burst = 1000ns;
+    double long_fraction = 0.1;
+
+    // every burst is clamped to [1ns, max_burst] so heavy tails can't overflow the clock
+    nanoseconds max_burst = nanoseconds(1000000000000);
+
+    // I/O bound processes, see WorkloadGenerator::next_io. a fraction io_fraction of them
+    // splits its burst into io_bursts + 1 equal cpu bursts with exponential I/O waits of
+    // mean mean_io in between
+    double io_fraction = 0.0;
+    size_t io_bursts = 4;
+    nanoseconds mean_io = 1000ns;
+};
+
+// seeded generator of (pid, arrival, burst) triples. it uses its own xoshiro256** and
+// inverse transform sampling instead of <random> distributions, so the same seed gives
+// the same workload with any standard library. pids count up from 0 and arrivals
+// never go backwards
+class WorkloadGenerator{
+public:
+    explicit WorkloadGenerator(const WorkloadConfig& config) : config_(config) {
+        // splitmix64 to spread the seed over the whole state
+        uint64_t x = config.seed;
+        for(uint64_t& word : state_){
+            x += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = x;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+
+        base_rate_ = 1.0 / static_cast<double>(std::max<int64_t>(config.mean_interarrival.count(), 1));
+        if(config_.arrivals == ArrivalPattern::Bursty){
+            state_end_ = exponential(static_cast<double>(config_.mean_calm_period.count()));
+        }
+        if(config_.bursts == BurstDistribution::Pareto){
+            double alpha = config_.pareto_alpha > 1.0 ? config_.pareto_alpha : 1.0 + 1e-9;
+            pareto_scale_ = static_cast<double>(config_.mean_burst.count()) * (alpha - 1.0) / alpha;
+            pareto_inv_alpha_ = 1.0 / alpha;
+        }
+    }
+
+    TraceRecord next(){
+        now_ += next_gap();
+        TraceRecord record{};
+        record.pid = static_cast<int32_t>(next_pid_++);
+        record.arrival_ns = static_cast<int64_t>(now_);
+        record.burst_ns = next_burst();
+        return record;
+    }
+
+    // call sink(pid, arrival, burst) for the next n processes
+    template <typename Sink>
+    void generate(size_t n, Sink&& sink){
+        for(size_t i = 0; i < n; ++i){
+            TraceRecord record = next();
+            sink(static_cast<int>(record.pid), nanoseconds(record.arrival_ns), nanoseconds(record.burst_ns));
+        }
+    }
+
+    // the cpu and I/O bursts of a process with the given total burst, in the order
+    // ProcessTable::set_bursts takes them. false, with bursts empty, for a cpu bound
+    // process. it draws from the same stream as next(), so call it right after each next()
+    // to get the same workload from the same seed. draws nothing while io_fraction is 0
+    bool next_io(nanoseconds burst, std::vector<nanoseconds>& bursts){
+        bursts.clear();
+        if(config_.io_fraction <= 0.0 || uniform() > config_.io_fraction){
+            return false;
+        }
+        // every cpu burst needs at least 1ns
+        int64_t waits = std::min<int64_t>(static_cast<int64_t>(config_.io_bursts), burst.count() - 1);
+        if(waits <= 0){
+            return false;
+        }
+        int64_t cpu = burst.count() / (waits + 1);
+        int64_t extra = burst.count() % (waits + 1);
+        double mean_io = static_cast<double>(config_.mean_io.count());
+        for(int64_t i = 0; i <= waits; ++i){
+            bursts.push_back(nanoseconds(cpu + (i < extra ? 1 : 0)));
+            if(i < waits){
+                bursts.push_back(nanoseconds(std::llround(exponential(mean_io))));
+            }
+        }
+        return true;
+    }
+
+    const WorkloadConfig& config() const { return config_; }
+
+private:
+    WorkloadConfig config_;
+    uint64_t state_[4];
+
+    // arrival clock kept in floating point so sub-nanosecond gaps add up correctly
+    double now_ = 0.0;
+    uint64_t next_pid_ = 0;
+    double base_rate_ = 0.0;
+
+    // Bursty: which state we are in and when it ends
+    bool in_burst_ = false;
+    double state_end_ = 0.0;
+
+    double pareto_scale_ = 0.0;
+    double pareto_inv_alpha_ = 0.0;
+
+    static uint64_t rotl(uint64_t x, int k){
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t next_u64(){
+        uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+    // uniform in (0, 1], never 0 so it is safe to take the log of
+    double uniform(){
+        return (static_cast<double>(next_u64() >> 11) + 1.0) * 0x1.0p-53;
+    }
+
+    double exponential(double mean){
+        return -std::log(uniform()) * mean;
+    }
+
+    double next_gap(){
+        switch(config_.arrivals){
+        case ArrivalPattern::Poisson:
+            return exponential(1.0 / base_rate_);
+
+        case ArrivalPattern::Bursty: {
+            // gaps are memoryless, so when a state ends before the next arrival we can
+            // jump to the switch and draw again at the new rate
+            double t = now_;
+            while(true){
+                double rate = in_burst_ ? base_rate_ * config_.burst_rate_multiplier : base_rate_;
+                double candidate = t + exponential(1.0 / rate);
+                if(candidate < state_end_){
+                    return candidate - now_;
+                }
+                t = state_end_;
+                in_burst_ = !in_burst_;
+                double period = in_burst_ ? config_.mean_burst_period.count() : config_.mean_calm_period.count();
+                state_end_ = t + exponential(period);
+            }
+        }
+
+        case ArrivalPattern::Diurnal: {
+            // thinning: draw at the peak rate and keep each candidate with probability rate(t) / peak
+            constexpr double two_pi = 6.283185307179586;
+            double amplitude = std::clamp(config_.diurnal_amplitude, 0.0, 1.0);
+            double period = static_cast<double>(std::max<int64_t>(config_.diurnal_period.count(), 1));
+            double peak = base_rate_ * (1.0 + amplitude);
+            double t = now_;
+            while(true){
+                t += exponential(1.0 / peak);
+                double rate = base_rate_ * (1.0 + amplitude * std::sin(two_pi * t / period));
+                if(uniform() * peak <= rate){
+                    return t - now_;
+                }
+            }
+        }
+        }
+        return 0.0;
+    }
+
+    int64_t next_burst(){
+        double burst = 0.0;
+        switch(config_.bursts){
+        case BurstDistribution::Exponential:
+            burst = exponential(static_cast<double>(config_.mean_burst.count()));
+            break;
+        case BurstDistribution::Pareto:
+            burst = pareto_scale_ / std::pow(uniform(), pareto_inv_alpha_);
+            break;
+        case BurstDistribution::Bimodal:
+            burst = uniform() <= config_.long_fraction ? static_cast<double>(config_.long_burst.count())
+                                                       : static_cast<double>(config_.short_burst.count());
+            break;
+        }
+
+        double upper = static_cast<double>(config_.max_burst.count());
+        if(!(burst < upper)){
+            return config_.max_burst.count();
+        }
+        return std::max<int64_t>(static_cast<int64_t>(std::llround(burst)), 1);
+    }
+};
+
+// generate n processes straight into a scheduler's storage
+template <typename Scheduler>
+void generate_into(Scheduler& scheduler, const WorkloadConfig& config, size_t n){
+    scheduler.reserve(n);
+    WorkloadGenerator generator(config);
+    generator.generate(n, [&scheduler](int pid, nanoseconds arrival, nanoseconds burst){
+        scheduler.add_process(pid, arrival, burst);
+    });
+}
+
+// generate n processes into a trace file, false if it couldn't be written
+inline bool generate_trace(const std::string& path, const WorkloadConfig& config, size_t n){
+    TraceWriter writer;
+    if(!writer.open(path)){
+        return false;
+    }
+    WorkloadGenerator generator(config);
+    for(size_t i = 0; i < n; ++i){
+        writer.write(generator.next());
+    }
+    return writer.close();
+}
+
+#endif
@@ -1,6 +1,643 @@
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <span>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
-int main() {
-    std::cout << "hello world";
+#include "Admission.h"
+#include "EventTracer.h"
+#include "Log.h"
+#include "FCFSScheduler.h"
+#include "SJFScheduler.h"
+#include "RoundRobinScheduler.h"
+#include "SRTFScheduler.h"
+#include "MLFQScheduler.h"
+#include "FairScheduler.h"
+#include "ProportionalShareScheduler.h"
+#include "MultiCoreScheduler.h"
+#include "ParameterSweep.h"
+#include "Telemetry.h"
+#include "TraceFormat.h"
+#include "WorkloadGenerator.h"
+
+namespace {
+
+void print_usage(const char* program){
+    std::cerr << "usage: " << program << " --trace FILE [--policy fcfs|sjf|rr|srtf|mlfq|cfs|eevdf|lottery|stride] [--capacity N]"
+              << " [--quantum NS] [--boost NS] [--cores N]"
+              << " [--admission defer|reject|shed-oldest|shed-longest] [--backlog N]"
+              << " [--io-fraction F] [--io-bursts N] [--io-time NS] [--producers N]\n"
+              << "       " << program << " --convert CSV_FILE TRACE_FILE\n"
+              << "       " << program << " --generate N TRACE_FILE [--seed S] [--arrivals poisson|bursty|diurnal]"
+              << " [--bursts exponential|pareto|bimodal]\n"
+              << "       " << program << " --sweep [--policies P,P,...] [--capacities N,N,...] [--quanta NS,NS,...]"
+              << " [--seeds N] [--processes N] [--threads N] [--csv FILE] [--trace FILE]\n"
+              << "options: [--log-level trace|debug|info|warn|error|off] [--async-log]"
+              << " [--chrome-trace JSON_FILE] [--trace-events N] [--profile] [--hw-counters]\n"
+              << "         [--telemetry CSV_OR_BIN_FILE] [--window NS] [--telemetry-windows N]\n"
+              << "CSV lines are pid,arrival_ns,burst_ns[,priority], one header row is skipped. priority is the nice level" << std::endl;
+}
+
+bool parse_number(std::string_view text, long long& value){
+    char* end = nullptr;
+    std::string copy(text);
+    value = std::strtoll(copy.c_str(), &end, 10);
+    return end != copy.c_str() && *end == '\0' && value > 0;
+}
+
+// like parse_number, but 0 is allowed too
+bool parse_non_negative(std::string_view text, long long& value){
+    char* end = nullptr;
+    std::string copy(text);
+    value = std::strtoll(copy.c_str(), &end, 10);
+    return end != copy.c_str() && *end == '\0' && value >= 0;
+}
+
+// a fraction in [0, 1]
+bool parse_fraction(std::string_view text, double& value){
+    char* end = nullptr;
+    std::string copy(text);
+    value = std::strtod(copy.c_str(), &end);
+    return end != copy.c_str() && *end == '\0' && value >= 0.0 && value <= 1.0;
+}
+
+// comma separated positive numbers, e.g. "64,1024"
+bool parse_number_list(std::string_view text, std::vector<long long>& values){
+    values.clear();
+    while(!text.empty()){
+        size_t comma = text.find(',');
+        long long value = 0;
+        if(!parse_number(text.substr(0, comma), value)){
+            return false;
+        }
+        values.push_back(value);
+        text = comma == std::string_view::npos ? std::string_view{} : text.substr(comma + 1);
+    }
+    return !values.empty();
+}
+
+// indexed by LogLevel
+constexpr std::string_view log_level_names[] = {"trace", "debug", "info", "warn", "error", "off"};
+
+bool parse_log_level(std::string_view text, LogLevel& level){
+    for(size_t i = 0; i < std::size(log_level_names); ++i){
+        if(text == log_level_names[i]){
+            level = static_cast<LogLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// where to write a timeline of the run, if anywhere
+struct TimelineOptions {
+    std::string path;
+    // per cpu, the oldest events are overwritten past this
+    size_t events = 1 << 22;
+    size_t cpus = 1;
+    // print the per phase profile, and count hardware events in it
+    bool profile = false;
+    bool hardware_counters = false;
+    // windowed time series of the run, csv if the path ends in .csv and binary columns otherwise
+    std::string telemetry_path;
+    nanoseconds window = 1ms;
+    // the latest this many windows are kept
+    size_t telemetry_windows = 1 << 16;
+};
+
+bool ends_with(std::string_view text, std::string_view suffix){
+    return text.size() >= suffix.size() && text.substr(text.size() - suffix.size()) == suffix;
+}
+
+// how the single core engine treats the workload
+struct RunOptions {
+    AdmissionConfig admission;
+    // I/O bursts are drawn for the traced processes when io.io_fraction > 0, seeded by --seed
+    WorkloadConfig io;
+    // replay the trace online from this many producer threads, 0 loads it up front
+    size_t producers = 0;
+};
+
+// submit every record of the trace to a running run_online(), round robin over the
+// producer threads. records arrive when the loop takes them in, their arrival times are ignored
+template <typename Scheduler>
+void replay_online(Scheduler& scheduler, const MappedTrace& trace, size_t producers){
+    scheduler.open_intake();
+    std::thread loop([&scheduler]{ scheduler.run_online(); });
+    std::vector<std::thread> threads;
+    for(size_t t = 0; t < producers; ++t){
+        threads.emplace_back([&scheduler, &trace, producers, t]{
+            for(size_t i = t; i < trace.size(); i += producers){
+                TraceRecord record = trace[i];
+                scheduler.submit(record.pid, nanoseconds(record.burst_ns), record.priority);
+            }
+        });
+    }
+    for(std::thread& thread : threads){
+        thread.join();
+    }
+    scheduler.shutdown();
+    loop.join();
+}
+
+template <typename Scheduler>
+int run(Scheduler& scheduler, const MappedTrace& trace, const TimelineOptions& timeline,
+        const RunOptions& options){
+    constexpr bool has_online = requires{ scheduler.run_online(); };
+    bool online = options.producers > 0 && has_online;
+    if(options.producers > 0 && !has_online){
+        std::cerr << "WARNING: --producers only covers single core simulations" << std::endl;
+    }
+    if(online && options.io.io_fraction > 0.0){
+        std::cerr << "WARNING: --io-fraction is ignored with --producers, submitted processes are cpu only" << std::endl;
+    }
+
+    constexpr bool has_io = requires(std::span<const nanoseconds> bursts){ scheduler.add_process(0, 0ns, bursts, 0); };
+    if(online){
+        // nothing up front, the producers submit the trace once the run has started
+    } else if(options.io.io_fraction > 0.0 && has_io){
+        scheduler.reserve(trace.size());
+        if constexpr(has_io){
+            WorkloadGenerator generator(options.io);
+            std::vector<nanoseconds> bursts;
+            trace.for_each([&](const TraceRecord& record){
+                nanoseconds arrival(record.arrival_ns);
+                if(generator.next_io(nanoseconds(record.burst_ns), bursts)){
+                    scheduler.add_process(record.pid, arrival, bursts, record.priority);
+                } else {
+                    scheduler.add_process(record.pid, arrival, nanoseconds(record.burst_ns), record.priority);
+                }
+            });
+        }
+    } else {
+        if(options.io.io_fraction > 0.0){
+            std::cerr << "WARNING: --io-fraction only covers single core simulations" << std::endl;
+        }
+        scheduler.reserve(trace.size());
+        load_trace(trace, scheduler);
+    }
+
+    if constexpr(requires{ scheduler.set_admission(options.admission); }){
+        scheduler.set_admission(options.admission);
+    } else if(options.admission.policy != AdmissionPolicy::Defer){
+        std::cerr << "WARNING: --admission only covers single core simulations" << std::endl;
+    }
+
+    std::unique_ptr<EventTracer> tracer;
+    if(!timeline.path.empty()){
+        tracer = std::make_unique<EventTracer>(timeline.cpus, timeline.events);
+        scheduler.set_tracer(tracer.get());
+    }
+
+    std::unique_ptr<WindowedTelemetry> telemetry;
+    if(!timeline.telemetry_path.empty()){
+        if constexpr(requires{ scheduler.set_telemetry(nullptr); }){
+            telemetry = std::make_unique<WindowedTelemetry>(timeline.window, timeline.telemetry_windows);
+            scheduler.set_telemetry(telemetry.get());
+        } else {
+            std::cerr << "WARNING: --telemetry only covers single core simulations" << std::endl;
+        }
+    }
+
+    if constexpr(requires{ scheduler.get_profile(); }){
+        if(timeline.hardware_counters && !scheduler.enable_hardware_counters()){
+            std::cerr << "WARNING: hardware counters are not available, timing phases only" << std::endl;
+        }
+    }
+
+    if constexpr(has_online){
+        if(online){
+            replay_online(scheduler, trace, options.producers);
+        } else {
+            scheduler.run_simulation();
+        }
+    } else {
+        scheduler.run_simulation();
+    }
+    scheduler.get_stats().print();
+
+    if(timeline.profile){
+        if constexpr(requires{ scheduler.get_profile(); }){
+            scheduler.get_profile().print();
+        } else {
+            std::cerr << "WARNING: --profile only covers single core simulations" << std::endl;
+        }
+    }
+
+    if(tracer){
+        uint64_t overwritten = 0;
+        for(size_t b = 0; b < tracer->buffer_count(); ++b){
+            overwritten += tracer->overwritten(b);
+        }
+        if(overwritten > 0){
+            std::cerr << "WARNING: " << overwritten << " of " << tracer->total_recorded()
+                      << " events were overwritten, raise --trace-events to keep all of them" << std::endl;
+        }
+        if(!write_chrome_trace(*tracer, timeline.path)){
+            return 1;
+        }
+        std::cout << "Wrote timeline to " << timeline.path << std::endl;
+    }
+
+    if(telemetry){
+        if(telemetry->overwritten() > 0){
+            std::cerr << "WARNING: the first " << telemetry->overwritten() << " windows were overwritten,"
+                      << " raise --telemetry-windows or --window to keep all of them" << std::endl;
+        }
+        bool written = ends_with(timeline.telemetry_path, ".csv")
+            ? write_telemetry_csv(*telemetry, timeline.telemetry_path)
+            : write_telemetry_columns(*telemetry, timeline.telemetry_path);
+        if(!written){
+            return 1;
+        }
+        std::cout << "Wrote " << telemetry->size() << " windows to " << timeline.telemetry_path << std::endl;
+    }
     return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string policy = "fcfs";
+    std::string trace_path;
+    long long capacity = 1024;
+    long long quantum = 10;
+    long long boost = 1000;
+    long long cores = 1;
+    long long generate_count = 0;
+    std::string generate_path;
+    WorkloadConfig workload;
+    LogLevel log_level = Logger::level();
+    bool async_log = false;
+    TimelineOptions timeline;
+    bool sweep = false;
+    std::vector<std::string> sweep_policies;
+    std::vector<long long> sweep_capacities;
+    std::vector<long long> sweep_quanta;
+    long long sweep_seeds = 1;
+    long long sweep_processes = 10000;
+    long long sweep_threads = 0;
+    std::string sweep_csv;
+    RunOptions options;
+
+    for(int i = 1; i < argc; ++i){
+        std::string_view arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if(arg == "--convert"){
+            if(i + 2 >= argc){
+                print_usage(argv[0]);
+                return 1;
+            }
+            int64_t records = convert_csv_to_trace(argv[i + 1], argv[i + 2]);
+            if(records < 0){
+                return 1;
+            }
+            std::cout << "Wrote " << records << " records to " << argv[i + 2] << std::endl;
+            return 0;
+        } else if(arg == "--generate" && i + 2 < argc){
+            if(!parse_number(argv[++i], generate_count)){
+                std::cerr << "ERROR: --generate expects a positive number of processes" << std::endl;
+                return 1;
+            }
+            generate_path = argv[++i];
+        } else if(arg == "--seed" && has_value){
+            long long seed = 0;
+            if(!parse_non_negative(argv[++i], seed)){
+                std::cerr << "ERROR: --seed expects a non-negative number" << std::endl;
+                return 1;
+            }
+            workload.seed = static_cast<uint64_t>(seed);
+        } else if(arg == "--arrivals" && has_value){
+            std::string_view pattern = argv[++i];
+            if(pattern == "poisson"){
+                workload.arrivals = ArrivalPattern::Poisson;
+            } else if(pattern == "bursty"){
+                workload.arrivals = ArrivalPattern::Bursty;
+            } else if(pattern == "diurnal"){
+                workload.arrivals = ArrivalPattern::Diurnal;
+            } else {
+                std::cerr << "ERROR: unknown arrival pattern " << pattern << std::endl;
+                return 1;
+            }
+        } else if(arg == "--bursts" && has_value){
+            std::string_view distribution = argv[++i];
+            if(distribution == "exponential"){
+                workload.bursts = BurstDistribution::Exponential;
+            } else if(distribution == "pareto"){
+                workload.bursts = BurstDistribution::Pareto;
+            } else if(distribution == "bimodal"){
+                workload.bursts = BurstDistribution::Bimodal;
+            } else {
+                std::cerr << "ERROR: unknown burst distribution " << distribution << std::endl;
+                return 1;
+            }
+        } else if(arg == "--log-level" && has_value){
+            if(!parse_log_level(argv[++i], log_level)){
+                std::cerr << "ERROR: --log-level expects trace, debug, info, warn, error or off" << std::endl;
+                return 1;
+            }
+        } else if(arg == "--chrome-trace" && has_value){
+            timeline.path = argv[++i];
+        } else if(arg == "--trace-events" && has_value){
+            long long events = 0;
+            if(!parse_number(argv[++i], events)){
+                std::cerr << "ERROR: --trace-events expects a positive number" << std::endl;
+                return 1;
+            }
+            timeline.events = static_cast<size_t>(events);
+        } else if(arg == "--telemetry" && has_value){
+            timeline.telemetry_path = argv[++i];
+        } else if(arg == "--window" && has_value){
+            long long window = 0;
+            if(!parse_number(argv[++i], window)){
+                std::cerr << "ERROR: --window expects a positive number of nanoseconds" << std::endl;
+                return 1;
+            }
+            timeline.window = nanoseconds(window);
+        } else if(arg == "--telemetry-windows" && has_value){
+            long long windows = 0;
+            if(!parse_number(argv[++i], windows)){
+                std::cerr << "ERROR: --telemetry-windows expects a positive number" << std::endl;
+                return 1;
+            }
+            timeline.telemetry_windows = static_cast<size_t>(windows);
+        } else if(arg == "--sweep"){
+            sweep = true;
+        } else if(arg == "--policies" && has_value){
+            std::string_view list = argv[++i];
+            while(!list.empty()){
+                size_t comma = list.find(',');
+                sweep_policies.emplace_back(list.substr(0, comma));
+                if(!is_sweep_policy(sweep_policies.back())){
+                    std::cerr << "ERROR: unknown policy " << sweep_policies.back() << std::endl;
+                    return 1;
+                }
+                list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+            }
+        } else if(arg == "--capacities" && has_value){
+            if(!parse_number_list(argv[++i], sweep_capacities)){
+                std::cerr << "ERROR: --capacities expects positive numbers separated by commas" << std::endl;
+                return 1;
+            }
+        } else if(arg == "--quanta" && has_value){
+            if(!parse_number_list(argv[++i], sweep_quanta)){
+                std::cerr << "ERROR: --quanta expects positive numbers of nanoseconds separated by commas" << std::endl;
+                return 1;
+            }
+        } else if(arg == "--seeds" && has_value){
+            if(!parse_number(argv[++i], sweep_seeds)){
+                std::cerr << "ERROR: --seeds expects a positive number" << std::endl;
+                return 1;
+            }
+        } else if(arg == "--processes" && has_value){
+            if(!parse_number(argv[++i], sweep_processes)){
+                std::cerr << "ERROR: --processes expects a positive number" << std::endl;
+                return 1;
+            }
+        } else if(arg == "--threads" && has_value){
+            if(!parse_number(argv[++i], sweep_threads)){
+                std::cerr << "ERROR: --threads expects a positive number" << std::endl;
+                return 1;
+            }
+        } else if(arg == "--csv" && has_value){
+            sweep_csv = argv[++i];
+        } else if(arg == "--profile"){
+            timeline.profile = true;
+        } else if(arg == "--hw-counters"){
+            timeline.profile = true;
+            timeline.hardware_counters = true;
+        } else if(arg == "--async-log"){
+            async_log = true;
+        } else if(arg == "--policy" && has_value){
+            policy = argv[++i];
+        } else if(arg == "--trace" && has_value){
+            trace_path = argv[++i];
+        } else if(arg == "--capacity" && has_value){
+            if(!parse_number(argv[++i], capacity)){
+                std::cerr << "ERROR: --capacity expects a positive number" << std::endl;
+                return 1;
+            }
+        } else if(arg == "--quantum" && has_value){
+            if(!parse_number(argv[++i], quantum)){
+                std::cerr << "ERROR: --quantum expects a positive number of nanoseconds" << std::endl;
+                return 1;
+            }
+        } else if(arg == "--boost" && has_value){
+            // 0 turns boosts off
+            if(!parse_non_negative(argv[++i], boost)){
+                std::cerr << "ERROR: --boost expects a non-negative number of nanoseconds" << std::endl;
+                return 1;
+            }
+        } else if(arg == "--admission" && has_value){
+            if(!parse_admission_policy(argv[++i], options.admission.policy)){
+                std::cerr << "ERROR: --admission expects defer, reject, shed-oldest or shed-longest" << std::endl;
+                return 1;
+            }
+        } else if(arg == "--backlog" && has_value){
+            long long backlog = 0;
+            // 0 leaves no waiting room, every arrival to a full queue is shed
+            if(!parse_non_negative(argv[++i], backlog)){
+                std::cerr << "ERROR: --backlog expects a non-negative number" << std::endl;
+                return 1;
+            }
+            options.admission.backlog_capacity = static_cast<size_t>(backlog);
+        } else if(arg == "--io-fraction" && has_value){
+            if(!parse_fraction(argv[++i], workload.io_fraction)){
+                std::cerr << "ERROR: --io-fraction expects a number between 0 and 1" << std::endl;
+                return 1;
+            }
+        } else if(arg == "--io-bursts" && has_value){
+            long long bursts = 0;
+            if(!parse_number(argv[++i], bursts)){
+                std::cerr << "ERROR: --io-bursts expects a positive number" << std::endl;
+                return 1;
+            }
+            workload.io_bursts = static_cast<size_t>(bursts);
+        } else if(arg == "--io-time" && has_value){
+            long long io_time = 0;
+            if(!parse_number(argv[++i], io_time)){
+                std::cerr << "ERROR: --io-time expects a positive number of nanoseconds" << std::endl;
+                return 1;
+            }
+            workload.mean_io = nanoseconds(io_time);
+        } else if(arg == "--producers" && has_value){
+            long long producers = 0;
+            if(!parse_number(argv[++i], producers)){
+                std::cerr << "ERROR: --producers expects a positive number of threads" << std::endl;
+                return 1;
+            }
+            options.producers = static_cast<size_t>(producers);
+        } else if(arg == "--cores" && has_value){
+            if(!parse_number(argv[++i], cores)){
+                std::cerr << "ERROR: --cores expects a positive number" << std::endl;
+                return 1;
+            }
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if(log_level < Logger::compiled_level()){
+        std::cerr << "WARNING: this build only has log messages at "
+                  << log_level_names[static_cast<int>(Logger::compiled_level())] << " and above, rebuild with -DSCHEDULER_LOG_LEVEL for more" << std::endl;
+    }
+    if(timeline.profile && !SCHEDULER_PROFILE){
+        std::cerr << "WARNING: this build has no phase profiling, rebuild with -DSCHEDULER_PROFILE=ON" << std::endl;
+    }
+    Logger::set_level(log_level);
+    if(async_log){
+        Logger::start_async();
+        // drains whatever is still queued however main returns
+        std::atexit([]{ Logger::stop_async(); });
+    }
+
+    if(generate_count > 0){
+        if(!generate_trace(generate_path, workload, static_cast<size_t>(generate_count))){
+            return 1;
+        }
+        std::cout << "Wrote " << generate_count << " generated processes to " << generate_path << std::endl;
+        return 0;
+    }
+
+    if(sweep){
+        // anything not listed falls back to the single run options
+        SweepSpec spec;
+        spec.policies = sweep_policies.empty() ? std::vector<std::string>{policy} : sweep_policies;
+        spec.queue_capacities.clear();
+        for(long long value : sweep_capacities.empty() ? std::vector<long long>{capacity} : sweep_capacities){
+            spec.queue_capacities.push_back(static_cast<int>(value));
+        }
+        spec.quanta.clear();
+        for(long long value : sweep_quanta.empty() ? std::vector<long long>{quantum} : sweep_quanta){
+            spec.quanta.push_back(nanoseconds(value));
+        }
+        spec.seeds.clear();
+        for(long long s = 0; s < sweep_seeds; ++s){
+            spec.seeds.push_back(workload.seed + static_cast<uint64_t>(s));
+        }
+        spec.workload = workload;
+        spec.processes = static_cast<size_t>(sweep_processes);
+
+        ParameterSweep runner(static_cast<size_t>(sweep_threads));
+        auto started = std::chrono::steady_clock::now();
+        std::vector<SweepResult> results;
+        if(!trace_path.empty()){
+            MappedTrace trace;
+            if(!trace.open(trace_path)){
+                return 1;
+            }
+            results = runner.run(spec, read_workload(trace));
+        } else {
+            results = runner.run(spec);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - started;
+        if(results.empty()){
+            return 1;
+        }
+
+        std::vector<SweepRow> rows = summarize_sweep(results);
+        print_sweep_table(rows);
+        nanoseconds busy = 0ns;
+        for(const SweepResult& result : results){
+            busy += result.wall_time;
+        }
+        double wall = static_cast<double>(duration_cast<nanoseconds>(elapsed).count());
+        std::cout << results.size() << " runs on " << runner.thread_count() << " threads in " << wall / 1e6
+                  << "ms, " << busy.count() / wall << "x parallel" << std::endl;
+        if(!sweep_csv.empty()){
+            if(!write_sweep_csv(rows, sweep_csv)){
+                return 1;
+            }
+            std::cout << "Wrote " << rows.size() << " rows to " << sweep_csv << std::endl;
+        }
+        return 0;
+    }
+
+    if(trace_path.empty()){
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    MappedTrace trace;
+    if(!trace.open(trace_path)){
+        return 1;
+    }
+
+    int queue_capacity = static_cast<int>(capacity);
+    options.io = workload;
+    FixedQuantum round_robin{nanoseconds(quantum)};
+
+    timeline.cpus = static_cast<size_t>(cores);
+    if(cores > 1){
+        int core_count = static_cast<int>(cores);
+        if(policy == "fcfs"){
+            MultiCoreFCFSScheduler scheduler(core_count, queue_capacity);
+            return run(scheduler, trace, timeline, options);
+        } else if(policy == "sjf"){
+            MultiCoreSJFScheduler scheduler(core_count, queue_capacity);
+            return run(scheduler, trace, timeline, options);
+        } else if(policy == "rr"){
+            MultiCoreRoundRobinScheduler scheduler(core_count, queue_capacity, LatencyMode::Histogram, round_robin);
+            return run(scheduler, trace, timeline, options);
+        }
+        std::cerr << "ERROR: policy " << policy << " has no multi-core version" << std::endl;
+        return 1;
+    }
+
+    if(policy == "fcfs"){
+        FCFSScheduler scheduler(queue_capacity);
+        return run(scheduler, trace, timeline, options);
+    } else if(policy == "sjf"){
+        SJFScheduler scheduler(queue_capacity);
+        return run(scheduler, trace, timeline, options);
+    } else if(policy == "rr"){
+        RoundRobinScheduler scheduler(queue_capacity, LatencyMode::Histogram, round_robin);
+        return run(scheduler, trace, timeline, options);
+    } else if(policy == "srtf"){
+        SRTFScheduler scheduler(queue_capacity);
+        return run(scheduler, trace, timeline, options);
+    } else if(policy == "mlfq"){
+        MLFQScheduler scheduler(queue_capacity);
+        MLFQConfig config;
+        config.base_quantum = nanoseconds(quantum);
+        config.boost_interval = nanoseconds(boost);
+        scheduler.ready_queue().configure(config);
+        return run(scheduler, trace, timeline, options);
+    } else if(policy == "cfs" || policy == "eevdf"){
+        // --quantum is the EEVDF slice and the CFS minimum slice, CFS shares a period of four
+        FairConfig config;
+        config.slice = nanoseconds(quantum);
+        config.target_latency = nanoseconds(quantum * 4);
+        if(policy == "cfs"){
+            CFSScheduler scheduler(queue_capacity);
+            scheduler.ready_queue().configure(config);
+            return run(scheduler, trace, timeline, options);
+        }
+        EEVDFScheduler scheduler(queue_capacity);
+        scheduler.ready_queue().configure(config);
+        return run(scheduler, trace, timeline, options);
+    } else if(policy == "lottery" || policy == "stride"){
+        // tickets come from the trace's nice levels, --seed also seeds the lottery draws
+        ProportionalShareConfig config;
+        config.quantum = nanoseconds(quantum);
+        config.seed = workload.seed;
+        if(policy == "lottery"){
+            LotteryScheduler scheduler(queue_capacity);
+            scheduler.ready_queue().configure(config);
+            return run(scheduler, trace, timeline, options);
+        }
+        StrideScheduler scheduler(queue_capacity);
+        scheduler.ready_queue().configure(config);
+        return run(scheduler, trace, timeline, options);
+    }
+
+    std::cerr << "ERROR: unknown policy " << policy << std::endl;
+    print_usage(argv[0]);
+    return 1;
 }
\ No newline at end of file
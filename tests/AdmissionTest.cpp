@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include "../src/Admission.h"
+#include "../src/SJFScheduler.h"
+
+#include <vector>
+
+namespace {
+
+AdmissionConfig admission(AdmissionPolicy policy, size_t backlog_capacity = SIZE_MAX){
+    AdmissionConfig config;
+    config.policy = policy;
+    config.backlog_capacity = backlog_capacity;
+    return config;
+}
+
+// a one slot ready queue, so everything after the first arrival goes through admission
+struct Overloaded {
+    SJFScheduler scheduler{1};
+    std::vector<ProcessHandle> handles;
+
+    Overloaded(AdmissionConfig config, std::vector<nanoseconds> bursts){
+        scheduler.set_admission(config);
+        int pid = 1;
+        for(nanoseconds burst : bursts){
+            handles.push_back(scheduler.add_process(pid++, 0ns, burst));
+        }
+    }
+
+    bool completed(size_t i) const {
+        return scheduler.get_process_table().state(handles[i]) == Process::State::COMPLETED;
+    }
+};
+
+} // namespace
+
+TEST(AdmissionTest, ParsesPolicyNames){
+    AdmissionPolicy policy = AdmissionPolicy::Defer;
+    for(AdmissionPolicy expected : {AdmissionPolicy::Defer, AdmissionPolicy::Reject,
+                                    AdmissionPolicy::ShedOldest, AdmissionPolicy::ShedLongest}){
+        EXPECT_TRUE(parse_admission_policy(admission_policy_name(expected), policy));
+        EXPECT_EQ(policy, expected);
+    }
+    EXPECT_FALSE(parse_admission_policy("drop", policy));
+}
+
+TEST(AdmissionTest, BacklogIsFifo){
+    AdmissionBacklog backlog(admission(AdmissionPolicy::Defer, 2));
+    EXPECT_EQ(backlog.offer(1, 50ns), invalid_process_handle);
+    EXPECT_EQ(backlog.offer(2, 10ns), invalid_process_handle);
+    // full, the newcomer is the one turned away
+    EXPECT_EQ(backlog.offer(3, 10ns), 3u);
+    EXPECT_EQ(backlog.size(), 2u);
+
+    EXPECT_EQ(backlog.front(), 1u);
+    backlog.pop();
+    EXPECT_EQ(backlog.front(), 2u);
+    backlog.pop();
+    EXPECT_TRUE(backlog.empty());
+    EXPECT_EQ(backlog.front(), invalid_process_handle);
+}
+
+TEST(AdmissionTest, RejectNeverWaits){
+    AdmissionBacklog backlog(admission(AdmissionPolicy::Reject));
+    EXPECT_EQ(backlog.offer(1, 10ns), 1u);
+    EXPECT_TRUE(backlog.empty());
+}
+
+TEST(AdmissionTest, ShedOldestMakesRoomAtTheFront){
+    AdmissionBacklog backlog(admission(AdmissionPolicy::ShedOldest, 2));
+    backlog.offer(1, 10ns);
+    backlog.offer(2, 10ns);
+    EXPECT_EQ(backlog.offer(3, 10ns), 1u);
+    EXPECT_EQ(backlog.size(), 2u);
+    EXPECT_EQ(backlog.front(), 2u);
+    backlog.pop();
+    EXPECT_EQ(backlog.front(), 3u);
+}
+
+TEST(AdmissionTest, ShedLongestDropsTheMostWork){
+    AdmissionBacklog backlog(admission(AdmissionPolicy::ShedLongest, 3));
+    backlog.offer(1, 10ns);
+    backlog.offer(2, 90ns);
+    backlog.offer(3, 30ns);
+    EXPECT_EQ(backlog.offer(4, 20ns), 2u);
+    // a newcomer with as much work as the longest waiting process is the one shed
+    EXPECT_EQ(backlog.offer(5, 30ns), 5u);
+    EXPECT_EQ(backlog.size(), 3u);
+
+    // 2 left a stale entry behind in the middle of the fifo
+    std::vector<ProcessHandle> order;
+    while(!backlog.empty()){
+        order.push_back(backlog.front());
+        backlog.pop();
+    }
+    EXPECT_EQ(order, (std::vector<ProcessHandle>{1, 3, 4}));
+}
+
+TEST(AdmissionTest, DeferAdmitsEverythingInArrivalOrder){
+    // SJF would run 2 before 3, but only 1 fits in the ready queue and the backlog is fifo
+    Overloaded run(admission(AdmissionPolicy::Defer), {30ns, 20ns, 10ns});
+    run.scheduler.run_simulation();
+
+    SchedulerStats stats = run.scheduler.get_stats();
+    EXPECT_EQ(stats.total_processes_completed, 3);
+    EXPECT_EQ(stats.admitted, 3);
+    EXPECT_EQ(stats.deferred, 2);
+    EXPECT_EQ(stats.shed, 0);
+    EXPECT_EQ(stats.max_backlog_depth, 2u);
+    const ProcessTable& table = run.scheduler.get_process_table();
+    EXPECT_EQ(table.completion(run.handles[1]), 50ns);
+    EXPECT_EQ(table.completion(run.handles[2]), 60ns);
+    // 2 waited 30ns in the backlog and 3 waited 50ns
+    EXPECT_EQ(stats.backlog_time, 80ns);
+    EXPECT_DOUBLE_EQ(stats.mean_backlog_depth(), 80.0 / 60.0);
+}
+
+TEST(AdmissionTest, RejectShedsWhatDoesNotFit){
+    Overloaded run(admission(AdmissionPolicy::Reject), {30ns, 20ns, 10ns});
+    run.scheduler.run_simulation();
+
+    SchedulerStats stats = run.scheduler.get_stats();
+    EXPECT_EQ(stats.total_processes_completed, 1);
+    EXPECT_EQ(stats.admitted, 1);
+    EXPECT_EQ(stats.deferred, 0);
+    EXPECT_EQ(stats.shed, 2);
+    EXPECT_EQ(stats.total_sim_time, 30ns);
+    EXPECT_TRUE(run.completed(0));
+}
+
+TEST(AdmissionTest, BoundedBacklogPolicies){
+    {
+        Overloaded run(admission(AdmissionPolicy::Defer, 1), {30ns, 20ns, 10ns});
+        run.scheduler.run_simulation();
+        EXPECT_TRUE(run.completed(1));
+        EXPECT_FALSE(run.completed(2));
+    }
+    {
+        Overloaded run(admission(AdmissionPolicy::ShedOldest, 1), {30ns, 20ns, 10ns});
+        run.scheduler.run_simulation();
+        EXPECT_FALSE(run.completed(1));
+        EXPECT_TRUE(run.completed(2));
+    }
+    {
+        Overloaded run(admission(AdmissionPolicy::ShedLongest, 1), {30ns, 20ns, 10ns});
+        run.scheduler.run_simulation();
+        EXPECT_FALSE(run.completed(1));
+        EXPECT_TRUE(run.completed(2));
+        SchedulerStats stats = run.scheduler.get_stats();
+        EXPECT_EQ(stats.deferred, 2);
+        EXPECT_EQ(stats.shed, 1);
+        EXPECT_EQ(stats.admitted + stats.shed, 3);
+    }
+}
+
+TEST(AdmissionTest, ShedProcessesAreTracedAndRetired){
+    Overloaded run(admission(AdmissionPolicy::Reject), {30ns, 20ns, 10ns});
+    EventTracer tracer(1, 64);
+    run.scheduler.set_tracer(&tracer);
+    std::vector<ProcessHandle> retired;
+    run.scheduler.set_retire_callback([&](ProcessHandle h){ retired.push_back(h); });
+    run.scheduler.run_simulation();
+
+    std::vector<int> shed;
+    tracer.for_each(0, [&](const SchedEvent& event){
+        if(event.type == SchedEventType::Shed){
+            shed.push_back(event.pid);
+        }
+    });
+    EXPECT_EQ(shed, (std::vector<int>{2, 3}));
+    EXPECT_EQ(retired.size(), 3u);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "../src/ArrivalIndex.h"
+#include "../src/FCFSScheduler.h"
+#include "../src/SJFScheduler.h"
+
+class ArrivalIndexTest : public ::testing::Test {
+protected:
+    void add(int pid, std::chrono::nanoseconds arrival){
+        index.add(table.add(pid, arrival, 10ns), arrival);
+    }
+
+    int front_pid(){
+        return table.pid(index.peek());
+    }
+
+    ArrivalIndex index;
+    ProcessTable table;
+};
+
+TEST_F(ArrivalIndexTest, AdmitsInArrivalOrder){
+    add(1, 30ns);
+    add(2, 10ns);
+    add(3, 20ns);
+
+    EXPECT_EQ(index.next_arrival().count(), 10);
+    EXPECT_FALSE(index.has_arrival_by(5ns));
+
+    ASSERT_TRUE(index.has_arrival_by(25ns));
+    EXPECT_EQ(front_pid(), 2);
+    index.pop();
+    ASSERT_TRUE(index.has_arrival_by(25ns));
+    EXPECT_EQ(front_pid(), 3);
+    index.pop();
+    EXPECT_FALSE(index.has_arrival_by(25ns));
+
+    EXPECT_EQ(index.next_arrival().count(), 30);
+    EXPECT_EQ(index.pending(), 1u);
+    index.pop();
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.next_arrival(), std::chrono::nanoseconds::max());
+    EXPECT_EQ(index.peek(), invalid_process_handle);
+}
+
+TEST_F(ArrivalIndexTest, EqualArrivalsKeepInsertionOrder){
+    add(1, 5ns);
+    add(2, 0ns);
+    add(3, 5ns);
+    add(4, 0ns);
+
+    std::vector<int> order;
+    while(index.has_arrival_by(5ns)){
+        order.push_back(front_pid());
+        index.pop();
+    }
+
+    EXPECT_EQ(order, (std::vector<int>{2, 4, 1, 3}));
+}
+
+TEST_F(ArrivalIndexTest, AddAfterPartialDrain){
+    add(1, 0ns);
+    add(2, 50ns);
+    ASSERT_TRUE(index.has_arrival_by(0ns));
+    index.pop();
+
+    // earlier than the pending front, must be admitted first
+    add(3, 20ns);
+    EXPECT_EQ(index.next_arrival().count(), 20);
+    EXPECT_EQ(front_pid(), 3);
+}
+
+TEST_F(ArrivalIndexTest, SchedulersAdmitEachProcessOnce){
+    FCFSScheduler fcfs(10);
+    SJFScheduler sjf(10);
+    for(int pid = 1; pid <= 4; ++pid){
+        fcfs.add_process(pid, std::chrono::nanoseconds(pid * 100), 10ns);
+    }
+    for(int pid = 5; pid <= 8; ++pid){
+        sjf.add_process(pid, std::chrono::nanoseconds(pid * 100), 10ns);
+    }
+
+    fcfs.run_simulation();
+    sjf.run_simulation();
+
+    EXPECT_TRUE(fcfs.is_simulation_complete());
+    EXPECT_TRUE(sjf.is_simulation_complete());
+    EXPECT_EQ(fcfs.get_stats().total_processes_completed, 4);
+    EXPECT_EQ(sjf.get_stats().total_processes_completed, 4);
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "../src/EventTracer.h"
+#include "../src/FCFSScheduler.h"
+#include "../src/RoundRobinScheduler.h"
+#include "../src/MultiCoreScheduler.h"
+#include "../src/RealExecutionScheduler.h"
+
+namespace {
+
+using Event = std::tuple<SchedEventType, int64_t, int>;
+
+std::vector<Event> events_of(const EventTracer& tracer, size_t buffer){
+    std::vector<Event> events;
+    tracer.for_each(buffer, [&events](const SchedEvent& event){
+        events.emplace_back(event.type, event.time_ns, event.pid);
+    });
+    return events;
+}
+
+size_t count_of(const EventTracer& tracer, SchedEventType type){
+    size_t count = 0;
+    for(size_t b = 0; b < tracer.buffer_count(); ++b){
+        tracer.for_each(b, [&](const SchedEvent& event){ count += event.type == type; });
+    }
+    return count;
+}
+
+std::string read_file(const std::string& path){
+    std::ifstream in(path);
+    std::stringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+} // namespace
+
+TEST(EventTracerTest, CapacityRoundsUpToPowerOfTwo){
+    EventTracer tracer(2, 1000);
+    EXPECT_EQ(tracer.buffer_count(), 2u);
+    EXPECT_EQ(tracer.capacity(), 1024u);
+}
+
+TEST(EventTracerTest, FullRingKeepsTheLatestEvents){
+    EventTracer tracer(1, 4);
+    for(int i = 0; i < 6; ++i){
+        tracer.record(0, SchedEventType::Arrive, nanoseconds(i), i);
+    }
+
+    EXPECT_EQ(tracer.size(0), 4u);
+    EXPECT_EQ(tracer.overwritten(0), 2u);
+    EXPECT_EQ(tracer.total_recorded(), 6u);
+    auto events = events_of(tracer, 0);
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_EQ(std::get<2>(events.front()), 2);
+    EXPECT_EQ(std::get<2>(events.back()), 5);
+
+    tracer.clear();
+    EXPECT_EQ(tracer.size(0), 0u);
+}
+
+TEST(EventTracerTest, RecordsFCFSLifecycle){
+    EventTracer tracer(1, 64);
+    FCFSScheduler scheduler(10);
+    scheduler.add_process(1, 0ns, 10ns);
+    scheduler.add_process(2, 5ns, 10ns);
+    scheduler.set_tracer(&tracer);
+    scheduler.run_simulation();
+
+    // process 2 arrives at 5ns but is only noticed once process 1 is done at 10ns
+    std::vector<Event> expected = {
+        {SchedEventType::Arrive, 0, 1},   {SchedEventType::Enqueue, 0, 1},
+        {SchedEventType::Dispatch, 0, 1}, {SchedEventType::Complete, 10, 1},
+        {SchedEventType::Arrive, 5, 2},   {SchedEventType::Enqueue, 10, 2},
+        {SchedEventType::Dispatch, 10, 2}, {SchedEventType::Complete, 20, 2},
+    };
+    EXPECT_EQ(events_of(tracer, 0), expected);
+}
+
+TEST(EventTracerTest, RecordsPreemptionsAndDrops){
+    EventTracer tracer(1, 256);
+    // two slots, one held back for the preempted process, so process 3 is turned away at 10ns
+    RoundRobinScheduler scheduler(2, LatencyMode::Exact, FixedQuantum{10ns});
+    scheduler.add_process(1, 0ns, 30ns);
+    scheduler.add_process(2, 5ns, 10ns);
+    scheduler.add_process(3, 5ns, 10ns);
+    scheduler.set_tracer(&tracer);
+    scheduler.run_simulation();
+
+    // 1 0-10, 2 10-20, 1 20-30, 3 30-40, 1 40-50
+    EXPECT_EQ(count_of(tracer, SchedEventType::Complete), 3u);
+    EXPECT_EQ(count_of(tracer, SchedEventType::Preempt), 2u);
+    EXPECT_EQ(count_of(tracer, SchedEventType::Dispatch), 5u);
+    EXPECT_GT(count_of(tracer, SchedEventType::Drop), 0u);
+    tracer.for_each(0, [](const SchedEvent& event){
+        if(event.type == SchedEventType::Drop){
+            EXPECT_EQ(event.pid, 3);
+        }
+    });
+}
+
+TEST(EventTracerTest, MultiCoreRecordsPerCore){
+    MultiCoreFCFSScheduler scheduler(2, 10);
+    EventTracer too_small(1, 64);
+    EXPECT_FALSE(scheduler.set_tracer(&too_small));
+
+    EventTracer tracer(2, 64);
+    ASSERT_TRUE(scheduler.set_tracer(&tracer));
+    scheduler.add_process(1, 0ns, 10ns);
+    scheduler.add_process(2, 0ns, 10ns);
+    scheduler.run_simulation();
+
+    // one process on each core
+    for(size_t core = 0; core < 2; ++core){
+        auto events = events_of(tracer, core);
+        ASSERT_EQ(events.size(), 4u);
+        EXPECT_EQ(std::get<0>(events[2]), SchedEventType::Dispatch);
+        EXPECT_EQ(std::get<0>(events[3]), SchedEventType::Complete);
+        EXPECT_EQ(std::get<1>(events[3]), 10);
+    }
+}
+
+TEST(EventTracerTest, RealExecutionUsesWorkerAndDispatcherBuffers){
+    RealFCFSExecutor executor(2, 16);
+    EventTracer too_small(2, 64);
+    EXPECT_FALSE(executor.set_tracer(&too_small));
+
+    EventTracer tracer(3, 64);
+    ASSERT_TRUE(executor.set_tracer(&tracer));
+    for(int pid = 0; pid < 8; ++pid){
+        executor.add_process(pid, 0ns, 1000ns);
+    }
+    executor.run();
+
+    // the dispatcher admits, the workers run
+    EXPECT_EQ(count_of(tracer, SchedEventType::Enqueue), 8u);
+    EXPECT_EQ(count_of(tracer, SchedEventType::Dispatch), 8u);
+    EXPECT_EQ(count_of(tracer, SchedEventType::Complete), 8u);
+    tracer.for_each(2, [](const SchedEvent& event){
+        EXPECT_NE(event.type, SchedEventType::Dispatch);
+    });
+}
+
+TEST(EventTracerTest, ChromeTraceHasCpuAndProcessTracks){
+    EventTracer tracer(1, 256);
+    RoundRobinScheduler scheduler(10, LatencyMode::Exact, FixedQuantum{10ns});
+    scheduler.add_process(1, 0ns, 20ns);
+    scheduler.add_process(2, 5ns, 10ns);
+    scheduler.set_tracer(&tracer);
+    scheduler.run_simulation();
+
+    std::string path = ::testing::TempDir() + "event_tracer_test.json";
+    ASSERT_TRUE(write_chrome_trace(tracer, path));
+    std::string json = read_file(path);
+    std::remove(path.c_str());
+
+    ASSERT_FALSE(json.empty());
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.substr(json.size() - 3), "]}\n");
+    EXPECT_NE(json.find("\"name\":\"cpu 0\""), std::string::npos);
+
+    // A 0-10, B 10-20, A 20-30 on cpu 0
+    EXPECT_NE(json.find("{\"name\":\"pid 1\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":0.000,\"dur\":0.010"),
+              std::string::npos);
+    EXPECT_NE(json.find("{\"name\":\"pid 2\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":0.010,\"dur\":0.010"),
+              std::string::npos);
+    EXPECT_NE(json.find("{\"name\":\"pid 1\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":0.020,\"dur\":0.010"),
+              std::string::npos);
+    // B waited 5-10, A waited 10-20 after its preemption
+    EXPECT_NE(json.find("{\"name\":\"waiting\",\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":0.005,\"dur\":0.005"),
+              std::string::npos);
+    EXPECT_NE(json.find("{\"name\":\"waiting\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":0.010,\"dur\":0.010"),
+              std::string::npos);
+}
+
+TEST(EventTracerTest, ChromeTraceReportsUnwritablePath){
+    EventTracer tracer(1, 4);
+    EXPECT_FALSE(write_chrome_trace(tracer, "/nonexistent/dir/trace.json"));
+}
@@ -4,7 +4,8 @@
 class FCFSSchedulerTest : public ::testing::Test {
 protected:
     void SetUp() override {
-        scheduler = std::make_unique<FCFSScheduler>(10);
+        // exact mode so tests can look at individual samples
+        scheduler = std::make_unique<FCFSScheduler>(10, LatencyMode::Exact);
     }
 
     std::unique_ptr<FCFSScheduler> scheduler;
@@ -26,4 +27,58 @@ TEST_F(FCFSSchedulerTest, HandleSingleProcess){
     EXPECT_EQ(stats.turnaround_times[0].count(), 100);
     EXPECT_EQ(stats.waiting_times[0].count(), 0);
     EXPECT_TRUE(scheduler->is_simulation_complete());
+}
+
+TEST_F(FCFSSchedulerTest, CountsEachCompletionOnce){
+    for(int pid = 1; pid <= 5; ++pid){
+        auto p = std::make_unique<Process>(pid, std::chrono::nanoseconds(pid * 10), 5ns);
+        scheduler->add_process(p.get());
+        processes.push_back(std::move(p));
+    }
+
+    scheduler->run_simulation();
+
+    auto stats = scheduler->get_stats();
+
+    EXPECT_EQ(stats.total_processes_completed, 5);
+    EXPECT_EQ(stats.turnaround_times.size(), 5u);
+    EXPECT_TRUE(scheduler->is_simulation_complete());
+}
+
+TEST_F(FCFSSchedulerTest, RetiresCompletedProcesses){
+    std::vector<int> retired;
+    scheduler->set_retire_callback([&](ProcessHandle h){
+        retired.push_back(scheduler->get_process_table().pid(h));
+    });
+
+    for(int pid = 1; pid <= 3; ++pid){
+        auto p = std::make_unique<Process>(pid, 0ns, 10ns);
+        scheduler->add_process(p.get());
+        processes.push_back(std::move(p));
+    }
+
+    scheduler->run_simulation();
+
+    EXPECT_EQ(retired, (std::vector<int>{1, 2, 3}));
+    // every slot was handed back
+    EXPECT_EQ(scheduler->get_process_table().live(), 0u);
+    EXPECT_EQ(scheduler->get_stats().total_processes_completed, 3);
+}
+
+TEST_F(FCFSSchedulerTest, RunsInArrivalOrderAndAdvancesClock){
+    // same arrival time, so admission order decides
+    scheduler->add_process(1, 0ns, 30ns);
+    scheduler->add_process(2, 0ns, 10ns);
+    scheduler->add_process(3, 0ns, 20ns);
+    scheduler->add_process(4, 100ns, 5ns);
+
+    scheduler->run_simulation();
+
+    const ProcessTable& table = scheduler->get_process_table();
+    EXPECT_EQ(table.completion(0).count(), 30);
+    EXPECT_EQ(table.completion(1).count(), 40);
+    EXPECT_EQ(table.completion(2).count(), 60);
+    // the clock skips the idle gap instead of stepping through it
+    EXPECT_EQ(table.start(3).count(), 100);
+    EXPECT_EQ(scheduler->get_stats().total_sim_time.count(), 105);
 }
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include "../src/FairScheduler.h"
+#include "../src/FCFSScheduler.h"
+
+namespace {
+
+FairConfig config(nanoseconds slice, nanoseconds target_latency){
+    FairConfig c;
+    c.slice = slice;
+    c.target_latency = target_latency;
+    return c;
+}
+
+template <typename Scheduler>
+SchedulerStats run_equal_jobs(Scheduler& scheduler, int n){
+    for(int pid = 0; pid < n; ++pid){
+        scheduler.add_process(pid, 0ns, 100ns);
+    }
+    scheduler.run_simulation();
+    return scheduler.get_stats();
+}
+
+} // namespace
+
+TEST(FairSchedulerTest, NiceWeights){
+    EXPECT_EQ(nice_weight(0), 1024u);
+    EXPECT_EQ(nice_weight(-20), 88761u);
+    EXPECT_EQ(nice_weight(19), 15u);
+    EXPECT_EQ(nice_weight(-40), nice_weight(min_nice));
+    EXPECT_EQ(nice_weight(40), nice_weight(max_nice));
+
+    ProcessTable table;
+    ProcessHandle h = table.add(1, 0ns, 10ns);
+    EXPECT_EQ(table.nice(h), 0);
+    table.set_nice(h, 25);
+    EXPECT_EQ(table.nice(h), max_nice);
+    EXPECT_EQ(table.weight(h), 15u);
+}
+
+TEST(FairSchedulerTest, PicksByVruntimeOrDeadline){
+    ProcessTable table;
+    ProcessHandle light = table.add(1, 0ns, 100ns);
+    ProcessHandle heavy = table.add(2, 0ns, 100ns);
+    table.set_nice(light, 19);
+    table.set_nice(heavy, -20);
+
+    // both start at the same vruntime, so CFS goes by handle while EEVDF takes the
+    // heavy process, whose slice is worth far less virtual time
+    FairReadyQueue<FairPick::MinVruntime> cfs(table, 4);
+    EXPECT_TRUE(cfs.push(light));
+    EXPECT_TRUE(cfs.push(heavy));
+    EXPECT_EQ(cfs.pop(), light);
+
+    FairReadyQueue<FairPick::EarliestEligibleDeadline> eevdf(table, 4);
+    EXPECT_TRUE(eevdf.push(light));
+    EXPECT_TRUE(eevdf.push(heavy));
+    EXPECT_LT(eevdf.deadline(heavy), eevdf.deadline(light));
+    EXPECT_EQ(eevdf.pop(), heavy);
+    EXPECT_EQ(eevdf.pop(), light);
+    EXPECT_EQ(eevdf.pop(), invalid_process_handle);
+}
+
+TEST(FairSchedulerTest, EEVDFTiesGoToTheLeastVruntime){
+    ProcessTable table;
+    // treap priorities are fixed per handle. these handles put a at the root with d
+    // below it to the right and b in d's left subtree, so the walk down sees a before b
+    table.add(0, 0ns, 10000ns);
+    ProcessHandle b = table.add(1, 0ns, 10000ns);
+    ProcessHandle c = table.add(2, 0ns, 10000ns);
+    ProcessHandle d = table.add(3, 0ns, 10000ns);
+    ProcessHandle a = table.add(4, 0ns, 10000ns);
+    table.set_nice(c, -20);
+    FairReadyQueue<FairPick::EarliestEligibleDeadline> queue(table, 8);
+
+    // run h for ran starting at now, then queue it again asking for slice
+    auto run = [&](ProcessHandle h, nanoseconds now, nanoseconds ran, nanoseconds slice){
+        queue.time_slice(h, now);
+        table.last_run(h) = now + ran;
+        table.state(h) = Process::State::BLOCKED;
+        queue.configure(config(slice, 40ns));
+        queue.push(h);
+    };
+
+    // a asks for a long slice, the others for short ones so they run first
+    queue.configure(config(1000ns, 40ns));
+    queue.push(a);
+    queue.configure(config(1ns, 40ns));
+    queue.push(b);
+    queue.push(c);
+    queue.push(d);
+    ASSERT_EQ(queue.pop(), c);
+    // heavy c runs far ahead and pulls the average up past b and d
+    run(c, 0ns, 1000ns, 1ns);
+    ASSERT_EQ(queue.pop(), b);
+    run(b, 1000ns, 10ns, 990ns);
+    ASSERT_EQ(queue.pop(), d);
+    run(d, 1010ns, 11ns, 2000ns);
+
+    // a and b are both eligible with the same deadline, a has had less CPU
+    ASSERT_LT(queue.vruntime(a), queue.vruntime(b));
+    ASSERT_LE(queue.vruntime(d), queue.average_vruntime());
+    ASSERT_EQ(queue.deadline(a), queue.deadline(b));
+    EXPECT_EQ(queue.pop(), a);
+    EXPECT_EQ(queue.pop(), b);
+}
+
+TEST(FairSchedulerTest, RespectsCapacity){
+    ProcessTable table;
+    FairReadyQueue<FairPick::EarliestEligibleDeadline> queue(table, 2);
+    EXPECT_TRUE(queue.push(table.add(1, 0ns, 1ns)));
+    EXPECT_TRUE(queue.push(table.add(2, 0ns, 1ns)));
+    EXPECT_FALSE(queue.push(table.add(3, 0ns, 1ns)));
+    EXPECT_EQ(queue.size(), 2u);
+}
+
+TEST(FairSchedulerTest, CFSSplitsLatencyPeriod){
+    CFSScheduler scheduler(16);
+    scheduler.ready_queue().configure(config(10ns, 40ns));
+    ProcessHandle a = scheduler.add_process(1, 0ns, 100ns);
+    ProcessHandle b = scheduler.add_process(2, 0ns, 100ns);
+
+    scheduler.run_simulation();
+
+    // two equal processes get half of the 40ns period each and take turns
+    const ProcessTable& table = scheduler.get_process_table();
+    EXPECT_EQ(table.completion(a).count(), 180);
+    EXPECT_EQ(table.completion(b).count(), 200);
+}
+
+template <typename Scheduler>
+void expect_weighted_share(){
+    Scheduler scheduler(16);
+    scheduler.ready_queue().configure(config(10ns, 40ns));
+    ProcessHandle heavy = scheduler.add_process(1, 0ns, 1000ns, 0);
+    scheduler.add_process(2, 0ns, 10000ns, 5);
+
+    scheduler.run_simulation();
+
+    // nice 0 against nice 5 is 1024 : 335, so the first process gets ~75% of the CPU
+    // until it is done at 1000 * (1024 + 335) / 1024
+    EXPECT_NEAR(static_cast<double>(scheduler.get_process_table().completion(heavy).count()), 1327.0, 30.0);
+}
+
+TEST(FairSchedulerTest, CFSSharesByWeight){
+    expect_weighted_share<CFSScheduler>();
+}
+
+TEST(FairSchedulerTest, EEVDFSharesByWeight){
+    expect_weighted_share<EEVDFScheduler>();
+}
+
+TEST(FairSchedulerTest, LateArrivalStartsAtAverage){
+    EEVDFScheduler scheduler(16);
+    scheduler.ready_queue().configure(config(10ns, 40ns));
+    ProcessHandle early = scheduler.add_process(1, 0ns, 2000ns);
+    ProcessHandle late = scheduler.add_process(2, 1000ns, 1000ns);
+
+    scheduler.run_simulation();
+
+    // placed at vruntime 0 the late process would run alone from 1000 to 2000, placed
+    // at the average the two share the CPU from 1000 on and finish together
+    const ProcessTable& table = scheduler.get_process_table();
+    EXPECT_GE(table.completion(late).count(), 2900);
+    EXPECT_GE(table.completion(early).count(), 2900);
+}
+
+TEST(FairSchedulerTest, JainsIndex){
+    FCFSScheduler fcfs(16, LatencyMode::Exact);
+    fcfs.add_process(1, 0ns, 10ns);
+    fcfs.add_process(2, 0ns, 10ns);
+    fcfs.run_simulation();
+
+    // service rates 1 and 0.5: 1.5^2 / (2 * 1.25)
+    SchedulerStats stats = fcfs.get_stats();
+    EXPECT_NEAR(stats.jains_index(), 0.9, 1e-9);
+    EXPECT_DOUBLE_EQ(stats.mean_service_rate(0), 0.75);
+    EXPECT_DOUBLE_EQ(stats.cpu_share(0), 1.0);
+
+    // merging a copy doubles every sum and keeps the index
+    SchedulerStats merged = stats;
+    merged.merge(stats);
+    EXPECT_NEAR(merged.jains_index(), 0.9, 1e-9);
+    EXPECT_EQ(merged.nice_completions[0 - min_nice], 4);
+}
+
+TEST(FairSchedulerTest, CPUSharePerNiceLevel){
+    FCFSScheduler fcfs(16);
+    fcfs.add_process(1, 0ns, 30ns, 0);
+    fcfs.add_process(2, 0ns, 10ns, 10);
+    fcfs.run_simulation();
+
+    SchedulerStats stats = fcfs.get_stats();
+    EXPECT_DOUBLE_EQ(stats.cpu_share(0), 0.75);
+    EXPECT_DOUBLE_EQ(stats.cpu_share(10), 0.25);
+    EXPECT_DOUBLE_EQ(stats.mean_service_rate(10), 0.25);
+    EXPECT_EQ(stats.cpu_share(-5), 0.0);
+}
+
+TEST(FairSchedulerTest, FairerThanFCFS){
+    FCFSScheduler fcfs(16);
+    EEVDFScheduler eevdf(16);
+    eevdf.ready_queue().configure(config(10ns, 40ns));
+
+    // FCFS serves ten equal jobs one after another, rates 1, 1/2, ... 1/10
+    double fcfs_index = run_equal_jobs(fcfs, 10).jains_index();
+    double eevdf_index = run_equal_jobs(eevdf, 10).jains_index();
+    EXPECT_LT(fcfs_index, 0.7);
+    EXPECT_GT(eevdf_index, 0.95);
+}
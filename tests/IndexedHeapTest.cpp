@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "../src/IndexedHeap.h"
+#include "../src/SJFScheduler.h"
+
+TEST(IndexedHeapTest, PopsInKeyOrder){
+    IndexedHeap<int> heap;
+    std::vector<int> keys = {50, 20, 80, 10, 70, 30, 60, 40, 90};
+    for(size_t i = 0; i < keys.size(); ++i){
+        EXPECT_TRUE(heap.push(static_cast<ProcessHandle>(i), keys[i]));
+    }
+    EXPECT_EQ(heap.size(), keys.size());
+
+    std::vector<int> popped;
+    while(!heap.empty()){
+        ProcessHandle h = heap.pop();
+        popped.push_back(keys[h]);
+    }
+    std::sort(keys.begin(), keys.end());
+    EXPECT_EQ(popped, keys);
+    EXPECT_EQ(heap.pop(), invalid_process_handle);
+}
+
+TEST(IndexedHeapTest, HandleIsQueuedAtMostOnce){
+    IndexedHeap<int> heap;
+    EXPECT_TRUE(heap.push(3, 1));
+    EXPECT_FALSE(heap.push(3, 2));
+    EXPECT_TRUE(heap.contains(3));
+    EXPECT_FALSE(heap.contains(2));
+    EXPECT_FALSE(heap.contains(1000));
+    EXPECT_EQ(heap.pop(), 3u);
+    EXPECT_FALSE(heap.contains(3));
+    EXPECT_TRUE(heap.push(3, 2));
+}
+
+TEST(IndexedHeapTest, DecreaseKeyMovesToFront){
+    IndexedHeap<int> heap;
+    for(ProcessHandle h = 0; h < 10; ++h){
+        heap.push(h, 100 + static_cast<int>(h));
+    }
+    EXPECT_TRUE(heap.decrease_key(7, 5));
+    EXPECT_FALSE(heap.decrease_key(7, 6));
+    EXPECT_FALSE(heap.decrease_key(42, 1));
+    EXPECT_EQ(heap.key(7), 5);
+    EXPECT_EQ(heap.top().handle, 7u);
+}
+
+TEST(IndexedHeapTest, UpdateAndEraseAnywhere){
+    IndexedHeap<int> heap;
+    for(ProcessHandle h = 0; h < 10; ++h){
+        heap.push(h, static_cast<int>(h));
+    }
+    // 0 goes to the back, 9 to the front, 5 leaves
+    EXPECT_TRUE(heap.update(0, 100));
+    EXPECT_TRUE(heap.update(9, -1));
+    EXPECT_TRUE(heap.erase(5));
+    EXPECT_FALSE(heap.erase(5));
+    EXPECT_FALSE(heap.update(5, 0));
+
+    std::vector<ProcessHandle> order;
+    while(!heap.empty()){
+        order.push_back(heap.pop());
+    }
+    EXPECT_EQ(order, (std::vector<ProcessHandle>{9, 1, 2, 3, 4, 6, 7, 8, 0}));
+}
+
+TEST(IndexedHeapTest, MatchesOrderedSetUnderRandomOperations){
+    IndexedHeap<int64_t> heap;
+    std::set<std::pair<int64_t, ProcessHandle>> reference;
+    std::vector<int64_t> keys(512, 0);
+    uint64_t x = 12345;
+    auto next = [&x]{
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        return x;
+    };
+
+    for(int step = 0; step < 100000; ++step){
+        ProcessHandle h = static_cast<ProcessHandle>(next() % keys.size());
+        int64_t key = static_cast<int64_t>(next() % 1000);
+        bool queued = reference.count({keys[h], h}) > 0;
+        switch(next() % 4){
+        case 0:
+            if(!queued){
+                ASSERT_TRUE(heap.push(h, key));
+                keys[h] = key;
+                reference.insert({key, h});
+            }
+            break;
+        case 1:
+            ASSERT_EQ(heap.update(h, key), queued);
+            if(queued){
+                reference.erase({keys[h], h});
+                keys[h] = key;
+                reference.insert({key, h});
+            }
+            break;
+        case 2:
+            ASSERT_EQ(heap.erase(h), queued);
+            reference.erase({keys[h], h});
+            break;
+        case 3:
+            if(!reference.empty()){
+                // ties may come out in any order, only the key has to match
+                int64_t smallest = reference.begin()->first;
+                ProcessHandle popped = heap.pop();
+                ASSERT_EQ(keys[popped], smallest);
+                reference.erase({keys[popped], popped});
+            }
+            break;
+        }
+        ASSERT_EQ(heap.size(), reference.size());
+    }
+}
+
+TEST(IndexedHeapTest, ShortestJobQueueReKeysFromTable){
+    ProcessTable table;
+    ProcessHandle a = table.add(1, 0ns, 30ns);
+    ProcessHandle b = table.add(2, 0ns, 20ns);
+    ShortestJobReadyQueue queue(table, 8);
+    queue.push(a);
+    queue.push(b);
+
+    table.remaining(a) = 10ns;
+    EXPECT_TRUE(queue.update(a));
+    EXPECT_TRUE(queue.erase(b));
+    EXPECT_FALSE(queue.contains(b));
+    EXPECT_EQ(queue.pop(), a);
+    EXPECT_TRUE(queue.empty());
+}
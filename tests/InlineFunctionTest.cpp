@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+#include "../src/InlineFunction.h"
+
+TEST(InlineFunctionTest, EmptyByDefault){
+    InlineFunction<void()> f;
+    EXPECT_FALSE(f);
+    f = []{};
+    EXPECT_TRUE(f);
+    f = nullptr;
+    EXPECT_FALSE(f);
+}
+
+TEST(InlineFunctionTest, CallsWithArgumentsAndCaptures){
+    int base = 10;
+    InlineFunction<int(int, int)> add = [&base](int a, int b){ return base + a + b; };
+    EXPECT_EQ(add(1, 2), 13);
+    base = 20;
+    EXPECT_EQ(add(1, 2), 23);
+}
+
+TEST(InlineFunctionTest, CopiesAndMovesNonTrivialCallables){
+    auto counter = std::make_shared<int>(0);
+    InlineFunction<void()> f = [counter]{ (*counter)++; };
+    EXPECT_EQ(counter.use_count(), 2);
+
+    InlineFunction<void()> copy = f;
+    EXPECT_EQ(counter.use_count(), 3);
+    copy();
+    f();
+    EXPECT_EQ(*counter, 2);
+
+    InlineFunction<void()> moved = std::move(copy);
+    EXPECT_FALSE(copy);
+    EXPECT_EQ(counter.use_count(), 3);
+    moved();
+    EXPECT_EQ(*counter, 3);
+
+    // destroying and reassigning releases the captured state
+    moved = nullptr;
+    f = []{};
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(InlineFunctionTest, CapacityCanBeRaised){
+    std::string text = "a std::string is bigger than the default buffer on some platforms";
+    InlineFunction<size_t(), 64> size = [text]{ return text.size(); };
+    EXPECT_EQ(size(), text.size());
+    static_assert(InlineFunction<void(), 64>::capacity() == 64);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "../src/SchedulerStats.h"
+
+#include <random>
+
+TEST(LatencyHistogramTest, SmallValuesAreExact){
+    LatencyHistogram histogram;
+    for(int i = 1; i <= 100; ++i){
+        histogram.record(std::chrono::nanoseconds(i));
+    }
+
+    EXPECT_EQ(histogram.count(), 100u);
+    EXPECT_EQ(histogram.percentile(50.0).count(), 50);
+    EXPECT_EQ(histogram.percentile(99.0).count(), 99);
+    EXPECT_EQ(histogram.percentile(100.0).count(), 100);
+    EXPECT_EQ(histogram.min().count(), 1);
+    EXPECT_EQ(histogram.max().count(), 100);
+    EXPECT_EQ(histogram.mean().count(), 50);
+}
+
+TEST(LatencyHistogramTest, PercentilesWithinRelativeError){
+    std::mt19937_64 rng(7);
+    std::lognormal_distribution<double> dist(10.0, 2.0);
+
+    LatencyDistribution exact(LatencyMode::Exact);
+    LatencyDistribution histogram(LatencyMode::Histogram);
+    for(int i = 0; i < 100000; ++i){
+        nanoseconds value(static_cast<int64_t>(dist(rng)));
+        exact.record(value);
+        histogram.record(value);
+    }
+
+    for(double p : {50.0, 90.0, 99.0, 99.9}){
+        double expected = static_cast<double>(exact.percentile(p).count());
+        double actual = static_cast<double>(histogram.percentile(p).count());
+        EXPECT_NEAR(actual, expected, expected * 0.02) << "p" << p;
+    }
+    EXPECT_EQ(histogram.size(), exact.size());
+}
+
+TEST(LatencyHistogramTest, MemoryIsBoundedBySampleRange){
+    LatencyHistogram histogram;
+    for(int i = 0; i < 1000000; ++i){
+        histogram.record(std::chrono::nanoseconds(i % 1000000 + 1));
+    }
+
+    EXPECT_EQ(histogram.count(), 1000000u);
+    // one bucket per value would be 10^6 buckets
+    EXPECT_LT(histogram.bucket_count(), 1200u);
+}
+
+TEST(LatencyHistogramTest, MergeCombinesCounts){
+    LatencyHistogram low;
+    LatencyHistogram high;
+    for(int i = 1; i <= 50; ++i){
+        low.record(std::chrono::nanoseconds(i));
+        high.record(std::chrono::nanoseconds(i + 50));
+    }
+
+    low.merge(high);
+    EXPECT_EQ(low.count(), 100u);
+    EXPECT_EQ(low.percentile(50.0).count(), 50);
+    EXPECT_EQ(low.percentile(100.0).count(), 100);
+}
+
+TEST(LatencyHistogramTest, ExactModeKeepsSamples){
+    LatencyDistribution exact(LatencyMode::Exact);
+    exact.record(30ns);
+    exact.record(10ns);
+    exact.record(20ns);
+
+    EXPECT_EQ(exact[0].count(), 30);
+    EXPECT_EQ(exact.percentile(50.0).count(), 20);
+    // percentile must not reorder the recorded samples
+    EXPECT_EQ(exact.samples(), (std::vector<nanoseconds>{30ns, 10ns, 20ns}));
+
+    LatencyDistribution histogram;
+    histogram.record(40ns);
+    exact.merge(histogram);
+    EXPECT_EQ(exact.mode(), LatencyMode::Histogram);
+    EXPECT_EQ(exact.size(), 4u);
+    EXPECT_EQ(exact.percentile(100.0).count(), 40);
+}
+
+TEST(LatencyHistogramTest, StatsMergeAcrossRuns){
+    SchedulerStats a;
+    SchedulerStats b;
+    a.turnaround_times.record(10ns);
+    a.total_processes_completed = 1;
+    b.turnaround_times.record(30ns);
+    b.total_processes_completed = 1;
+
+    a.merge(b);
+    EXPECT_EQ(a.total_processes_completed, 2);
+    EXPECT_EQ(a.calculate_percentile(a.turnaround_times, 100.0).count(), 30);
+}
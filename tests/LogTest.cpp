@@ -0,0 +1,141 @@
+// compile every level in, whatever the build default is, so the runtime filter is what's tested
+#undef SCHEDULER_LOG_LEVEL
+#define SCHEDULER_LOG_LEVEL 0
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Log.h"
+
+using namespace std::chrono;
+
+namespace {
+
+std::mutex captured_mutex;
+std::vector<std::string> captured;
+
+void capture(LogLevel, std::string_view line){
+    std::lock_guard<std::mutex> lock(captured_mutex);
+    captured.emplace_back(line);
+}
+
+int side_effect(int& counter){
+    return ++counter;
+}
+
+class LogTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        captured.clear();
+        saved_level_ = Logger::level();
+        Logger::set_sink(&capture);
+    }
+
+    void TearDown() override {
+        Logger::stop_async();
+        Logger::set_sink(nullptr);
+        Logger::set_level(saved_level_);
+    }
+
+private:
+    LogLevel saved_level_ = LogLevel::Warn;
+};
+
+} // namespace
+
+TEST_F(LogTest, FormatsArgumentsIntoOneLine) {
+    Logger::set_level(LogLevel::Trace);
+    SCHED_LOG_INFO("pid ", 7, " waited ", 42ns, "ns, done: ", true, ' ', 1.5);
+
+    ASSERT_EQ(captured.size(), 1u);
+    EXPECT_EQ(captured[0], "pid 7 waited 42ns, done: true 1.5");
+}
+
+TEST_F(LogTest, LongLinesAreCutOff) {
+    Logger::set_level(LogLevel::Trace);
+    std::string long_text(1000, 'x');
+    SCHED_LOG_INFO(long_text, 12345);
+
+    ASSERT_EQ(captured.size(), 1u);
+    EXPECT_EQ(captured[0], std::string(sizeof(LogRecord::text), 'x'));
+}
+
+TEST_F(LogTest, RuntimeLevelFiltersAndSkipsArguments) {
+    Logger::set_level(LogLevel::Warn);
+    int counter = 0;
+    SCHED_LOG_DEBUG("hidden ", side_effect(counter));
+    SCHED_LOG_INFO("hidden ", side_effect(counter));
+    SCHED_LOG_WARN("shown ", side_effect(counter));
+    SCHED_LOG_ERROR("shown ", side_effect(counter));
+
+    // arguments of a filtered call are never evaluated
+    EXPECT_EQ(counter, 2);
+    ASSERT_EQ(captured.size(), 2u);
+    EXPECT_EQ(captured[0], "shown 1");
+    EXPECT_EQ(captured[1], "shown 2");
+}
+
+TEST_F(LogTest, OffSilencesEverything) {
+    Logger::set_level(LogLevel::Off);
+    SCHED_LOG_ERROR("nothing");
+    EXPECT_TRUE(captured.empty());
+}
+
+TEST_F(LogTest, CompiledOutLevelsAreNeverEvaluated) {
+    // SCHED_LOG compares against the compile time level before anything else, with a
+    // level above it the call is discarded even when the runtime level would allow it
+    Logger::set_level(LogLevel::Trace);
+    int counter = 0;
+#undef SCHEDULER_LOG_LEVEL
+#define SCHEDULER_LOG_LEVEL 3
+    SCHED_LOG_INFO("gone ", side_effect(counter));
+    SCHED_LOG_WARN("kept ", side_effect(counter));
+#undef SCHEDULER_LOG_LEVEL
+#define SCHEDULER_LOG_LEVEL 0
+
+    EXPECT_EQ(counter, 1);
+    ASSERT_EQ(captured.size(), 1u);
+    EXPECT_EQ(captured[0], "kept 1");
+}
+
+TEST_F(LogTest, AsyncDeliversEveryLineInOrderAfterStop) {
+    Logger::set_level(LogLevel::Trace);
+    ASSERT_TRUE(Logger::start_async(1 << 12));
+    EXPECT_TRUE(Logger::async());
+    EXPECT_FALSE(Logger::start_async());
+
+    uint64_t dropped_before = Logger::dropped();
+    constexpr int lines = 1000;
+    for(int i = 0; i < lines; ++i){
+        SCHED_LOG_DEBUG("line ", i);
+    }
+    Logger::stop_async();
+    EXPECT_FALSE(Logger::async());
+
+    ASSERT_EQ(Logger::dropped(), dropped_before);
+    ASSERT_EQ(captured.size(), static_cast<size_t>(lines));
+    for(int i = 0; i < lines; ++i){
+        EXPECT_EQ(captured[i], "line " + std::to_string(i));
+    }
+}
+
+TEST_F(LogTest, AsyncDropsInsteadOfBlockingWhenFull) {
+    Logger::set_level(LogLevel::Trace);
+    // the buffer is sized by the first start_async() in the process
+    Logger::start_async(1 << 12);
+    uint64_t dropped_before = Logger::dropped();
+
+    // far more than the buffer holds, faster than the writer can drain it
+    constexpr int lines = 200000;
+    for(int i = 0; i < lines; ++i){
+        SCHED_LOG_DEBUG("burst ", i);
+    }
+    Logger::stop_async();
+
+    uint64_t dropped = Logger::dropped() - dropped_before;
+    EXPECT_GT(dropped, 0u);
+    EXPECT_EQ(captured.size() + dropped, static_cast<size_t>(lines));
+}
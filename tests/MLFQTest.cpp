@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include "../src/MLFQScheduler.h"
+
+namespace {
+
+MLFQConfig config(nanoseconds quantum, nanoseconds boost){
+    MLFQConfig c;
+    c.base_quantum = quantum;
+    c.boost_interval = boost;
+    return c;
+}
+
+} // namespace
+
+TEST(MLFQTest, PicksHighestNonEmptyLevel){
+    ProcessTable table;
+    MultiLevelFeedbackQueue queue(table, 16);
+    ProcessHandle a = table.add(1, 0ns, 100ns);
+    ProcessHandle b = table.add(2, 0ns, 100ns);
+    ProcessHandle c = table.add(3, 0ns, 100ns);
+
+    // a comes back from a full slice and drops to level 1, behind the new arrivals
+    table.state(a) = Process::State::BLOCKED;
+    EXPECT_TRUE(queue.push(a));
+    EXPECT_TRUE(queue.push(b));
+    EXPECT_TRUE(queue.push(c));
+    EXPECT_EQ(queue.level_bitmap(), 0b11u);
+
+    EXPECT_EQ(queue.pop(), b);
+    EXPECT_EQ(queue.pop(), c);
+    EXPECT_EQ(queue.pop(), a);
+    EXPECT_EQ(queue.pop(), invalid_process_handle);
+    EXPECT_EQ(queue.level_bitmap(), 0u);
+}
+
+TEST(MLFQTest, RespectsCapacity){
+    ProcessTable table;
+    MultiLevelFeedbackQueue queue(table, 2);
+    EXPECT_TRUE(queue.push(table.add(1, 0ns, 1ns)));
+    EXPECT_TRUE(queue.push(table.add(2, 0ns, 1ns)));
+    EXPECT_FALSE(queue.push(table.add(3, 0ns, 1ns)));
+    EXPECT_EQ(queue.size(), 2u);
+}
+
+TEST(MLFQTest, LongRunnerSinksWithGrowingSlices){
+    MLFQScheduler scheduler(16);
+    scheduler.ready_queue().configure(config(10ns, 0ns));
+    ProcessHandle h = scheduler.add_process(1, 0ns, 100ns);
+
+    scheduler.run_simulation();
+
+    // slices of 10, 20, 30, 40: three demotions, and none of them are context switches
+    auto stats = scheduler.get_stats();
+    EXPECT_EQ(scheduler.get_process_table().completion(h).count(), 100);
+    EXPECT_EQ(stats.demotions, 3);
+    ASSERT_EQ(stats.level_dispatches.size(), MultiLevelFeedbackQueue::levels);
+    EXPECT_EQ(stats.level_dispatches[0], 1);
+    EXPECT_EQ(stats.level_dispatches[3], 1);
+    EXPECT_EQ(stats.total_context_switches, 0);
+    EXPECT_EQ(stats.interactive_completions, 0);
+}
+
+TEST(MLFQTest, ShortJobsOvertakeDemotedOnes){
+    MLFQScheduler scheduler(16, LatencyMode::Exact);
+    scheduler.ready_queue().configure(config(10ns, 0ns));
+    ProcessHandle hog = scheduler.add_process(1, 0ns, 1000ns);
+    ProcessHandle quick = scheduler.add_process(2, 15ns, 5ns);
+
+    scheduler.run_simulation();
+
+    // hog runs 0-10 and 10-30 (level 1), quick arrives at 15 and goes first at 30
+    const ProcessTable& table = scheduler.get_process_table();
+    EXPECT_EQ(table.start(quick).count(), 30);
+    EXPECT_EQ(table.completion(quick).count(), 35);
+    EXPECT_EQ(table.completion(hog).count(), 1005);
+    EXPECT_EQ(scheduler.get_stats().interactive_completions, 1);
+}
+
+TEST(MLFQTest, BoostLiftsEveryoneBackToTop){
+    MLFQScheduler scheduler(16);
+    scheduler.ready_queue().configure(config(10ns, 100ns));
+    scheduler.add_process(1, 0ns, 1000ns);
+    scheduler.add_process(2, 0ns, 1000ns);
+
+    scheduler.run_simulation();
+
+    auto stats = scheduler.get_stats();
+    EXPECT_GT(stats.priority_boosts, 0);
+    // without boosts the two would keep sinking, every boost restarts them at level 0
+    EXPECT_GE(stats.level_dispatches[0], 2 + stats.priority_boosts);
+    EXPECT_EQ(stats.total_processes_completed, 2);
+}
+
+TEST(MLFQTest, ReportsStarvation){
+    MLFQScheduler scheduler(16);
+    MLFQConfig c = config(10ns, 0ns);
+    c.starvation_threshold = 50ns;
+    scheduler.ready_queue().configure(c);
+    for(int pid = 1; pid <= 10; ++pid){
+        scheduler.add_process(pid, 0ns, 10ns);
+    }
+
+    scheduler.run_simulation();
+
+    // ten 10ns jobs in a row, the last four waited 60-90ns
+    auto stats = scheduler.get_stats();
+    EXPECT_EQ(stats.max_ready_wait.count(), 90);
+    EXPECT_EQ(stats.starved_dispatches, 4);
+    EXPECT_EQ(stats.interactive_completions, 10);
+}
+
+TEST(MLFQTest, BoostsCanBeTurnedOff){
+    MLFQScheduler scheduler(16);
+    scheduler.ready_queue().configure(config(10ns, 0ns));
+    for(int pid = 1; pid <= 4; ++pid){
+        scheduler.add_process(pid, 0ns, 100ns);
+    }
+
+    scheduler.run_simulation();
+
+    // no boosts, and without a threshold of its own no wait counts as starvation
+    auto stats = scheduler.get_stats();
+    EXPECT_EQ(stats.priority_boosts, 0);
+    EXPECT_EQ(stats.starved_dispatches, 0);
+    EXPECT_EQ(stats.total_processes_completed, 4);
+}
+
+TEST(MLFQTest, BoostKeepsQueueOrder){
+    ProcessTable table;
+    MultiLevelFeedbackQueue queue(table, 16);
+    queue.configure(config(10ns, 100ns));
+    std::vector<ProcessHandle> handles;
+    for(int pid = 0; pid < 4; ++pid){
+        handles.push_back(table.add(pid, 0ns, 1000ns));
+    }
+    // levels 1, 2, 1, 0: handles[1] is demoted twice
+    table.state(handles[0]) = Process::State::BLOCKED;
+    table.state(handles[1]) = Process::State::BLOCKED;
+    table.state(handles[2]) = Process::State::BLOCKED;
+    queue.push(handles[1]);
+    ASSERT_EQ(queue.pop(), handles[1]);
+    queue.push(handles[1]);
+    queue.push(handles[0]);
+    queue.push(handles[2]);
+    queue.push(handles[3]);
+    EXPECT_EQ(queue.level_bitmap(), 0b111u);
+
+    // the boost is applied at the next dispatch, level order then FIFO order is kept
+    ProcessHandle first = queue.pop();
+    EXPECT_EQ(first, handles[3]);
+    queue.time_slice(first, 100ns);
+    EXPECT_EQ(queue.level_bitmap(), 0b1u);
+    EXPECT_EQ(queue.pop(), handles[0]);
+    EXPECT_EQ(queue.pop(), handles[2]);
+    EXPECT_EQ(queue.pop(), handles[1]);
+}
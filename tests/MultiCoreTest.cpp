@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include "../src/MultiCoreScheduler.h"
+
+#include <random>
+
+namespace {
+
+struct Job {
+    int pid;
+    nanoseconds arrival;
+    nanoseconds burst;
+};
+
+std::vector<Job> make_jobs(size_t n, uint64_t seed, int64_t mean_gap){
+    std::mt19937_64 rng(seed);
+    std::exponential_distribution<double> gap(1.0 / static_cast<double>(mean_gap));
+    std::uniform_int_distribution<int64_t> burst(1, 100);
+
+    std::vector<Job> jobs;
+    jobs.reserve(n);
+    double t = 0;
+    for(size_t i = 0; i < n; ++i){
+        t += gap(rng);
+        jobs.push_back({static_cast<int>(i), nanoseconds(static_cast<int64_t>(t)), nanoseconds(burst(rng))});
+    }
+    return jobs;
+}
+
+template <typename Scheduler>
+void add_jobs(Scheduler& scheduler, const std::vector<Job>& jobs){
+    for(const Job& job : jobs){
+        scheduler.add_process(job.pid, job.arrival, job.burst);
+    }
+}
+
+} // namespace
+
+TEST(MultiCoreTest, SpreadsWorkOverCores){
+    MultiCoreFCFSScheduler scheduler(2, 10, LatencyMode::Exact);
+    for(int pid = 1; pid <= 4; ++pid){
+        scheduler.add_process(pid, 0ns, 10ns);
+    }
+
+    scheduler.run_simulation();
+
+    auto stats = scheduler.get_stats();
+    EXPECT_TRUE(scheduler.is_simulation_complete());
+    EXPECT_EQ(stats.total_processes_completed, 4);
+    EXPECT_EQ(stats.total_sim_time.count(), 20);
+    EXPECT_EQ(stats.core_busy_times, (std::vector<nanoseconds>{20ns, 20ns}));
+    EXPECT_DOUBLE_EQ(stats.core_utilization(0), 1.0);
+    EXPECT_DOUBLE_EQ(stats.load_imbalance(), 0.0);
+    EXPECT_EQ(stats.total_migrations, 0);
+}
+
+TEST(MultiCoreTest, IdleCoreStealsQueuedWork){
+    MultiCoreFCFSScheduler scheduler(2, 10, LatencyMode::Exact);
+    // A and B take the two idle cores, C and D are placed round robin behind them
+    ProcessHandle a = scheduler.add_process(1, 0ns, 100ns);
+    scheduler.add_process(2, 0ns, 10ns);
+    ProcessHandle c = scheduler.add_process(3, 0ns, 10ns);
+    scheduler.add_process(4, 0ns, 10ns);
+
+    scheduler.run_simulation();
+
+    // core 1 finishes B and D, then takes C from behind A instead of idling
+    const ProcessTable& table = scheduler.get_process_table();
+    EXPECT_EQ(table.completion(a).count(), 100);
+    EXPECT_EQ(table.start(c).count(), 20);
+    EXPECT_EQ(table.completion(c).count(), 30);
+
+    auto stats = scheduler.get_stats();
+    EXPECT_EQ(stats.total_migrations, 1);
+    EXPECT_EQ(stats.core_migrations, (std::vector<int>{0, 1}));
+    EXPECT_EQ(stats.core_busy_times, (std::vector<nanoseconds>{100ns, 30ns}));
+    EXPECT_NEAR(stats.load_imbalance(), 100.0 / 65.0 - 1.0, 1e-9);
+}
+
+TEST(MultiCoreTest, SingleCoreMatchesSimulationEngine){
+    auto jobs = make_jobs(2000, 7, 40);
+
+    RoundRobinScheduler single(64, LatencyMode::Exact, FixedQuantum{15ns});
+    MultiCoreRoundRobinScheduler multi(1, 64, LatencyMode::Exact, FixedQuantum{15ns});
+    add_jobs(single, jobs);
+    add_jobs(multi, jobs);
+
+    single.run_simulation();
+    multi.run_simulation();
+
+    auto expected = single.get_stats();
+    auto actual = multi.get_stats();
+    EXPECT_EQ(actual.total_processes_completed, expected.total_processes_completed);
+    EXPECT_EQ(actual.total_sim_time, expected.total_sim_time);
+    EXPECT_EQ(actual.total_context_switches, expected.total_context_switches);
+    EXPECT_EQ(actual.turnaround_times.samples(), expected.turnaround_times.samples());
+    EXPECT_EQ(actual.context_switch_latencies.samples(), expected.context_switch_latencies.samples());
+}
+
+TEST(MultiCoreTest, RunsAreDeterministic){
+    auto jobs = make_jobs(20000, 11, 5);
+
+    auto run = [&jobs](){
+        MultiCoreSJFScheduler scheduler(8, 32, LatencyMode::Exact);
+        add_jobs(scheduler, jobs);
+        scheduler.run_simulation();
+        return scheduler.get_stats();
+    };
+
+    auto first = run();
+    auto second = run();
+    EXPECT_EQ(first.total_processes_completed, 20000);
+    EXPECT_EQ(first.total_sim_time, second.total_sim_time);
+    EXPECT_EQ(first.total_migrations, second.total_migrations);
+    EXPECT_EQ(first.core_busy_times, second.core_busy_times);
+    EXPECT_EQ(first.waiting_times.samples(), second.waiting_times.samples());
+}
+
+// how long this takes as n grows is BM_MultiCore's job
+TEST(MultiCoreTest, ManyCoresManyProcesses){
+    const size_t n = 100000;
+    auto jobs = make_jobs(n, 3, 1);
+
+    MultiCoreFCFSScheduler scheduler(64, 1024);
+    scheduler.reserve(n);
+    add_jobs(scheduler, jobs);
+    scheduler.set_retire_callback([](ProcessHandle){});
+    scheduler.run_simulation();
+
+    auto stats = scheduler.get_stats();
+    EXPECT_EQ(stats.total_processes_completed, static_cast<int>(n));
+    EXPECT_EQ(scheduler.get_process_table().live(), 0u);
+
+    // every burst ran exactly once, on some core
+    nanoseconds bursts = 0ns;
+    for(const Job& job : jobs){
+        bursts += job.burst;
+    }
+    nanoseconds busy = 0ns;
+    for(nanoseconds core : stats.core_busy_times){
+        busy += core;
+    }
+    EXPECT_EQ(stats.core_busy_times.size(), 64u);
+    EXPECT_EQ(busy, bursts);
+    // idle cores are reused most-recent first, so some skew is expected below full load
+    EXPECT_LT(stats.load_imbalance(), 0.25);
+}
+
+TEST(MultiCoreTest, RunToCompletionKeepsNoSlotForTheRunningProcess){
+    // A never comes back to the queue, so B and C can fill both slots while A runs
+    MultiCoreFCFSScheduler scheduler(1, 2, LatencyMode::Exact);
+    EventTracer tracer(1, 64);
+    ASSERT_TRUE(scheduler.set_tracer(&tracer));
+    scheduler.add_process(1, 0ns, 10ns);
+    scheduler.add_process(2, 3ns, 10ns);
+    scheduler.add_process(3, 4ns, 10ns);
+    scheduler.run_simulation();
+
+    std::vector<int64_t> enqueued;
+    tracer.for_each(0, [&](const SchedEvent& event){
+        if(event.type == SchedEventType::Enqueue){
+            enqueued.push_back(event.time_ns);
+        }
+    });
+    EXPECT_EQ(enqueued, (std::vector<int64_t>{0, 3, 4}));
+    EXPECT_EQ(scheduler.get_stats().total_processes_completed, 3);
+}
+
+TEST(MultiCoreTest, LightLoadNeedsNoMigrations){
+    // arrivals spread out enough that there is always an idle core for them
+    MultiCoreSJFScheduler scheduler(4, 16, LatencyMode::Exact);
+    for(int pid = 0; pid < 100; ++pid){
+        scheduler.add_process(pid, nanoseconds(pid * 10), 25ns);
+    }
+
+    scheduler.run_simulation();
+
+    auto stats = scheduler.get_stats();
+    EXPECT_EQ(stats.total_processes_completed, 100);
+    EXPECT_EQ(stats.total_migrations, 0);
+    EXPECT_EQ(stats.waiting_times.percentile(100.0).count(), 0);
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "../src/SubmissionQueue.h"
+#include "../src/FCFSScheduler.h"
+#include "../src/SJFScheduler.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// every field filled in, the way SimulationEngine::submit builds them
+Submission submission(int pid, nanoseconds burst){
+    return Submission{pid, burst, 0, steady_clock::now()};
+}
+
+} // namespace
+
+TEST(SubmissionQueueTest, DrainsOnlyOnceClosedAndEmpty){
+    SubmissionQueue intake(2);
+    EXPECT_TRUE(intake.try_submit(submission(1, 10ns)));
+    EXPECT_TRUE(intake.try_submit(submission(2, 20ns)));
+    // full, a producer would have to wait
+    EXPECT_FALSE(intake.try_submit(submission(3, 30ns)));
+
+    intake.close();
+    EXPECT_FALSE(intake.submit(submission(4, 40ns)));
+    EXPECT_FALSE(intake.drained());
+    EXPECT_TRUE(intake.wait());
+
+    Submission taken[4];
+    ASSERT_EQ(intake.take(taken, 4), 2u);
+    EXPECT_EQ(taken[0].pid, 1);
+    EXPECT_EQ(taken[1].pid, 2);
+    EXPECT_TRUE(intake.drained());
+    EXPECT_FALSE(intake.wait());
+}
+
+TEST(OnlineTest, SubmissionsBeforeTheRunArriveAtTheStart){
+    FCFSScheduler scheduler(8);
+    scheduler.open_intake(4);
+    scheduler.add_process(1, 0ns, 10ns);
+    EXPECT_TRUE(scheduler.submit(2, 20ns));
+    EXPECT_TRUE(scheduler.submit(3, 30ns));
+    scheduler.shutdown();
+    EXPECT_FALSE(scheduler.submit(4, 40ns));
+    scheduler.run_online();
+
+    SchedulerStats stats = scheduler.get_stats();
+    EXPECT_EQ(stats.total_processes_completed, 3);
+    EXPECT_EQ(stats.submitted, 2);
+    EXPECT_EQ(stats.submit_latencies.size(), 2u);
+    EXPECT_EQ(stats.total_sim_time, 60ns);
+    // the added process came first and waited for nothing
+    EXPECT_EQ(stats.waiting_times.mean(), (0ns + 10ns + 30ns) / 3);
+    // finished processes are released once the intake is open
+    EXPECT_EQ(scheduler.get_process_table().live(), 0u);
+}
+
+TEST(OnlineTest, SubmitWithoutIntakeFails){
+    SJFScheduler scheduler(8);
+    EXPECT_FALSE(scheduler.submit(1, 10ns));
+    EXPECT_FALSE(scheduler.try_submit(1, 10ns));
+}
+
+TEST(OnlineTest, WaitsForSubmissionsUntilShutdown){
+    SJFScheduler scheduler(8);
+    scheduler.open_intake(4);
+    std::thread loop([&]{ scheduler.run_online(); });
+
+    auto wait_for_completions = [&](int n){
+        for(int spin = 0; spin < 100000 && scheduler.get_stats().total_processes_completed < n; ++spin){
+            std::this_thread::yield();
+        }
+        return scheduler.get_stats().total_processes_completed;
+    };
+
+    // everything submitted so far finishes and the loop keeps waiting
+    ASSERT_TRUE(scheduler.submit(1, 10ns));
+    EXPECT_EQ(wait_for_completions(1), 1);
+    ASSERT_TRUE(scheduler.submit(2, 10ns));
+    EXPECT_EQ(wait_for_completions(2), 2);
+
+    scheduler.shutdown();
+    loop.join();
+    SchedulerStats stats = scheduler.get_stats();
+    EXPECT_EQ(stats.submitted, 2);
+    EXPECT_EQ(stats.total_processes_completed, 2);
+    EXPECT_GT(stats.online_wall_time, 0ns);
+}
+
+TEST(OnlineTest, ManyProducersWithBoundedMemory){
+    constexpr int producers = 4;
+    constexpr int per_producer = 5000;
+    FCFSScheduler scheduler(16);
+    scheduler.open_intake(8);
+    std::atomic<int> retired = 0;
+    scheduler.set_retire_callback([&](ProcessHandle){ retired++; });
+    std::thread loop([&]{ scheduler.run_online(); });
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < producers; ++t){
+        threads.emplace_back([&, t]{
+            for(int i = 0; i < per_producer; ++i){
+                ASSERT_TRUE(scheduler.submit(t * per_producer + i, nanoseconds(1 + i % 7)));
+            }
+        });
+    }
+    for(std::thread& thread : threads){
+        thread.join();
+    }
+    scheduler.shutdown();
+    loop.join();
+
+    SchedulerStats stats = scheduler.get_stats();
+    EXPECT_EQ(stats.submitted, producers * per_producer);
+    EXPECT_EQ(stats.total_processes_completed, producers * per_producer);
+    EXPECT_EQ(stats.submit_latencies.size(), static_cast<size_t>(producers * per_producer));
+    EXPECT_EQ(retired.load(), producers * per_producer);
+    EXPECT_GT(stats.submission_rate(), 0.0);
+    // never more slots than ready queue plus intake capacity, however much was submitted
+    const ProcessTable& table = scheduler.get_process_table();
+    EXPECT_EQ(table.live(), 0u);
+    EXPECT_LE(table.size(), 16u + 8u);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "../src/ParameterSweep.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace {
+
+SweepSpec small_spec(){
+    SweepSpec spec;
+    spec.policies = {"fcfs", "rr", "eevdf"};
+    spec.queue_capacities = {16, 256};
+    spec.quanta = {10ns, 40ns};
+    spec.seeds = {1, 2, 3};
+    spec.processes = 2000;
+    return spec;
+}
+
+} // namespace
+
+TEST(ParameterSweepTest, PointsSkipUnusedQuanta){
+    SweepSpec spec = small_spec();
+    std::vector<SweepPoint> points = spec.points();
+
+    // fcfs: 2 capacities x 3 seeds, rr and eevdf: 2 capacities x 2 quanta x 3 seeds
+    ASSERT_EQ(points.size(), 6u + 12u + 12u);
+    EXPECT_EQ(points[0].policy, "fcfs");
+    EXPECT_EQ(points[0].quantum, 0ns);
+    EXPECT_EQ(points[0].seed, 1u);
+    EXPECT_EQ(points[1].seed, 2u);
+    EXPECT_EQ(points[6].policy, "rr");
+    EXPECT_EQ(points[6].quantum, 10ns);
+}
+
+TEST(ParameterSweepTest, PolicyNames){
+    EXPECT_TRUE(is_sweep_policy("srtf"));
+    EXPECT_TRUE(is_sweep_policy("cfs"));
+    EXPECT_FALSE(is_sweep_policy("random"));
+    EXPECT_TRUE(sweep_policy_uses_quantum("mlfq"));
+    EXPECT_FALSE(sweep_policy_uses_quantum("sjf"));
+}
+
+TEST(ParameterSweepTest, ParallelRunsMatchSerialRuns){
+    SweepSpec spec = small_spec();
+    ParameterSweep sweep(4);
+    std::vector<SweepResult> results = sweep.run(spec);
+
+    std::vector<SweepPoint> points = spec.points();
+    ASSERT_EQ(results.size(), points.size());
+    for(size_t i = 0; i < results.size(); ++i){
+        const SweepResult& result = results[i];
+        EXPECT_EQ(result.point.policy, points[i].policy);
+        EXPECT_EQ(result.point.seed, points[i].seed);
+
+        // every run is deterministic, so doing it again here must give the same numbers
+        WorkloadConfig config = spec.workload;
+        config.seed = points[i].seed;
+        SchedulerStats serial = run_sweep_point(points[i], generate_workload(config, spec.processes));
+        EXPECT_EQ(result.stats.total_processes_completed, 2000);
+        EXPECT_EQ(result.stats.total_sim_time, serial.total_sim_time) << result.point.policy;
+        EXPECT_EQ(result.stats.turnaround_times.mean(), serial.turnaround_times.mean()) << result.point.policy;
+        EXPECT_EQ(result.stats.total_context_switches, serial.total_context_switches) << result.point.policy;
+    }
+}
+
+TEST(ParameterSweepTest, SummaryMergesSeeds){
+    SweepSpec spec = small_spec();
+    std::vector<SweepResult> results = ParameterSweep(2).run(spec);
+    std::vector<SweepRow> rows = summarize_sweep(results);
+
+    ASSERT_EQ(rows.size(), 2u + 4u + 4u);
+    for(const SweepRow& row : rows){
+        EXPECT_EQ(row.runs, 3u);
+        EXPECT_EQ(row.stats.total_processes_completed, 3 * 2000);
+    }
+    EXPECT_EQ(rows[0].policy, "fcfs");
+    EXPECT_EQ(rows[0].queue_capacity, 16);
+
+    // the merged row is the same as merging the three runs by hand
+    SchedulerStats merged;
+    for(size_t i = 0; i < 3; ++i){
+        merged.merge(results[i].stats);
+    }
+    EXPECT_EQ(rows[0].stats.total_sim_time, merged.total_sim_time);
+    EXPECT_EQ(rows[0].stats.turnaround_times.mean(), merged.turnaround_times.mean());
+}
+
+TEST(ParameterSweepTest, FixedWorkloadIgnoresSeeds){
+    SweepSpec spec = small_spec();
+    spec.policies = {"sjf", "srtf"};
+    SweepWorkload workload = generate_workload(spec.workload, 500);
+
+    std::vector<SweepResult> results = ParameterSweep(2).run(spec, workload);
+    ASSERT_EQ(results.size(), 4u);
+    for(const SweepResult& result : results){
+        EXPECT_EQ(result.point.seed, 0u);
+        EXPECT_EQ(result.stats.total_processes_completed, 500);
+    }
+}
+
+TEST(ParameterSweepTest, UnknownPolicyRunsNothing){
+    SweepSpec spec = small_spec();
+    spec.policies = {"fcfs", "random"};
+    EXPECT_TRUE(ParameterSweep(2).run(spec).empty());
+}
+
+TEST(ParameterSweepTest, WritesCSV){
+    SweepSpec spec = small_spec();
+    spec.policies = {"fcfs"};
+    std::vector<SweepRow> rows = summarize_sweep(ParameterSweep(2).run(spec));
+    std::string path = ::testing::TempDir() + "sweep_test.csv";
+    ASSERT_TRUE(write_sweep_csv(rows, path));
+
+    std::ifstream in(path);
+    std::string line;
+    ASSERT_TRUE(std::getline(in, line));
+    EXPECT_EQ(line.rfind("policy,queue_capacity,quantum_ns,runs,", 0), 0u);
+    size_t lines = 0;
+    while(std::getline(in, line)){
+        EXPECT_EQ(line.rfind("fcfs,", 0), 0u);
+        lines++;
+    }
+    EXPECT_EQ(lines, rows.size());
+    std::remove(path.c_str());
+}
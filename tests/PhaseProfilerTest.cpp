@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "../src/SimulationEngine.h"
+#include "../src/FCFSScheduler.h"
+
+// built with SCHEDULER_PROFILE=1 whatever the rest of the tree uses, see tests/CMakeLists.txt.
+// the engine below is a local instantiation so it can't be mixed up with the library's
+// FCFSScheduler, which may have been compiled without the profiler
+static_assert(SCHEDULER_PROFILE, "PhaseProfilerTests must be built with SCHEDULER_PROFILE=1");
+
+namespace {
+
+struct ProfiledClock : RunToCompletion {};
+
+using ProfiledFCFS = SimulationEngine<FifoReadyQueue, ProfiledClock>;
+
+void spin_for(microseconds duration){
+    auto end = steady_clock::now() + duration;
+    while(steady_clock::now() < end){}
+}
+
+} // namespace
+
+TEST(PhaseProfilerTest, ChargesTimeToTheOpenPhase){
+    PhaseProfiler profiler;
+    auto begin = steady_clock::now();
+    profiler.start();
+    {
+        PhaseScope pick(profiler, SimPhase::Pick);
+        spin_for(2000us);
+        {
+            PhaseScope stats(profiler, SimPhase::Stats);
+            spin_for(1000us);
+        }
+    }
+    profiler.stop();
+    nanoseconds wall = steady_clock::now() - begin;
+
+    const PhaseProfile& profile = profiler.profile();
+    ASSERT_FALSE(profile.empty());
+    EXPECT_EQ(profile[SimPhase::Pick].entries, 1u);
+    EXPECT_EQ(profile[SimPhase::Stats].entries, 1u);
+    // lower bounds only, with plenty of slack: a busy machine can stretch the spins but
+    // never shorten them
+    EXPECT_GE(profile.time(SimPhase::Pick), 1000us);
+    EXPECT_GE(profile.time(SimPhase::Stats), 500us);
+    EXPECT_GT(profile.share(SimPhase::Stats), profile.share(SimPhase::Dispatch));
+    EXPECT_EQ(profile[SimPhase::Dispatch].ticks, 0u);
+
+    // nested phases are exclusive: pick doesn't include the time spent in stats, so the
+    // phases add up to the run rather than overshooting it by the stats spin
+    nanoseconds total = 0ns;
+    for(size_t p = 0; p < sim_phase_count; ++p){
+        total += profile.time(static_cast<SimPhase>(p));
+    }
+    EXPECT_LT(total, wall + profile.time(SimPhase::Stats) / 2);
+}
+
+TEST(PhaseProfilerTest, ProfilesEveryPhaseOfASimulation){
+    ProfiledFCFS scheduler(64);
+    for(int pid = 0; pid < 1000; ++pid){
+        // a gap after every tenth process so the clock has to skip
+        scheduler.add_process(pid, nanoseconds(pid * 10 + (pid / 10) * 1000), 5ns);
+    }
+    scheduler.run_simulation();
+
+    PhaseProfile profile = scheduler.get_profile();
+    ASSERT_FALSE(profile.empty());
+    EXPECT_EQ(profile[SimPhase::Dispatch].entries, 1000u);
+    EXPECT_EQ(profile[SimPhase::Stats].entries, 1000u);
+    EXPECT_GE(profile[SimPhase::Pick].entries, 1000u);
+    EXPECT_GT(profile[SimPhase::Arrivals].entries, 0u);
+    EXPECT_GT(profile[SimPhase::ClockSkip].entries, 0u);
+    double total_share = 0.0;
+    for(size_t p = 0; p < sim_phase_count; ++p){
+        total_share += profile.share(static_cast<SimPhase>(p));
+    }
+    EXPECT_NEAR(total_share, 1.0, 1e-9);
+}
+
+TEST(PhaseProfilerTest, MergeAddsRuns){
+    ProfiledFCFS scheduler(64);
+    for(int pid = 0; pid < 100; ++pid){
+        scheduler.add_process(pid, nanoseconds(pid * 10), 5ns);
+    }
+    scheduler.run_simulation();
+
+    PhaseProfile merged;
+    merged.merge(scheduler.get_profile());
+    merged.merge(scheduler.get_profile());
+    EXPECT_EQ(merged[SimPhase::Dispatch].entries, 200u);
+    EXPECT_EQ(merged.ticks_per_ns, scheduler.get_profile().ticks_per_ns);
+}
+
+TEST(PhaseProfilerTest, HardwareCounters){
+    ProfiledFCFS scheduler(64);
+    if(!scheduler.enable_hardware_counters()){
+        GTEST_SKIP() << "perf_event_open is not available here";
+    }
+    for(int pid = 0; pid < 1000; ++pid){
+        scheduler.add_process(pid, nanoseconds(pid * 10), 5ns);
+    }
+    scheduler.run_simulation();
+
+    PhaseProfile profile = scheduler.get_profile();
+    ASSERT_TRUE(profile.has_counter(HardwareCounter::Cycles));
+    EXPECT_GT(profile[SimPhase::Dispatch].event(HardwareCounter::Cycles), 0u);
+    if(profile.has_counter(HardwareCounter::Instructions)){
+        EXPECT_GT(profile[SimPhase::Dispatch].event(HardwareCounter::Instructions), 0u);
+    }
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "../src/RoundRobinScheduler.h"
+#include "../src/SRTFScheduler.h"
+
+TEST(RoundRobinTest, SlicesByQuantum){
+    RoundRobinScheduler scheduler(10, LatencyMode::Exact, FixedQuantum{10ns});
+    ProcessHandle a = scheduler.add_process(1, 0ns, 30ns);
+    ProcessHandle b = scheduler.add_process(2, 0ns, 20ns);
+
+    scheduler.run_simulation();
+
+    // A 0-10, B 10-20, A 20-30, B 30-40, A 40-50
+    const ProcessTable& table = scheduler.get_process_table();
+    EXPECT_EQ(table.completion(b).count(), 40);
+    EXPECT_EQ(table.completion(a).count(), 50);
+    EXPECT_EQ(table.context_switches(a), 2u);
+    EXPECT_EQ(table.context_switches(b), 1u);
+
+    auto stats = scheduler.get_stats();
+    EXPECT_EQ(stats.total_context_switches, 3);
+    EXPECT_EQ(stats.context_switch_latencies.samples(), (std::vector<nanoseconds>{10ns, 10ns, 10ns}));
+    EXPECT_EQ(stats.total_sim_time.count(), 50);
+}
+
+TEST(RoundRobinTest, ArrivalsQueueAheadOfPreemptedProcess){
+    RoundRobinScheduler scheduler(10, LatencyMode::Exact, FixedQuantum{10ns});
+    ProcessHandle a = scheduler.add_process(1, 0ns, 20ns);
+    ProcessHandle b = scheduler.add_process(2, 5ns, 10ns);
+
+    scheduler.run_simulation();
+
+    // B arrived during A's first quantum, so it runs before A resumes
+    const ProcessTable& table = scheduler.get_process_table();
+    EXPECT_EQ(table.start(b).count(), 10);
+    EXPECT_EQ(table.completion(b).count(), 20);
+    EXPECT_EQ(table.completion(a).count(), 30);
+}
+
+TEST(RoundRobinTest, LongBurstsCostOneEventPerQuantum){
+    // a burst of 10^12ns with a 10^9ns quantum is 1000 slices, not 10^12 steps
+    RoundRobinScheduler scheduler(4, LatencyMode::Histogram, FixedQuantum{1000000000ns});
+    scheduler.add_process(1, 0ns, 1000000000000ns);
+    scheduler.add_process(2, 0ns, 1000000000000ns);
+
+    scheduler.run_simulation();
+
+    auto stats = scheduler.get_stats();
+    EXPECT_EQ(stats.total_processes_completed, 2);
+    EXPECT_EQ(stats.total_sim_time.count(), 2000000000000);
+    EXPECT_EQ(stats.total_context_switches, 1998);
+}
+
+TEST(RoundRobinTest, PreemptedProcessSurvivesFullQueue){
+    RoundRobinScheduler scheduler(2, LatencyMode::Exact, FixedQuantum{5ns});
+    for(int pid = 1; pid <= 6; ++pid){
+        scheduler.add_process(pid, 0ns, 12ns);
+    }
+
+    scheduler.run_simulation();
+
+    EXPECT_EQ(scheduler.get_stats().total_processes_completed, 6);
+    EXPECT_EQ(scheduler.get_stats().total_sim_time.count(), 72);
+    EXPECT_TRUE(scheduler.is_simulation_complete());
+}
+
+TEST(RoundRobinTest, LogsUnderItsOwnName){
+    // the ready queues are FCFS's and SJF's, the names come from the clock policies
+    EXPECT_STREQ(RoundRobinScheduler::name, "RoundRobin");
+    EXPECT_STREQ(SRTFScheduler::name, "SRTF");
+    EXPECT_STREQ((SimulationEngine<FifoReadyQueue, RunToCompletion>::name), "FCFS");
+}
+
+TEST(SRTFTest, ShorterArrivalPreempts){
+    SRTFScheduler scheduler(10, LatencyMode::Exact);
+    ProcessHandle a = scheduler.add_process(1, 0ns, 50ns);
+    ProcessHandle b = scheduler.add_process(2, 10ns, 5ns);
+
+    scheduler.run_simulation();
+
+    const ProcessTable& table = scheduler.get_process_table();
+    EXPECT_EQ(table.start(b).count(), 10);
+    EXPECT_EQ(table.completion(b).count(), 15);
+    EXPECT_EQ(table.completion(a).count(), 55);
+    EXPECT_EQ(table.context_switches(a), 1u);
+    EXPECT_EQ(scheduler.get_stats().context_switch_latencies.samples(), (std::vector<nanoseconds>{5ns}));
+}
+
+TEST(SRTFTest, LongerArrivalDoesNotCountAsSwitch){
+    SRTFScheduler scheduler(10, LatencyMode::Exact);
+    ProcessHandle a = scheduler.add_process(1, 0ns, 10ns);
+    ProcessHandle b = scheduler.add_process(2, 5ns, 20ns);
+
+    scheduler.run_simulation();
+
+    // A is sliced at B's arrival but is still the shortest, so it keeps running
+    const ProcessTable& table = scheduler.get_process_table();
+    EXPECT_EQ(table.completion(a).count(), 10);
+    EXPECT_EQ(table.completion(b).count(), 30);
+    EXPECT_EQ(scheduler.get_stats().total_context_switches, 0);
+    EXPECT_TRUE(scheduler.get_stats().context_switch_latencies.empty());
+}
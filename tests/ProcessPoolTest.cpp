@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "../src/ProcessPool.h"
+#include "../src/FCFSScheduler.h"
+
+// count every allocation in this test binary, to check the pool stays off the heap
+static std::atomic<size_t> allocations = 0;
+
+void* operator new(std::size_t size){
+    allocations++;
+    if(void* p = std::malloc(size ? size : 1)){
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+TEST(ProcessPoolTest, CreatesWorkingProcesses){
+    ProcessPool pool(4);
+    Process* p = pool.create(7, 10ns, 100ns);
+    EXPECT_EQ(p->pid, 7);
+    EXPECT_EQ(p->current_state.load(), Process::State::READY);
+    EXPECT_TRUE(p->task);
+
+    p->execute_slice(20ns);
+    EXPECT_EQ(p->current_state.load(), Process::State::COMPLETED);
+    EXPECT_EQ(p->completion_time.load().count(), 120);
+}
+
+TEST(ProcessPoolTest, PointersSurviveNewSlabs){
+    ProcessPool pool(8);
+    std::vector<Process*> processes;
+    for(int pid = 0; pid < 100; ++pid){
+        processes.push_back(pool.create(pid, nanoseconds(pid), 5ns));
+    }
+
+    EXPECT_EQ(pool.size(), 100u);
+    EXPECT_EQ(pool.capacity(), 104u);
+    for(int pid = 0; pid < 100; ++pid){
+        EXPECT_EQ(processes[pid]->pid, pid);
+        EXPECT_EQ(processes[pid]->arrival_time.count(), pid);
+    }
+}
+
+TEST(ProcessPoolTest, ClearKeepsSlabsForReuse){
+    ProcessPool pool(16);
+    for(int pid = 0; pid < 40; ++pid){
+        pool.create(pid, 0ns, 1ns);
+    }
+    size_t capacity = pool.capacity();
+    pool.clear();
+    EXPECT_EQ(pool.size(), 0u);
+    EXPECT_EQ(pool.capacity(), capacity);
+
+    pool.release();
+    EXPECT_EQ(pool.capacity(), 0u);
+}
+
+TEST(ProcessPoolTest, CreatingProcessesDoesNotAllocate){
+    constexpr int count = 10000;
+    ProcessPool pool(1024);
+    pool.reserve(count);
+
+    size_t before = allocations.load();
+    int ran = 0;
+    for(int pid = 0; pid < count; ++pid){
+        Process* p = pool.create(pid, 0ns, 10ns);
+        // a task capturing a couple of references stays inline too
+        p->task = [&ran, p]{ ran += p->pid >= 0; };
+        p->task();
+    }
+    pool.clear();
+
+    EXPECT_EQ(allocations.load(), before);
+    EXPECT_EQ(ran, count);
+}
+
+TEST(ProcessPoolTest, FeedsASimulation){
+    ProcessPool pool;
+    std::vector<Process*> processes;
+    {
+        FCFSScheduler scheduler(16);
+        for(int pid = 0; pid < 10; ++pid){
+            processes.push_back(pool.create(pid, nanoseconds(pid * 10), 5ns));
+            scheduler.add_process(processes.back());
+        }
+        scheduler.run_simulation();
+    }
+
+    // the results were written back through the pooled pointers
+    for(const Process* p : processes){
+        EXPECT_EQ(p->current_state.load(), Process::State::COMPLETED);
+        EXPECT_EQ(p->get_turnaround_time().count(), 5);
+    }
+}
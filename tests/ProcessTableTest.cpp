@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "../src/ProcessTable.h"
+
+TEST(ProcessTableTest, AddsReadyProcesses){
+    ProcessTable table;
+    ProcessHandle a = table.add(7, 10ns, 100ns);
+    ProcessHandle b = table.add(8, 20ns, 50ns);
+
+    EXPECT_EQ(a, 0u);
+    EXPECT_EQ(b, 1u);
+    EXPECT_EQ(table.pid(b), 8);
+    EXPECT_EQ(table.arrival(b).count(), 20);
+    EXPECT_EQ(table.remaining(b).count(), 50);
+    EXPECT_EQ(table.state(a), Process::State::READY);
+    EXPECT_EQ(table.owner(a), nullptr);
+    EXPECT_EQ(table.live(), 2u);
+}
+
+TEST(ProcessTableTest, ExecuteSliceTracksLifecycle){
+    ProcessTable table;
+    ProcessHandle h = table.add(1, 0ns, 100ns);
+
+    EXPECT_FALSE(table.execute_slice(h, 10ns, 40ns));
+    EXPECT_EQ(table.start(h).count(), 10);
+    EXPECT_EQ(table.remaining(h).count(), 60);
+    EXPECT_EQ(table.state(h), Process::State::BLOCKED);
+
+    // resuming counts as a context switch, slices are capped at what's left
+    EXPECT_TRUE(table.execute_slice(h, 80ns, 1000ns));
+    EXPECT_EQ(table.context_switches(h), 1u);
+    EXPECT_EQ(table.completion(h).count(), 140);
+    EXPECT_EQ(table.state(h), Process::State::COMPLETED);
+    EXPECT_EQ(table.turnaround(h).count(), 140);
+    EXPECT_EQ(table.waiting(h).count(), 40);
+    EXPECT_EQ(table.response(h).count(), 10);
+}
+
+TEST(ProcessTableTest, SyncsOwnerProcess){
+    ProcessTable table;
+    Process p(3, 5ns, 20ns);
+    ProcessHandle h = table.add(p.pid, p.arrival_time, p.burst_time, &p);
+
+    table.execute_slice(h, 5ns, table.remaining(h));
+    table.sync_owner(h);
+
+    EXPECT_EQ(table.owner(h), &p);
+    EXPECT_EQ(p.current_state.load(), Process::State::COMPLETED);
+    EXPECT_EQ(p.get_turnaround_time().count(), 20);
+    EXPECT_EQ(p.remaining_time.load().count(), 0);
+}
+
+TEST(ProcessTableTest, ReleasedSlotsAreReused){
+    ProcessTable table;
+    Process p(1, 0ns, 10ns);
+    ProcessHandle a = table.add(1, 0ns, 10ns, &p);
+    table.add(2, 0ns, 10ns);
+
+    table.release(a);
+    EXPECT_EQ(table.live(), 1u);
+
+    ProcessHandle c = table.add(3, 5ns, 30ns);
+    EXPECT_EQ(c, a);
+    EXPECT_EQ(table.size(), 2u);
+    EXPECT_EQ(table.pid(c), 3);
+    EXPECT_EQ(table.remaining(c).count(), 30);
+    EXPECT_EQ(table.state(c), Process::State::READY);
+    EXPECT_EQ(table.owner(c), nullptr);
+}
+
+TEST(ProcessTableTest, TenMillionProcessesFitInAFewHundredMegabytes){
+    const size_t n = 10000000;
+    ProcessTable table;
+    table.reserve(n);
+    for(size_t i = 0; i < n; ++i){
+        table.add(static_cast<int>(i), std::chrono::nanoseconds(i), 10ns);
+    }
+
+    EXPECT_EQ(table.live(), n);
+    EXPECT_LE(table.memory_bytes() / n, 64u);
+    EXPECT_LT(table.memory_bytes(), 700u * 1024 * 1024);
+}
+
+TEST(ProcessTableTest, AlternatesCpuAndIoBursts){
+    ProcessTable table;
+    ProcessHandle h = table.add(1, 0ns, 1ns);
+    const nanoseconds even[] = {10ns, 5ns};
+    const nanoseconds empty_cpu[] = {10ns, 5ns, 0ns};
+    EXPECT_FALSE(table.set_bursts(h, even));
+    EXPECT_FALSE(table.set_bursts(h, empty_cpu));
+    EXPECT_FALSE(table.has_io(h));
+
+    const nanoseconds bursts[] = {10ns, 100ns, 20ns};
+    ASSERT_TRUE(table.set_bursts(h, bursts));
+    EXPECT_TRUE(table.has_io(h));
+    EXPECT_EQ(table.burst(h), 30ns);
+    EXPECT_EQ(table.io_time(h), 100ns);
+
+    // a slice never runs past the end of the cpu burst
+    EXPECT_FALSE(table.execute_slice(h, 0ns, 50ns));
+    EXPECT_EQ(table.burst_left(h), 0ns);
+    EXPECT_EQ(table.start_io(h), 100ns);
+    EXPECT_EQ(table.state(h), Process::State::IO_WAIT);
+    EXPECT_EQ(table.burst_left(h), 20ns);
+
+    EXPECT_TRUE(table.execute_slice(h, 110ns, 50ns));
+    EXPECT_EQ(table.context_switches(h), 1u);
+    EXPECT_EQ(table.completion(h), 130ns);
+    // the I/O isn't counted as waiting
+    EXPECT_EQ(table.waiting(h), 0ns);
+
+    table.release(h);
+    ProcessHandle reused = table.add(2, 0ns, 5ns);
+    EXPECT_EQ(reused, h);
+    EXPECT_FALSE(table.has_io(reused));
+    EXPECT_EQ(table.burst_left(reused), 5ns);
+}
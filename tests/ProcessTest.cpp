@@ -1,6 +1,35 @@
-#include <iostream>
+#include <gtest/gtest.h>
+#include "../src/Process.h"
 
-int main() {
-    std::cout << "Hello from ProcessTest.cpp" << std::endl;
-    return 0;
+TEST(ProcessTest, RunsWholeBurstByDefault){
+    Process p(1, 10ns, 100ns);
+
+    p.execute_slice(20ns);
+
+    EXPECT_EQ(p.current_state.load(), Process::State::COMPLETED);
+    EXPECT_EQ(p.remaining_time.load().count(), 0);
+    EXPECT_EQ(p.completion_time.load().count(), 120);
+    EXPECT_EQ(p.get_response_time().count(), 10);
+    EXPECT_EQ(p.get_waiting_time().count(), 10);
+}
+
+TEST(ProcessTest, SlicesBurst){
+    Process p(1, 0ns, 100ns);
+
+    p.execute_slice(0ns, 30ns);
+    EXPECT_EQ(p.current_state.load(), Process::State::BLOCKED);
+    EXPECT_EQ(p.remaining_time.load().count(), 70);
+    EXPECT_EQ(p.last_run_timestamp.load().count(), 30);
+
+    // resuming after being switched out
+    p.execute_slice(50ns, 30ns);
+    EXPECT_EQ(p.context_switches.load(), 1);
+    EXPECT_EQ(p.last_latency.load().count(), 20);
+    EXPECT_EQ(p.remaining_time.load().count(), 40);
+
+    // a slice longer than what's left only runs what's left
+    p.execute_slice(100ns, 1000ns);
+    EXPECT_EQ(p.current_state.load(), Process::State::COMPLETED);
+    EXPECT_EQ(p.completion_time.load().count(), 140);
+    EXPECT_EQ(p.context_switches.load(), 2);
 }
\ No newline at end of file
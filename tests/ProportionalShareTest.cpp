@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "../src/ProportionalShareScheduler.h"
+#include "../src/ParameterSweep.h"
+
+#include <vector>
+
+namespace {
+
+ProportionalShareConfig config(nanoseconds quantum, uint64_t seed = 1){
+    ProportionalShareConfig c;
+    c.quantum = quantum;
+    c.seed = seed;
+    return c;
+}
+
+// two processes with 3:1 tickets that arrive together, A needs as much CPU as B
+template <typename Scheduler>
+SchedulerStats run_three_to_one(Scheduler& scheduler, Process& a, Process& b){
+    a.tickets = 300;
+    b.tickets = 100;
+    scheduler.add_process(&a);
+    scheduler.add_process(&b);
+    scheduler.run_simulation();
+    return scheduler.get_stats();
+}
+
+} // namespace
+
+TEST(ProportionalShareTest, TicketsDefaultToTheNiceWeight){
+    ProcessTable table;
+    ProcessHandle h = table.add(1, 0ns, 10ns);
+    EXPECT_EQ(table.tickets(h), nice_0_weight);
+    table.set_nice(h, 19);
+    EXPECT_EQ(table.tickets(h), 15u);
+    table.set_tickets(h, 7);
+    EXPECT_EQ(table.tickets(h), 7u);
+    table.set_tickets(h, 0);
+    EXPECT_EQ(table.tickets(h), 15u);
+
+    // a reused slot doesn't keep the tickets of the process before it
+    table.set_tickets(h, 7);
+    table.release(h);
+    ProcessHandle reused = table.add(2, 0ns, 10ns);
+    ASSERT_EQ(reused, h);
+    EXPECT_EQ(table.tickets(reused), nice_0_weight);
+}
+
+TEST(ProportionalShareTest, LotteryDrawsByTickets){
+    ProcessTable table;
+    std::vector<uint32_t> tickets = {1, 2, 7};
+    for(size_t i = 0; i < tickets.size(); ++i){
+        table.set_tickets(table.add(static_cast<int>(i), 0ns, 10ns), tickets[i]);
+    }
+    LotteryReadyQueue queue(table, 8);
+    for(ProcessHandle h = 0; h < tickets.size(); ++h){
+        ASSERT_TRUE(queue.push(h));
+    }
+    EXPECT_EQ(queue.total_tickets(), 10u);
+
+    constexpr int draws = 100000;
+    std::vector<int> wins(tickets.size());
+    for(int i = 0; i < draws; ++i){
+        ProcessHandle h = queue.pop();
+        ASSERT_NE(h, invalid_process_handle);
+        wins[h]++;
+        queue.push(h);
+    }
+    for(size_t h = 0; h < tickets.size(); ++h){
+        EXPECT_NEAR(static_cast<double>(wins[h]) / draws, tickets[h] / 10.0, 0.01);
+    }
+}
+
+TEST(ProportionalShareTest, LotteryEmptiesALargeQueue){
+    constexpr size_t n = size_t(1) << 18;
+    ProcessTable table;
+    table.reserve(n);
+    LotteryReadyQueue queue(table, n);
+    for(size_t i = 0; i < n; ++i){
+        ProcessHandle h = table.add(static_cast<int>(i), 0ns, 10ns);
+        table.set_tickets(h, static_cast<uint32_t>(1 + i % 5));
+        ASSERT_TRUE(queue.push(h));
+    }
+    EXPECT_FALSE(queue.push(table.add(-1, 0ns, 10ns)));
+
+    // every process is drawn exactly once
+    std::vector<bool> seen(n);
+    for(size_t i = 0; i < n; ++i){
+        ProcessHandle h = queue.pop();
+        ASSERT_LT(h, n);
+        ASSERT_FALSE(seen[h]);
+        seen[h] = true;
+    }
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.total_tickets(), 0u);
+    EXPECT_EQ(queue.pop(), invalid_process_handle);
+}
+
+TEST(ProportionalShareTest, LotteryIsDeterministicUnderASeed){
+    auto completions = [](uint64_t seed){
+        LotteryScheduler scheduler(64);
+        scheduler.ready_queue().configure(config(5ns, seed));
+        for(int pid = 0; pid < 16; ++pid){
+            scheduler.add_process(pid, nanoseconds(pid * 3), nanoseconds(20 + pid * 7), pid % 5 - 2);
+        }
+        scheduler.run_simulation();
+        const ProcessTable& table = scheduler.get_process_table();
+        std::vector<nanoseconds> times;
+        for(ProcessHandle h = 0; h < table.size(); ++h){
+            times.push_back(table.completion(h));
+        }
+        return times;
+    };
+    EXPECT_EQ(completions(42), completions(42));
+    EXPECT_NE(completions(42), completions(43));
+}
+
+TEST(ProportionalShareTest, StrideSharesByTickets){
+    StrideScheduler scheduler(8);
+    scheduler.ready_queue().configure(config(10ns));
+    Process a(1, 0ns, 300ns);
+    Process b(2, 0ns, 300ns);
+    SchedulerStats stats = run_three_to_one(scheduler, a, b);
+
+    // A gets three quanta for each of B's until it is done, then B runs alone
+    EXPECT_NEAR(static_cast<double>(a.completion_time.load().count()), 400.0, 10.0);
+    EXPECT_EQ(b.completion_time.load(), 600ns);
+    EXPECT_GT(stats.share_cpu, 0.0);
+    EXPECT_LT(stats.share_accuracy_error(), 0.02);
+}
+
+TEST(ProportionalShareTest, LotterySharesByTicketsOnAverage){
+    LotteryScheduler scheduler(8);
+    scheduler.ready_queue().configure(config(1ns, 7));
+    Process a(1, 0ns, 3000ns);
+    Process b(2, 0ns, 3000ns);
+    SchedulerStats stats = run_three_to_one(scheduler, a, b);
+
+    EXPECT_NEAR(static_cast<double>(a.completion_time.load().count()), 4000.0, 200.0);
+    EXPECT_EQ(b.completion_time.load(), 6000ns);
+    EXPECT_LT(stats.share_accuracy_error(), 0.05);
+}
+
+TEST(ProportionalShareTest, SweepRunsBothPolicies){
+    EXPECT_TRUE(is_sweep_policy("lottery"));
+    EXPECT_TRUE(is_sweep_policy("stride"));
+    EXPECT_TRUE(sweep_policy_uses_quantum("stride"));
+
+    SweepWorkload workload;
+    for(int pid = 0; pid < 50; ++pid){
+        workload.push_back(TraceRecord{pid, pid % 3, pid * 10, 25});
+    }
+    for(const char* policy : {"lottery", "stride"}){
+        SweepPoint point{policy, 64, 5ns, 1};
+        SchedulerStats stats = run_sweep_point(point, workload);
+        EXPECT_EQ(stats.total_processes_completed, 50);
+        EXPECT_GT(stats.share_cpu, 0.0);
+    }
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "../src/RingBuffer.h"
+
+#include <numeric>
+#include <thread>
+#include <vector>
+
+TEST(RingBufferTest, CapacityRoundsUpToPowerOfTwo){
+    EXPECT_EQ(SPSCRingBuffer<int>(10).capacity(), 16u);
+    EXPECT_EQ(MPMCRingBuffer<int>(16).capacity(), 16u);
+    EXPECT_EQ(MPMCRingBuffer<int>(1).capacity(), 2u);
+}
+
+TEST(RingBufferTest, SPSCFifoAndWrapAround){
+    SPSCRingBuffer<int> queue(4);
+    int out = 0;
+
+    for(int round = 0; round < 3; ++round){
+        for(int i = 0; i < 4; ++i){
+            EXPECT_TRUE(queue.enqueue(round * 10 + i));
+        }
+        EXPECT_TRUE(queue.full());
+        EXPECT_FALSE(queue.enqueue(99));
+
+        ASSERT_NE(queue.peek(), nullptr);
+        EXPECT_EQ(*queue.peek(), round * 10);
+        for(int i = 0; i < 4; ++i){
+            ASSERT_TRUE(queue.dequeue(out));
+            EXPECT_EQ(out, round * 10 + i);
+        }
+        EXPECT_TRUE(queue.empty());
+        EXPECT_FALSE(queue.dequeue(out));
+    }
+}
+
+TEST(RingBufferTest, MPMCBulkOperations){
+    MPMCRingBuffer<int> queue(8);
+    std::vector<int> items(12);
+    std::iota(items.begin(), items.end(), 0);
+
+    // only as many as fit are taken
+    EXPECT_EQ(queue.enqueue_n(items.data(), items.size()), 8u);
+    EXPECT_TRUE(queue.full());
+
+    int out[16];
+    EXPECT_EQ(queue.dequeue_n(out, 5), 5u);
+    for(int i = 0; i < 5; ++i){
+        EXPECT_EQ(out[i], i);
+    }
+
+    // wraps around the end of the slot array
+    EXPECT_EQ(queue.enqueue_n(items.data() + 8, 4), 4u);
+    EXPECT_EQ(queue.dequeue_n(out, 16), 7u);
+    for(int i = 0; i < 7; ++i){
+        EXPECT_EQ(out[i], i + 5);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(RingBufferTest, SPSCAcrossThreads){
+    SPSCRingBuffer<int> queue(64);
+    const int count = 200000;
+
+    std::thread producer([&](){
+        int batch[8];
+        int next = 0;
+        while(next < count){
+            int n = std::min(8, count - next);
+            for(int i = 0; i < n; ++i){
+                batch[i] = next + i;
+            }
+            size_t pushed = queue.enqueue_n(batch, n);
+            if(pushed == 0){
+                std::this_thread::yield();
+            }
+            next += static_cast<int>(pushed);
+        }
+    });
+
+    int expected = 0;
+    int out[8];
+    while(expected < count){
+        size_t n = queue.dequeue_n(out, 8);
+        for(size_t i = 0; i < n; ++i){
+            ASSERT_EQ(out[i], expected++);
+        }
+        if(n == 0){
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
+
+TEST(RingBufferTest, MPMCAcrossThreads){
+    MPMCRingBuffer<int> queue(128);
+    const int producers = 4;
+    const int consumers = 4;
+    const int per_producer = 50000;
+
+    std::vector<std::thread> threads;
+    std::vector<long long> sums(consumers, 0);
+    std::atomic<int> consumed{0};
+
+    for(int t = 0; t < producers; ++t){
+        threads.emplace_back([&, t](){
+            for(int i = 0; i < per_producer; ++i){
+                int value = t * per_producer + i;
+                while(!queue.enqueue(value)){
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for(int t = 0; t < consumers; ++t){
+        threads.emplace_back([&, t](){
+            int out[4];
+            while(consumed.load() < producers * per_producer){
+                size_t n = queue.dequeue_n(out, 4);
+                for(size_t i = 0; i < n; ++i){
+                    sums[t] += out[i];
+                }
+                consumed += static_cast<int>(n);
+                if(n == 0){
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for(std::thread& t : threads){
+        t.join();
+    }
+
+    long long total = producers * per_producer;
+    EXPECT_EQ(std::accumulate(sums.begin(), sums.end(), 0LL), total * (total - 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
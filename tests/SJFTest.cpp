@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "../src/SJFScheduler.h"
+
+class SJFSchedulerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // exact mode so tests can look at individual samples
+        scheduler = std::make_unique<SJFScheduler>(10, LatencyMode::Exact);
+    }
+
+    std::unique_ptr<SJFScheduler> scheduler;
+};
+
+TEST_F(SJFSchedulerTest, RunsShortestJobFirst){
+    ProcessHandle a = scheduler->add_process(1, 0ns, 30ns);
+    ProcessHandle b = scheduler->add_process(2, 0ns, 10ns);
+    ProcessHandle c = scheduler->add_process(3, 0ns, 20ns);
+
+    scheduler->run_simulation();
+
+    const ProcessTable& table = scheduler->get_process_table();
+    EXPECT_EQ(table.completion(b).count(), 10);
+    EXPECT_EQ(table.completion(c).count(), 30);
+    EXPECT_EQ(table.completion(a).count(), 60);
+
+    auto stats = scheduler->get_stats();
+    EXPECT_EQ(stats.total_processes_completed, 3);
+    EXPECT_EQ(stats.waiting_times.samples(), (std::vector<nanoseconds>{0ns, 10ns, 30ns}));
+    EXPECT_TRUE(scheduler->is_simulation_complete());
+}
+
+TEST_F(SJFSchedulerTest, LaterShortJobWaitsForRunningJob){
+    ProcessHandle a = scheduler->add_process(1, 0ns, 50ns);
+    ProcessHandle b = scheduler->add_process(2, 10ns, 5ns);
+
+    scheduler->run_simulation();
+
+    // non-preemptive: the long job started first and keeps the CPU
+    const ProcessTable& table = scheduler->get_process_table();
+    EXPECT_EQ(table.completion(a).count(), 50);
+    EXPECT_EQ(table.start(b).count(), 50);
+    EXPECT_EQ(table.completion(b).count(), 55);
+}
+
+TEST_F(SJFSchedulerTest, DefersArrivalsWhenQueueIsFull){
+    SJFScheduler small(2, LatencyMode::Exact);
+    for(int pid = 1; pid <= 5; ++pid){
+        small.add_process(pid, 0ns, std::chrono::nanoseconds(pid));
+    }
+
+    small.run_simulation();
+
+    EXPECT_EQ(small.get_stats().total_processes_completed, 5);
+    EXPECT_TRUE(small.is_simulation_complete());
+}
+
+TEST_F(SJFSchedulerTest, UpdatesOwnerProcess){
+    Process p(9, 5ns, 15ns);
+    scheduler->add_process(&p);
+
+    scheduler->run_simulation();
+
+    EXPECT_EQ(p.current_state.load(), Process::State::COMPLETED);
+    EXPECT_EQ(p.start_time.load().count(), 5);
+    EXPECT_EQ(p.completion_time.load().count(), 20);
+}
+
+// a policy written outside the scheduler headers gets the same loop
+class LastInFirstOutQueue{
+public:
+    static constexpr const char* name = "LIFO";
+
+    LastInFirstOutQueue(const ProcessTable&, size_t capacity) : capacity_(capacity) {}
+
+    bool push(ProcessHandle h){
+        if(stack_.size() >= capacity_) return false;
+        stack_.push_back(h);
+        return true;
+    }
+
+    ProcessHandle pop(){
+        if(stack_.empty()) return invalid_process_handle;
+        ProcessHandle h = stack_.back();
+        stack_.pop_back();
+        return h;
+    }
+
+    bool empty() const { return stack_.empty(); }
+    size_t size() const { return stack_.size(); }
+    size_t capacity() const { return capacity_; }
+
+private:
+    std::vector<ProcessHandle> stack_;
+    size_t capacity_;
+};
+
+TEST(SimulationEngineTest, CustomReadyQueuePolicy){
+    SimulationEngine<LastInFirstOutQueue> engine(10);
+    ProcessHandle a = engine.add_process(1, 0ns, 10ns);
+    ProcessHandle b = engine.add_process(2, 0ns, 10ns);
+
+    engine.run_simulation();
+
+    EXPECT_EQ(engine.get_process_table().completion(b).count(), 10);
+    EXPECT_EQ(engine.get_process_table().completion(a).count(), 20);
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "../src/Telemetry.h"
+#include "../src/SJFScheduler.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+TEST(TelemetryTest, DepthIsTimeWeighted){
+    WindowedTelemetry telemetry(10ns, 8);
+    telemetry.depth(0ns, 2);
+    telemetry.depth(5ns, 4);
+    telemetry.depth(10ns, 0);
+
+    ASSERT_EQ(telemetry.size(), 2u);
+    EXPECT_EQ(telemetry.start(0), 0ns);
+    EXPECT_EQ(telemetry.length(0), 10ns);
+    EXPECT_EQ(telemetry.depth_min(0), 0u);
+    EXPECT_EQ(telemetry.depth_max(0), 4u);
+    EXPECT_DOUBLE_EQ(telemetry.depth_mean(0), 3.0);
+    // the open window starts at the depth the previous one ended with
+    EXPECT_EQ(telemetry.depth_max(1), 4u);
+    EXPECT_EQ(telemetry.length(1), 0ns);
+}
+
+TEST(TelemetryTest, BusyTimeIsSplitAcrossWindows){
+    WindowedTelemetry telemetry(10ns, 8);
+    telemetry.busy(5ns, 25ns);
+    ASSERT_EQ(telemetry.size(), 3u);
+    EXPECT_DOUBLE_EQ(telemetry.busy_fraction(0), 0.5);
+    EXPECT_DOUBLE_EQ(telemetry.busy_fraction(1), 1.0);
+    // the open window has only run for 5ns so far, all of them busy
+    EXPECT_EQ(telemetry.length(2), 5ns);
+    EXPECT_DOUBLE_EQ(telemetry.busy_fraction(2), 1.0);
+}
+
+TEST(TelemetryTest, RingKeepsTheLatestWindows){
+    WindowedTelemetry telemetry(10ns, 4);
+    telemetry.depth(0ns, 3);
+    telemetry.advance(105ns);
+    ASSERT_EQ(telemetry.size(), 4u);
+    EXPECT_EQ(telemetry.overwritten(), 7u);
+    EXPECT_EQ(telemetry.start(0), 70ns);
+    // windows nothing happened in still carry the depth
+    EXPECT_DOUBLE_EQ(telemetry.depth_mean(0), 3.0);
+    EXPECT_EQ(telemetry.depth_min(3), 3u);
+
+    // an event from a window that has been overwritten is dropped
+    telemetry.arrival(5ns);
+    telemetry.arrival(75ns);
+    EXPECT_EQ(telemetry.arrivals(0), 1u);
+}
+
+TEST(TelemetryTest, LatencyPercentilesPerWindow){
+    WindowedTelemetry telemetry(1000ns, 4);
+    for(int i = 0; i < 99; ++i){
+        telemetry.completion(10ns, 100ns);
+    }
+    telemetry.completion(20ns, 5000ns);
+    telemetry.completion(1500ns, 7ns);
+
+    EXPECT_EQ(telemetry.completions(0), 100u);
+    // 100 is in [64, 128)
+    EXPECT_EQ(telemetry.latency_percentile(0, 50.0), 127ns);
+    EXPECT_EQ(telemetry.latency_percentile(0, 99.0), 127ns);
+    EXPECT_EQ(telemetry.latency_percentile(0, 100.0), 5000ns);
+    EXPECT_EQ(telemetry.latency_max(0), 5000ns);
+    EXPECT_EQ(telemetry.latency_percentile(1, 50.0), 7ns);
+}
+
+TEST(TelemetryTest, RecordsASimulation){
+    // one slot, so the second and third arrival are deferred
+    SJFScheduler scheduler(1);
+    WindowedTelemetry telemetry(10ns, 16);
+    scheduler.set_telemetry(&telemetry);
+    for(int pid = 1; pid <= 3; ++pid){
+        scheduler.add_process(pid, 0ns, 10ns);
+    }
+    scheduler.run_simulation();
+
+    ASSERT_EQ(telemetry.size(), 4u);
+    EXPECT_EQ(telemetry.arrivals(0), 3u);
+    EXPECT_EQ(telemetry.drops(0), 2u);
+    EXPECT_EQ(telemetry.depth_max(0), 1u);
+    for(size_t i = 0; i < 3; ++i){
+        EXPECT_DOUBLE_EQ(telemetry.busy_fraction(i), 1.0);
+    }
+    EXPECT_EQ(telemetry.completions(0), 0u);
+    for(size_t i = 1; i < 4; ++i){
+        EXPECT_EQ(telemetry.completions(i), 1u);
+        EXPECT_EQ(telemetry.latency_max(i), nanoseconds(10 * i));
+    }
+    // the run ended at 30ns, where the last window opened
+    EXPECT_EQ(telemetry.length(3), 0ns);
+}
+
+TEST(TelemetryTest, ExportsCsvAndColumns){
+    WindowedTelemetry telemetry(10ns, 8);
+    telemetry.depth(0ns, 1);
+    telemetry.arrival(0ns);
+    telemetry.busy(0ns, 15ns);
+
+    std::string csv = testing::TempDir() + "telemetry_test.csv";
+    ASSERT_TRUE(write_telemetry_csv(telemetry, csv));
+    std::ifstream in(csv);
+    std::string header, first, second, extra;
+    std::getline(in, header);
+    std::getline(in, first);
+    std::getline(in, second);
+    EXPECT_EQ(header.rfind("start_ns,length_ns,depth_min,depth_mean,depth_max,arrivals", 0), 0u);
+    EXPECT_EQ(first, "0,10,0,1,1,1,0,0,0,1,0,0,0");
+    EXPECT_EQ(second, "10,5,1,1,1,0,0,0,0,1,0,0,0");
+    EXPECT_FALSE(std::getline(in, extra));
+    std::remove(csv.c_str());
+
+    std::string bin = testing::TempDir() + "telemetry_test.bin";
+    ASSERT_TRUE(write_telemetry_columns(telemetry, bin));
+    std::ifstream columns(bin, std::ios::binary);
+    TelemetryHeader read{};
+    columns.read(reinterpret_cast<char*>(&read), sizeof(read));
+    EXPECT_EQ(std::string(read.magic, 8), std::string(telemetry_magic, 8));
+    EXPECT_EQ(read.rows, 2u);
+    EXPECT_EQ(read.window_ns, 10);
+    int64_t starts[2] = {};
+    columns.read(reinterpret_cast<char*>(starts), sizeof(starts));
+    EXPECT_EQ(starts[1], 10);
+    columns.seekg(0, std::ios::end);
+    // 4 int64, 6 uint32 and 1 double column, then 64 histogram counts per row
+    EXPECT_EQ(static_cast<size_t>(columns.tellg()), sizeof(TelemetryHeader) + 2 * (4 * 8 + 6 * 4 + 8) + 2 * 64 * 4);
+    std::remove(bin.c_str());
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include "../src/TimingWheel.h"
+#include "../src/FCFSScheduler.h"
+#include "../src/SRTFScheduler.h"
+#include "../src/MLFQScheduler.h"
+#include "../src/EventTracer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Fired = std::pair<ProcessHandle, nanoseconds>;
+
+std::vector<Fired> advance(TimingWheel& wheel, nanoseconds now){
+    std::vector<Fired> fired;
+    wheel.advance(now, [&fired](ProcessHandle h, nanoseconds expiry){ fired.emplace_back(h, expiry); });
+    return fired;
+}
+
+} // namespace
+
+TEST(TimingWheelTest, FiresInExpiryOrder){
+    TimingWheel wheel;
+    // one timer per level, a tie and one that is due straight away
+    EXPECT_TRUE(wheel.schedule(0, 5000ns));
+    EXPECT_TRUE(wheel.schedule(1, 3ns));
+    EXPECT_TRUE(wheel.schedule(2, 70ns));
+    EXPECT_TRUE(wheel.schedule(3, 5000ns));
+    EXPECT_TRUE(wheel.schedule(4, 0ns));
+    EXPECT_FALSE(wheel.schedule(1, 10ns));
+    EXPECT_EQ(wheel.size(), 5u);
+    EXPECT_EQ(wheel.next_expiry(), 0ns);
+
+    EXPECT_EQ(advance(wheel, 0ns), (std::vector<Fired>{{4, 0ns}}));
+    EXPECT_EQ(wheel.next_expiry(), 3ns);
+    EXPECT_TRUE(advance(wheel, 2ns).empty());
+    EXPECT_EQ(advance(wheel, 100ns), (std::vector<Fired>{{1, 3ns}, {2, 70ns}}));
+    EXPECT_EQ(wheel.next_expiry(), 5000ns);
+    EXPECT_EQ(advance(wheel, 10000ns), (std::vector<Fired>{{0, 5000ns}, {3, 5000ns}}));
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_EQ(wheel.next_expiry(), nanoseconds::max());
+    EXPECT_EQ(wheel.now(), 10000ns);
+}
+
+TEST(TimingWheelTest, CancelsTimers){
+    TimingWheel wheel;
+    wheel.schedule(0, 100ns);
+    wheel.schedule(1, 200ns);
+    EXPECT_EQ(wheel.next_expiry(), 100ns);
+    EXPECT_TRUE(wheel.cancel(0));
+    EXPECT_FALSE(wheel.cancel(0));
+    EXPECT_FALSE(wheel.contains(0));
+    EXPECT_EQ(wheel.next_expiry(), 200ns);
+    EXPECT_EQ(advance(wheel, 1000ns), (std::vector<Fired>{{1, 200ns}}));
+    // a fired handle can be scheduled again
+    EXPECT_TRUE(wheel.schedule(1, 1500ns));
+    EXPECT_EQ(advance(wheel, 2000ns), (std::vector<Fired>{{1, 1500ns}}));
+}
+
+TEST(TimingWheelTest, MatchesSortedOrderOverLongJumps){
+    // timers scheduled as the clock moves, spread over every level, against a sort by
+    // (expiry, schedule order)
+    TimingWheel wheel;
+    uint64_t x = 12345;
+    auto next = [&x]{
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        return x;
+    };
+
+    std::vector<std::tuple<int64_t, uint64_t, ProcessHandle>> expected;
+    std::vector<Fired> fired;
+    uint64_t sequence = 0;
+    nanoseconds now = 0ns;
+    for(ProcessHandle h = 0; h < 20000; ++h){
+        int shift = static_cast<int>(next() % 48);
+        nanoseconds expiry = now + nanoseconds(static_cast<int64_t>(next() % (uint64_t(1) << shift)));
+        wheel.schedule(h, expiry);
+        expected.emplace_back(expiry.count(), sequence++, h);
+        if(h % 16 == 0){
+            // whatever hasn't fired yet, the earliest first
+            std::sort(expected.begin() + static_cast<std::ptrdiff_t>(fired.size()), expected.end());
+            EXPECT_EQ(wheel.next_expiry().count(), std::get<0>(expected[fired.size()]));
+            now += nanoseconds(static_cast<int64_t>(next() % 100000));
+            wheel.advance(now, [&fired](ProcessHandle fh, nanoseconds e){ fired.emplace_back(fh, e); });
+        }
+    }
+    wheel.advance(nanoseconds::max() - 1ns, [&fired](ProcessHandle fh, nanoseconds e){ fired.emplace_back(fh, e); });
+
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(fired.size(), expected.size());
+    for(size_t i = 0; i < fired.size(); ++i){
+        ASSERT_EQ(fired[i].first, std::get<2>(expected[i])) << i;
+        ASSERT_EQ(fired[i].second.count(), std::get<0>(expected[i])) << i;
+    }
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(IOBurstTest, BlockedProcessWakesIntoTheReadyQueue){
+    FCFSScheduler scheduler(16);
+    const nanoseconds bursts[] = {10ns, 50ns, 10ns};
+    ProcessHandle a = scheduler.add_process(1, 0ns, bursts);
+    ProcessHandle b = scheduler.add_process(2, 0ns, 40ns);
+    ASSERT_NE(a, invalid_process_handle);
+    scheduler.run_simulation();
+
+    // a 0-10, waits on I/O until 60 while b runs 10-50, the CPU idles until a is back
+    const ProcessTable& table = scheduler.get_process_table();
+    EXPECT_EQ(table.completion(a), 70ns);
+    EXPECT_EQ(table.completion(b), 50ns);
+    EXPECT_EQ(table.waiting(a), 0ns);
+    EXPECT_EQ(table.context_switches(a), 1u);
+
+    SchedulerStats stats = scheduler.get_stats();
+    EXPECT_EQ(stats.total_sim_time, 70ns);
+    EXPECT_EQ(stats.total_cpu_burst_time, 60ns);
+    EXPECT_EQ(stats.io_bursts, 1);
+    EXPECT_EQ(stats.io_time, 50ns);
+    EXPECT_EQ(stats.io_busy_time, 50ns);
+    EXPECT_EQ(stats.cpu_io_overlap, 40ns);
+    EXPECT_DOUBLE_EQ(stats.io_overlap(), 0.8);
+    EXPECT_DOUBLE_EQ(stats.io_utilization(), 50.0 / 70.0);
+}
+
+TEST(IOBurstTest, RejectsInvalidBursts){
+    FCFSScheduler scheduler(16);
+    const nanoseconds bursts[] = {10ns, 50ns};
+    EXPECT_EQ(scheduler.add_process(1, 0ns, bursts), invalid_process_handle);
+    scheduler.add_process(2, 0ns, 10ns);
+    scheduler.run_simulation();
+    EXPECT_EQ(scheduler.get_stats().total_processes_completed, 1);
+}
+
+TEST(IOBurstTest, WakeupPreemptsUnderSRTF){
+    SRTFScheduler scheduler(16);
+    const nanoseconds bursts[] = {10ns, 20ns, 5ns};
+    ProcessHandle a = scheduler.add_process(1, 0ns, bursts);
+    ProcessHandle b = scheduler.add_process(2, 0ns, 100ns);
+    scheduler.run_simulation();
+
+    // a is shorter and runs first, b is cut off when a's I/O finishes at 30
+    const ProcessTable& table = scheduler.get_process_table();
+    EXPECT_EQ(table.completion(a), 35ns);
+    EXPECT_EQ(table.completion(b), 115ns);
+}
+
+TEST(IOBurstTest, MLFQKeepsIOBoundProcessesOnTop){
+    MLFQScheduler scheduler(16);
+    MLFQConfig config;
+    config.base_quantum = 10ns;
+    config.boost_interval = 0ns;
+    scheduler.ready_queue().configure(config);
+    // 5ns cpu bursts never use up a slice, the cpu bound process does every time
+    const nanoseconds bursts[] = {5ns, 20ns, 5ns, 20ns, 5ns};
+    scheduler.add_process(1, 0ns, bursts);
+    scheduler.add_process(2, 0ns, 100ns);
+    scheduler.run_simulation();
+
+    SchedulerStats stats = scheduler.get_stats();
+    EXPECT_EQ(stats.total_processes_completed, 2);
+    EXPECT_EQ(stats.interactive_completions, 1);
+    EXPECT_EQ(stats.level_dispatches[0], 4);
+}
+
+TEST(IOBurstTest, TracesBlockAndWake){
+    FCFSScheduler scheduler(16);
+    EventTracer tracer(1, 64);
+    scheduler.set_tracer(&tracer);
+    const nanoseconds bursts[] = {10ns, 50ns, 10ns};
+    scheduler.add_process(1, 0ns, bursts);
+    scheduler.run_simulation();
+
+    std::vector<std::pair<SchedEventType, int64_t>> events;
+    tracer.for_each(0, [&events](const SchedEvent& event){ events.emplace_back(event.type, event.time_ns); });
+    std::vector<std::pair<SchedEventType, int64_t>> expected = {
+        {SchedEventType::Arrive, 0},   {SchedEventType::Enqueue, 0},  {SchedEventType::Dispatch, 0},
+        {SchedEventType::Block, 10},   {SchedEventType::Wake, 60},    {SchedEventType::Enqueue, 60},
+        {SchedEventType::Dispatch, 60}, {SchedEventType::Complete, 70},
+    };
+    EXPECT_EQ(events, expected);
+}
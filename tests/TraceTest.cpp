@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include "../src/TraceFormat.h"
+#include "../src/FCFSScheduler.h"
+
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+std::string temp_path(const std::string& name){
+    return ::testing::TempDir() + name;
+}
+
+} // namespace
+
+TEST(TraceTest, RoundTripsRecords){
+    std::string path = temp_path("round_trip.trace");
+    {
+        TraceWriter writer;
+        ASSERT_TRUE(writer.open(path, true));
+        writer.write(1, 0ns, 100ns, 3);
+        writer.write(2, 50ns, 20ns, -1);
+        ASSERT_TRUE(writer.close());
+    }
+
+    MappedTrace trace;
+    ASSERT_TRUE(trace.open(path));
+    ASSERT_EQ(trace.size(), 2u);
+    EXPECT_TRUE(trace.has_priority());
+    EXPECT_EQ(trace[0].pid, 1);
+    EXPECT_EQ(trace[0].burst_ns, 100);
+    EXPECT_EQ(trace[0].priority, 3);
+    EXPECT_EQ(trace[1].arrival_ns, 50);
+    EXPECT_EQ(trace[1].priority, -1);
+    std::remove(path.c_str());
+}
+
+TEST(TraceTest, ConvertsCsv){
+    std::string csv = temp_path("workload.csv");
+    std::string path = temp_path("workload.trace");
+    {
+        std::ofstream out(csv);
+        out << "pid,arrival_ns,burst_ns\n"
+            << "1, 0, 100\r\n"
+            << "\n"
+            << "2,40,10\n";
+    }
+
+    ASSERT_EQ(convert_csv_to_trace(csv, path), 2);
+
+    MappedTrace trace;
+    ASSERT_TRUE(trace.open(path));
+    ASSERT_EQ(trace.size(), 2u);
+    EXPECT_FALSE(trace.has_priority());
+    EXPECT_EQ(trace[0].burst_ns, 100);
+    EXPECT_EQ(trace[1].pid, 2);
+    EXPECT_EQ(trace[1].arrival_ns, 40);
+
+    // and straight into a scheduler
+    FCFSScheduler scheduler(10, LatencyMode::Exact);
+    EXPECT_EQ(load_trace(trace, scheduler), 2u);
+    scheduler.run_simulation();
+    EXPECT_EQ(scheduler.get_stats().total_processes_completed, 2);
+    EXPECT_EQ(scheduler.get_stats().total_sim_time.count(), 110);
+
+    std::remove(csv.c_str());
+    std::remove(path.c_str());
+}
+
+TEST(TraceTest, RejectsBadInput){
+    std::string csv = temp_path("bad.csv");
+    std::string path = temp_path("bad.trace");
+    {
+        std::ofstream out(csv);
+        out << "1,0,100\n" << "2,oops,10\n";
+    }
+    EXPECT_EQ(convert_csv_to_trace(csv, path), -1);
+
+    // rows that parse but aren't a process, after a good one and as the first line, where
+    // they mustn't be taken for a header
+    for(const char* row : {"2,40,0", "2,40,-5", "2,-1,10", "2,40,10,3,7", "2,40,10 3", "2,40,10,x"}){
+        {
+            std::ofstream out(csv);
+            out << "1,0,100\n" << row << "\n";
+        }
+        EXPECT_EQ(convert_csv_to_trace(csv, path), -1) << row;
+        {
+            std::ofstream out(csv);
+            out << row << "\n" << "1,0,100\n";
+        }
+        EXPECT_EQ(convert_csv_to_trace(csv, path), -1) << row;
+    }
+
+    // the wrong separator leaves nothing but "headers", which isn't an empty trace
+    {
+        std::ofstream out(csv);
+        out << "pid;arrival_ns;burst_ns\n" << "1;0;100\n" << "2;40;10\n";
+    }
+    EXPECT_EQ(convert_csv_to_trace(csv, path), -1);
+    {
+        std::ofstream out(csv);
+        out << "pid,arrival_ns,burst_ns\n";
+    }
+    EXPECT_EQ(convert_csv_to_trace(csv, path), -1);
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "definitely not a trace file, but long enough for a header";
+    }
+    MappedTrace trace;
+    EXPECT_FALSE(trace.open(path));
+    EXPECT_FALSE(trace.is_open());
+    EXPECT_FALSE(trace.open(temp_path("missing.trace")));
+
+    std::remove(csv.c_str());
+    std::remove(path.c_str());
+}
+
+// every record comes back out of the mapping intact, BM_ReadTrace times it
+TEST(TraceTest, ReadsBackManyRecords){
+    const size_t n = 10000;
+    std::string path = temp_path("large.trace");
+    {
+        TraceWriter writer;
+        ASSERT_TRUE(writer.open(path));
+        for(size_t i = 0; i < n; ++i){
+            writer.write(static_cast<int>(i), nanoseconds(i * 10), 5ns);
+        }
+        ASSERT_TRUE(writer.close());
+    }
+
+    MappedTrace trace;
+    ASSERT_TRUE(trace.open(path));
+    ASSERT_EQ(trace.size(), n);
+
+    int64_t checksum = 0;
+    trace.for_each([&checksum](const TraceRecord& record){
+        checksum += record.arrival_ns + record.burst_ns;
+    });
+    EXPECT_EQ(checksum, static_cast<int64_t>(10 * (n * (n - 1) / 2) + 5 * n));
+    EXPECT_EQ(trace[n - 1].pid, static_cast<int>(n - 1));
+    std::remove(path.c_str());
+}
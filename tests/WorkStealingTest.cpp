@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "../src/WorkStealingDeque.h"
+#include "../src/WorkStealingPool.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(WorkStealingDequeTest, OwnerIsLifoThievesAreFifo){
+    WorkStealingDeque<int> deque(4);
+    for(int i = 1; i <= 3; ++i){
+        deque.push(i);
+    }
+
+    int item = 0;
+    ASSERT_TRUE(deque.steal(item));
+    EXPECT_EQ(item, 1);
+    ASSERT_TRUE(deque.pop(item));
+    EXPECT_EQ(item, 3);
+    ASSERT_TRUE(deque.pop(item));
+    EXPECT_EQ(item, 2);
+    EXPECT_FALSE(deque.pop(item));
+    EXPECT_FALSE(deque.steal(item));
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, GrowsInsteadOfFailing){
+    WorkStealingDeque<int> deque(2);
+    for(int i = 0; i < 1000; ++i){
+        deque.push(i);
+    }
+    EXPECT_EQ(deque.size(), 1000u);
+    EXPECT_GE(deque.capacity(), 1000u);
+
+    int item = 0;
+    for(int expected = 999; expected >= 0; --expected){
+        ASSERT_TRUE(deque.pop(item));
+        EXPECT_EQ(item, expected);
+    }
+}
+
+// the owner pushes and pops while thieves steal, every item must come out exactly once
+TEST(WorkStealingDequeTest, ConcurrentStealsTakeEachItemOnce){
+    const int items = 200000;
+    const int thieves = 3;
+    WorkStealingDeque<int> deque(8);
+    std::vector<std::atomic<int>> seen(items);
+    std::atomic<bool> done = false;
+
+    auto take = [&](int item){ seen[item].fetch_add(1); };
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < thieves; ++t){
+        threads.emplace_back([&]{
+            int item = 0;
+            while(!done.load()){
+                if(deque.steal(item)){
+                    take(item);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    int item = 0;
+    for(int i = 0; i < items; ++i){
+        deque.push(i);
+        // pop roughly every other push so the deque is contended at both ends
+        if(i % 2 == 0 && deque.pop(item)){
+            take(item);
+        }
+    }
+    while(deque.pop(item)){
+        take(item);
+    }
+    done = true;
+    for(std::thread& thread : threads){
+        thread.join();
+    }
+
+    for(int i = 0; i < items; ++i){
+        ASSERT_EQ(seen[i].load(), 1) << "item " << i;
+    }
+}
+
+TEST(WorkStealingPoolTest, RunsEverySubmittedItem){
+    const int items = 50000;
+    std::vector<std::atomic<int>> runs(items);
+    std::atomic<int> total = 0;
+    {
+        WorkStealingPool<int> pool(4, 1024, [&](int item, size_t worker){
+            EXPECT_LT(worker, 4u);
+            runs[item].fetch_add(1);
+            total++;
+        });
+        for(int i = 0; i < items; ++i){
+            while(!pool.submit(i)){
+                std::this_thread::yield();
+            }
+        }
+        // shutdown drains the queue before joining
+    }
+
+    EXPECT_EQ(total.load(), items);
+    for(int i = 0; i < items; ++i){
+        ASSERT_EQ(runs[i].load(), 1);
+    }
+}
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include "../src/WorkloadGenerator.h"
+#include "../src/FCFSScheduler.h"
+#include "../src/SJFScheduler.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+std::vector<TraceRecord> take(WorkloadGenerator& generator, size_t n){
+    std::vector<TraceRecord> records;
+    records.reserve(n);
+    for(size_t i = 0; i < n; ++i){
+        records.push_back(generator.next());
+    }
+    return records;
+}
+
+double mean_gap(const std::vector<TraceRecord>& records){
+    return static_cast<double>(records.back().arrival_ns) / records.size();
+}
+
+double mean_burst(const std::vector<TraceRecord>& records){
+    double sum = 0;
+    for(const TraceRecord& r : records){
+        sum += static_cast<double>(r.burst_ns);
+    }
+    return sum / records.size();
+}
+
+// variance over mean of arrivals per window, 1 for Poisson and larger when bursty
+double dispersion(const std::vector<TraceRecord>& records, int64_t window){
+    std::vector<double> counts(static_cast<size_t>(records.back().arrival_ns / window) + 1, 0.0);
+    for(const TraceRecord& r : records){
+        counts[static_cast<size_t>(r.arrival_ns / window)] += 1.0;
+    }
+    double mean = 0, sq = 0;
+    for(double c : counts){
+        mean += c;
+        sq += c * c;
+    }
+    mean /= counts.size();
+    return (sq / counts.size() - mean * mean) / mean;
+}
+
+} // namespace
+
+TEST(WorkloadGeneratorTest, SameSeedSameWorkload){
+    WorkloadConfig config;
+    config.seed = 42;
+    config.arrivals = ArrivalPattern::Bursty;
+    config.bursts = BurstDistribution::Pareto;
+
+    WorkloadGenerator a(config), b(config);
+    auto first = take(a, 10000);
+    auto second = take(b, 10000);
+    for(size_t i = 0; i < first.size(); ++i){
+        ASSERT_EQ(first[i].arrival_ns, second[i].arrival_ns);
+        ASSERT_EQ(first[i].burst_ns, second[i].burst_ns);
+        ASSERT_EQ(first[i].pid, static_cast<int32_t>(i));
+    }
+
+    config.seed = 43;
+    WorkloadGenerator c(config);
+    auto other = take(c, 100);
+    EXPECT_NE(other[99].arrival_ns, first[99].arrival_ns);
+}
+
+TEST(WorkloadGeneratorTest, PoissonExponential){
+    WorkloadConfig config;
+    config.mean_interarrival = 100ns;
+    config.mean_burst = 50ns;
+    WorkloadGenerator generator(config);
+    auto records = take(generator, 1000000);
+
+    EXPECT_NEAR(mean_gap(records), 100.0, 1.0);
+    EXPECT_NEAR(mean_burst(records), 50.0, 0.5);
+    EXPECT_NEAR(dispersion(records, 10000), 1.0, 0.15);
+    for(size_t i = 1; i < records.size(); ++i){
+        ASSERT_GE(records[i].arrival_ns, records[i - 1].arrival_ns);
+    }
+}
+
+TEST(WorkloadGeneratorTest, ParetoIsHeavyTailed){
+    WorkloadConfig config;
+    config.bursts = BurstDistribution::Pareto;
+    config.pareto_alpha = 2.5;
+    config.mean_burst = 100ns;
+    WorkloadGenerator generator(config);
+    auto records = take(generator, 1000000);
+
+    int64_t largest = 0;
+    for(const TraceRecord& r : records){
+        largest = std::max(largest, r.burst_ns);
+        ASSERT_GE(r.burst_ns, 60);
+    }
+    EXPECT_NEAR(mean_burst(records), 100.0, 3.0);
+    // an exponential with the same mean would essentially never exceed ~20x it
+    EXPECT_GT(largest, 100 * 40);
+}
+
+TEST(WorkloadGeneratorTest, Bimodal){
+    WorkloadConfig config;
+    config.bursts = BurstDistribution::Bimodal;
+    config.short_burst = 10ns;
+    config.long_burst = 1000ns;
+    config.long_fraction = 0.2;
+    WorkloadGenerator generator(config);
+    auto records = take(generator, 100000);
+
+    size_t longs = 0;
+    for(const TraceRecord& r : records){
+        ASSERT_TRUE(r.burst_ns == 10 || r.burst_ns == 1000);
+        longs += r.burst_ns == 1000;
+    }
+    EXPECT_NEAR(static_cast<double>(longs) / records.size(), 0.2, 0.01);
+}
+
+TEST(WorkloadGeneratorTest, BurstyArrivalsAreOverdispersed){
+    WorkloadConfig config;
+    config.arrivals = ArrivalPattern::Bursty;
+    config.mean_interarrival = 100ns;
+    config.burst_rate_multiplier = 20.0;
+    config.mean_calm_period = 200000ns;
+    config.mean_burst_period = 20000ns;
+    WorkloadGenerator generator(config);
+    auto records = take(generator, 1000000);
+
+    EXPECT_GT(dispersion(records, 10000), 5.0);
+}
+
+TEST(WorkloadGeneratorTest, DiurnalRateFollowsTheDay){
+    WorkloadConfig config;
+    config.arrivals = ArrivalPattern::Diurnal;
+    config.mean_interarrival = 100ns;
+    config.diurnal_period = 10000000ns;
+    config.diurnal_amplitude = 0.8;
+    WorkloadGenerator generator(config);
+    auto records = take(generator, 1000000);
+
+    // first half of each period is above the base rate, second half below
+    size_t day = 0, night = 0;
+    for(const TraceRecord& r : records){
+        if(r.arrival_ns % config.diurnal_period.count() < config.diurnal_period.count() / 2){
+            day++;
+        } else {
+            night++;
+        }
+    }
+    // integral of 1 + 0.8 sin over each half: (1 + 1.6/pi) / (1 - 1.6/pi) ~ 3.1
+    EXPECT_NEAR(static_cast<double>(day) / night, 3.08, 0.2);
+    EXPECT_NEAR(mean_gap(records), 100.0, 2.0);
+}
+
+TEST(WorkloadGeneratorTest, FeedsSchedulers){
+    WorkloadConfig config;
+    config.seed = 7;
+    config.bursts = BurstDistribution::Pareto;
+
+    FCFSScheduler fcfs(64);
+    SJFScheduler sjf(64);
+    generate_into(fcfs, config, 5000);
+    generate_into(sjf, config, 5000);
+    fcfs.run_simulation();
+    sjf.run_simulation();
+
+    EXPECT_EQ(fcfs.get_stats().total_processes_completed, 5000);
+    EXPECT_EQ(sjf.get_stats().total_processes_completed, 5000);
+    // same work either way, SJF only reorders it
+    EXPECT_EQ(fcfs.get_stats().total_cpu_burst_time, sjf.get_stats().total_cpu_burst_time);
+    EXPECT_LE(sjf.get_stats().waiting_times.mean(), fcfs.get_stats().waiting_times.mean());
+}
+
+// the trace holds exactly what the generator produces, BM_GenerateTrace times it
+TEST(WorkloadGeneratorTest, WritesTheGeneratedWorkloadAsATrace){
+    const size_t n = 10000;
+    std::string path = ::testing::TempDir() + "generated.trace";
+    WorkloadConfig config;
+    config.arrivals = ArrivalPattern::Bursty;
+    config.bursts = BurstDistribution::Pareto;
+
+    ASSERT_TRUE(generate_trace(path, config, n));
+
+    MappedTrace trace;
+    ASSERT_TRUE(trace.open(path));
+    ASSERT_EQ(trace.size(), n);
+    WorkloadGenerator again(config);
+    for(size_t i = 0; i < n; ++i){
+        TraceRecord expected = again.next();
+        ASSERT_EQ(trace[i].pid, expected.pid) << i;
+        ASSERT_EQ(trace[i].arrival_ns, expected.arrival_ns) << i;
+        ASSERT_EQ(trace[i].burst_ns, expected.burst_ns) << i;
+    }
+    std::remove(path.c_str());
+}